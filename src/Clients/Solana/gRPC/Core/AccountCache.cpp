@@ -0,0 +1,293 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "AccountCache.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "Utils/Base58.hpp"
+
+#include "WireReader.hpp"
+
+namespace solana {
+
+namespace {
+    using namespace wire;
+
+    // Field numbers from geyser.proto.
+    namespace field {
+        constexpr uint32_t UPDATE_ACCOUNT = 2;
+
+        constexpr uint32_t UPDATE_ACCOUNT_INFO = 1;
+        constexpr uint32_t UPDATE_ACCOUNT_SLOT = 2;
+
+        constexpr uint32_t INFO_PUBKEY = 1;
+        constexpr uint32_t INFO_LAMPORTS = 2;
+        constexpr uint32_t INFO_OWNER = 3;
+        constexpr uint32_t INFO_EXECUTABLE = 4;
+        constexpr uint32_t INFO_DATA = 6;
+        constexpr uint32_t INFO_WRITE_VERSION = 7;
+    }
+
+    // Map node, list node and key copies in both, roughly.
+    constexpr size_t ENTRY_OVERHEAD = 128;
+
+    bool readAccountInfo(std::string_view bytes, std::string_view& pubkey,
+        std::string_view& owner, std::string_view& data,
+        AccountCache::Account& account)
+    {
+        WireReader reader(bytes);
+        while (!reader.done()) {
+            uint32_t number, type;
+            if (!reader.readTag(number, type))
+                return false;
+            uint64_t value;
+            if (number == field::INFO_PUBKEY && type == LENGTH_DELIMITED) {
+                if (!reader.readBytes(pubkey))
+                    return false;
+            } else if (number == field::INFO_OWNER
+                && type == LENGTH_DELIMITED) {
+                if (!reader.readBytes(owner))
+                    return false;
+            } else if (number == field::INFO_DATA && type == LENGTH_DELIMITED) {
+                if (!reader.readBytes(data))
+                    return false;
+            } else if (type == VARINT) {
+                if (!reader.readVarint(value))
+                    return false;
+                if (number == field::INFO_LAMPORTS)
+                    account.lamports = value;
+                else if (number == field::INFO_EXECUTABLE)
+                    account.executable = value != 0;
+                else if (number == field::INFO_WRITE_VERSION)
+                    account.writeVersion = value;
+            } else if (!reader.skip(type)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string encodeBase64(std::string_view bytes)
+    {
+        static constexpr char ALPHABET[]
+            = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        out.reserve((bytes.size() + 2) / 3 * 4);
+        size_t i = 0;
+        for (; i + 2 < bytes.size(); i += 3) {
+            uint32_t n = static_cast<uint8_t>(bytes[i]) << 16
+                | static_cast<uint8_t>(bytes[i + 1]) << 8
+                | static_cast<uint8_t>(bytes[i + 2]);
+            out += ALPHABET[n >> 18];
+            out += ALPHABET[(n >> 12) & 63];
+            out += ALPHABET[(n >> 6) & 63];
+            out += ALPHABET[n & 63];
+        }
+        if (i < bytes.size()) {
+            uint32_t n = static_cast<uint8_t>(bytes[i]) << 16;
+            if (i + 1 < bytes.size())
+                n |= static_cast<uint8_t>(bytes[i + 1]) << 8;
+            out += ALPHABET[n >> 18];
+            out += ALPHABET[(n >> 12) & 63];
+            out += i + 1 < bytes.size() ? ALPHABET[(n >> 6) & 63] : '=';
+            out += '=';
+        }
+        return out;
+    }
+
+    std::string encodeBase58(std::string_view bytes)
+    {
+        return EncodeBase58({ reinterpret_cast<const unsigned char*>(
+                                  bytes.data()),
+            bytes.size() });
+    }
+}
+
+AccountCache::AccountCache(size_t maxBytes)
+    : maxShardBytes_(std::max<size_t>(maxBytes / SHARD_COUNT, 1))
+{
+}
+
+AccountCache::~AccountCache() = default;
+
+bool AccountCache::apply(const grpc::ByteBuffer& frame)
+{
+    std::vector<grpc::Slice> slices;
+    if (!frame.Dump(&slices).ok())
+        return false;
+    if (slices.size() == 1) {
+        return apply(std::string_view(
+            reinterpret_cast<const char*>(slices[0].begin()),
+            slices[0].size()));
+    }
+
+    std::string wire;
+    wire.reserve(frame.Length());
+    for (const auto& slice : slices) {
+        wire.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+    }
+    return apply(wire);
+}
+
+bool AccountCache::apply(std::string_view frame)
+{
+    std::string_view message;
+    WireReader outer(frame);
+    while (!outer.done()) {
+        uint32_t number, type;
+        if (!outer.readTag(number, type))
+            return false;
+        if (number == field::UPDATE_ACCOUNT && type == LENGTH_DELIMITED) {
+            if (!outer.readBytes(message))
+                return false;
+            break;
+        }
+        if (!outer.skip(type))
+            return false;
+    }
+    if (message.empty())
+        return false;
+
+    Account account;
+    std::string_view pubkey, owner, data;
+    WireReader reader(message);
+    while (!reader.done()) {
+        uint32_t number, type;
+        if (!reader.readTag(number, type))
+            return false;
+        std::string_view info;
+        if (number == field::UPDATE_ACCOUNT_INFO && type == LENGTH_DELIMITED) {
+            if (!reader.readBytes(info)
+                || !readAccountInfo(info, pubkey, owner, data, account))
+                return false;
+        } else if (number == field::UPDATE_ACCOUNT_SLOT && type == VARINT) {
+            if (!reader.readVarint(account.slot))
+                return false;
+        } else if (!reader.skip(type)) {
+            return false;
+        }
+    }
+    if (pubkey.empty())
+        return false;
+
+    account.owner = owner;
+    account.data = data;
+    update(pubkey, std::move(account));
+    return true;
+}
+
+bool AccountCache::update(std::string_view pubkey, Account account)
+{
+    auto& shard = shardFor(pubkey);
+    size_t added = footprint(pubkey, account);
+    size_t removed = 0;
+
+    std::unique_lock lock(shard.mutex);
+    auto it = shard.accounts.find(pubkey);
+    if (it != shard.accounts.end()) {
+        auto& cached = it->second;
+        if (std::tie(account.slot, account.writeVersion)
+            <= std::tie(cached.account.slot, cached.account.writeVersion)) {
+            ++stale_;
+            return false;
+        }
+        removed = footprint(pubkey, cached.account);
+        cached.account = std::move(account);
+        shard.lru.splice(shard.lru.end(), shard.lru, cached.lru);
+    } else {
+        shard.lru.emplace_back(pubkey);
+        shard.accounts.emplace(std::string(pubkey),
+            Entry { std::move(account), std::prev(shard.lru.end()) });
+    }
+    shard.bytes += added;
+    shard.bytes -= removed;
+    bytes_ += added;
+    bytes_ -= removed;
+    ++updates_;
+
+    // The account just written is never the one evicted.
+    while (shard.bytes > maxShardBytes_ && shard.lru.size() > 1) {
+        const auto& oldest = shard.lru.front();
+        auto victim = shard.accounts.find(oldest);
+        size_t bytes = footprint(oldest, victim->second.account);
+        shard.accounts.erase(victim);
+        shard.lru.pop_front();
+        shard.bytes -= bytes;
+        bytes_ -= bytes;
+        ++evictions_;
+    }
+    return true;
+}
+
+std::optional<AccountCache::Account> AccountCache::get(
+    std::string_view pubkey) const
+{
+    std::optional<Account> result;
+    visit(pubkey, [&result](const Account& account) { result = account; });
+    return result;
+}
+
+size_t AccountCache::size() const
+{
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock lock(shard.mutex);
+        total += shard.accounts.size();
+    }
+    return total;
+}
+
+json AccountCache::getStats() const
+{
+    return { { "accounts", size() }, { "bytes", bytes_.load() },
+        { "max_bytes", maxShardBytes_ * SHARD_COUNT },
+        { "updates", updates_.load() }, { "stale", stale_.load() },
+        { "evictions", evictions_.load() } };
+}
+
+json AccountCache::toJson(std::string_view pubkey, const Account& account)
+{
+    return { { "pubkey", encodeBase58(pubkey) }, { "slot", account.slot },
+        { "write_version", account.writeVersion },
+        { "lamports", account.lamports },
+        { "owner", encodeBase58(account.owner) },
+        { "executable", account.executable },
+        { "data", encodeBase64(account.data) } };
+}
+
+size_t AccountCache::footprint(std::string_view pubkey, const Account& account)
+{
+    return 2 * pubkey.size() + account.owner.size() + account.data.size()
+        + ENTRY_OVERHEAD;
+}
+
+AccountCache::Shard& AccountCache::shardFor(std::string_view pubkey)
+{
+    return shards_[KeyHash {}(pubkey) % SHARD_COUNT];
+}
+
+const AccountCache::Shard& AccountCache::shardFor(
+    std::string_view pubkey) const
+{
+    return shards_[KeyHash {}(pubkey) % SHARD_COUNT];
+}
+}
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+#include <ankerl/unordered_dense.h>
+
+#include <grpcpp/support/byte_buffer.h>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace solana {
+
+/**
+ * Latest known state of the accounts a Geyser account subscription delivers,
+ * keyed by raw 32-byte pubkey. Keys are spread over independently locked
+ * shards so readers only contend with writers of the same shard. An update
+ * only replaces the cached state when it is newer by (slot, write_version),
+ * which makes the cache safe to feed from redundant or reconnecting streams.
+ * Each shard evicts its least recently updated accounts once it holds more
+ * than its share of maxBytes.
+ */
+class AccountCache {
+public:
+    static constexpr size_t SHARD_COUNT = 64;
+
+    struct Account {
+        uint64_t slot { 0 };
+        uint64_t writeVersion { 0 };
+        uint64_t lamports { 0 };
+        bool executable { false };
+        std::string owner;
+        std::string data;
+    };
+
+    explicit AccountCache(size_t maxBytes);
+    ~AccountCache();
+
+    AccountCache(const AccountCache&) = delete;
+    AccountCache& operator=(const AccountCache&) = delete;
+
+    // Applies a raw SubscribeUpdate frame. Returns false when it is not an
+    // account update.
+    bool apply(const grpc::ByteBuffer& frame);
+    bool apply(std::string_view frame);
+
+    // Returns false when the cached state is as new or newer.
+    bool update(std::string_view pubkey, Account account);
+
+    std::optional<Account> get(std::string_view pubkey) const;
+
+    // Calls fn with the cached state under the shard's read lock, which
+    // avoids copying the account data. fn must not call back into the cache.
+    template <typename Fn> bool visit(std::string_view pubkey, Fn&& fn) const
+    {
+        const auto& shard = shardFor(pubkey);
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.accounts.find(pubkey);
+        if (it == shard.accounts.end())
+            return false;
+        fn(it->second.account);
+        return true;
+    }
+
+    size_t size() const;
+    json getStats() const;
+
+    // JSON for the HTTP API: base58 keys and base64 data, as JSON-RPC does.
+    static json toJson(std::string_view pubkey, const Account& account);
+
+private:
+    struct KeyHash {
+        using is_transparent = void;
+        using is_avalanching = void;
+
+        uint64_t operator()(std::string_view key) const noexcept
+        {
+            return ankerl::unordered_dense::hash<std::string_view> {}(key);
+        }
+    };
+
+    struct Entry {
+        Account account;
+        std::list<std::string>::iterator lru;
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        ankerl::unordered_dense::map<std::string, Entry, KeyHash,
+            std::equal_to<>>
+            accounts;
+        // Least recently updated first.
+        std::list<std::string> lru;
+        size_t bytes { 0 };
+    };
+
+    static size_t footprint(std::string_view pubkey, const Account& account);
+    Shard& shardFor(std::string_view pubkey);
+    const Shard& shardFor(std::string_view pubkey) const;
+
+    size_t maxShardBytes_;
+    std::array<Shard, SHARD_COUNT> shards_;
+    std::atomic<uint64_t> bytes_ { 0 };
+    std::atomic<uint64_t> updates_ { 0 };
+    std::atomic<uint64_t> stale_ { 0 };
+    std::atomic<uint64_t> evictions_ { 0 };
+};
+}
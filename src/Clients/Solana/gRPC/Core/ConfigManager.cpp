@@ -18,10 +18,12 @@
 
 #include "ConfigManager.hpp"
 
+#include <algorithm>
+#include <sstream>
 #include <stdexcept>
 #include <system_error>
 
-#include "Consts.h"
+#include "AppInfo.h"
 
 #include "Utils/PathUtils.hpp"
 
@@ -82,6 +84,47 @@ ConfigManager::getDataSources() const
                 DataSourceConfig cfg;
                 cfg.address = table->get("address")->value_or<std::string>("");
                 cfg.type = table->get("type")->value_or<std::string>("geyser");
+                cfg.shards = (*table)["shards"].value_or(1);
+                auto readStrings = [&table](const char* key,
+                                       std::vector<std::string>& out) {
+                    if (auto values = (*table)[key].as_array()) {
+                        for (const auto& item : *values) {
+                            if (auto value = item.value<std::string>())
+                                out.push_back(*value);
+                        }
+                    }
+                };
+                readStrings("account_include", cfg.accountInclude);
+                readStrings("account_watch", cfg.accountWatch);
+                readStrings("account_owners", cfg.accountOwners);
+                cfg.batchMinSize = std::max(
+                    1, (*table)["batch_min_size"].value_or(cfg.batchMinSize));
+                cfg.batchMaxSize = std::max(cfg.batchMinSize,
+                    (*table)["batch_max_size"].value_or(cfg.batchMaxSize));
+                cfg.batchTargetLatencyMs = std::max(1,
+                    (*table)["batch_target_latency_ms"].value_or(
+                        cfg.batchTargetLatencyMs));
+                cfg.queueCapacity = std::max(
+                    2, (*table)["queue_capacity"].value_or(cfg.queueCapacity));
+                cfg.overflowPolicy = (*table)["overflow_policy"].value_or(
+                    cfg.overflowPolicy);
+                cfg.overflowSampleRate = std::max(1,
+                    (*table)["overflow_sample_rate"].value_or(
+                        cfg.overflowSampleRate));
+                cfg.capturePath
+                    = (*table)["capture_path"].value_or(cfg.capturePath);
+                // For type = "replay" the address is a capture file.
+                cfg.replayPace
+                    = (*table)["replay_pace"].value_or(cfg.replayPace);
+                cfg.replaySpeed
+                    = (*table)["replay_speed"].value_or(cfg.replaySpeed);
+                cfg.reorder = (*table)["reorder"].value_or(cfg.reorder);
+                cfg.reorderWindowSlots = std::max(1,
+                    (*table)["reorder_window_slots"].value_or(
+                        cfg.reorderWindowSlots));
+                cfg.reorderTimeoutMs = std::max(1,
+                    (*table)["reorder_timeout_ms"].value_or(
+                        cfg.reorderTimeoutMs));
                 if (!cfg.address.empty()) {
                     result.push_back(cfg);
                 }
@@ -134,6 +177,12 @@ int ConfigManager::getHttpPort() const
     return config_["http_port"].value_or(8080);
 }
 
+int ConfigManager::getMetricsPort() const
+{
+    std::lock_guard lock(mutex_);
+    return config_["metrics_port"].value_or(9090);
+}
+
 std::string ConfigManager::getLogLevel() const
 {
     std::lock_guard lock(mutex_);
@@ -153,6 +202,85 @@ int ConfigManager::getHealthCheckIntervalSeconds() const
     return config_["health_check_interval_seconds"].value_or(60);
 }
 
+bool ConfigManager::getRedundantFeeds() const
+{
+    std::lock_guard lock(mutex_);
+    return config_["redundant_feeds"].value_or(false);
+}
+
+int ConfigManager::getDedupWindowSlots() const
+{
+    std::lock_guard lock(mutex_);
+    return config_["dedup_window_slots"].value_or(32);
+}
+
+int ConfigManager::getDedupSlotCapacity() const
+{
+    std::lock_guard lock(mutex_);
+    return config_["dedup_slot_capacity"].value_or(16384);
+}
+
+int ConfigManager::getAccountCacheMb() const
+{
+    std::lock_guard lock(mutex_);
+    return config_["account_cache_mb"].value_or(256);
+}
+
+int ConfigManager::getProbeIntervalMs() const
+{
+    std::lock_guard lock(mutex_);
+    return config_["probe_interval_ms"].value_or(1000);
+}
+
+int ConfigManager::getProbeTimeoutMs() const
+{
+    std::lock_guard lock(mutex_);
+    return config_["probe_timeout_ms"].value_or(500);
+}
+
+int ConfigManager::getProbeMaxSlotLag() const
+{
+    std::lock_guard lock(mutex_);
+    return config_["probe_max_slot_lag"].value_or(4);
+}
+
+std::string ConfigManager::getShmRingName() const
+{
+    std::lock_guard lock(mutex_);
+    return config_["shm_ring_name"].value_or("");
+}
+
+int ConfigManager::getShmRingCapacity() const
+{
+    std::lock_guard lock(mutex_);
+    return config_["shm_ring_capacity"].value_or(65536);
+}
+
+std::vector<int> ConfigManager::getCpuAffinity() const
+{
+    std::lock_guard lock(mutex_);
+    std::vector<int> cpus;
+    if (auto values = config_["cpu_affinity"].as_array()) {
+        for (const auto& item : *values) {
+            if (auto cpu = item.value<int>(); cpu && *cpu >= 0)
+                cpus.push_back(*cpu);
+        }
+    }
+    return cpus;
+}
+
+std::optional<std::string> ConfigManager::getFilterConfig(
+    const std::string& name) const
+{
+    std::lock_guard lock(mutex_);
+    auto table = config_["filters"][name].as_table();
+    if (!table)
+        return std::nullopt;
+    std::ostringstream out;
+    out << toml::json_formatter { *table };
+    return out.str();
+}
+
 bool ConfigManager::reload()
 {
     try {
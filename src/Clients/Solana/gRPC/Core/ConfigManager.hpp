@@ -38,6 +38,24 @@ public:
     struct DataSourceConfig {
         std::string address;
         std::string type;
+        int shards { 1 };
+        std::vector<std::string> accountInclude;
+        // Accounts whose state is streamed into the account cache, by
+        // pubkey or by owning program.
+        std::vector<std::string> accountWatch;
+        std::vector<std::string> accountOwners;
+        int batchMinSize { 8 };
+        int batchMaxSize { 1024 };
+        int batchTargetLatencyMs { 5 };
+        int queueCapacity { 64 };
+        std::string overflowPolicy { "block" };
+        int overflowSampleRate { 10 };
+        std::string capturePath;
+        std::string replayPace { "fast" };
+        double replaySpeed { 1.0 };
+        bool reorder { false };
+        int reorderWindowSlots { 32 };
+        int reorderTimeoutMs { 400 };
     };
 
     std::vector<DataSourceConfig> getDataSources() const;
@@ -46,9 +64,24 @@ public:
     getTelegramConfig() const;
     std::optional<std::string> getDiscordConfig() const;
     int getHttpPort() const;
+    // 0 disables the Prometheus endpoint.
+    int getMetricsPort() const;
     std::string getLogLevel() const;
     int getMaxConcurrentFilters() const;
     int getHealthCheckIntervalSeconds() const;
+    bool getRedundantFeeds() const;
+    int getDedupWindowSlots() const;
+    int getDedupSlotCapacity() const;
+    int getAccountCacheMb() const;
+    int getProbeIntervalMs() const;
+    int getProbeTimeoutMs() const;
+    int getProbeMaxSlotLag() const;
+    // Empty unless transactions are published to a shared-memory ring.
+    std::string getShmRingName() const;
+    int getShmRingCapacity() const;
+    std::vector<int> getCpuAffinity() const;
+    // The [filters.<name>] table as JSON, ready for updateConfig().
+    std::optional<std::string> getFilterConfig(const std::string& name) const;
 
     bool reload();
     std::string encrypt(const std::string& data) const;
@@ -18,8 +18,10 @@
 
 #include "DataSourceManager.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <random>
+#include <utility>
 
 #include <boost/uuid.hpp>
 
@@ -27,48 +29,114 @@ namespace solana {
 
 DataSourceManager::DataSourceManager(ConfigManager& config,
     StorageManager& storage, NotificationManager& notifier,
-    FilterManager& filter, QObject* parent)
-    : QObject(parent)
-    , config_(config)
+    FilterManager& filter)
+    : config_(config)
     , storage_(storage)
     , notification_(notifier)
     , filter_(filter)
+    , healthCheckInterval_(config_.getHealthCheckIntervalSeconds())
 {
-    connect(&healthCheckTimer_, &QTimer::timeout, this,
-        &DataSourceManager::performHealthCheck);
-    healthCheckTimer_.start(config_.getHealthCheckIntervalSeconds() * 1000);
+    if (config_.getRedundantFeeds()) {
+        race_ = std::make_shared<FeedRace>(config_.getDedupWindowSlots(),
+            config_.getDedupSlotCapacity());
+        Logger::getLogger()->info("Redundant feed racing enabled");
+    }
+    accounts_ = std::make_shared<AccountCache>(
+        static_cast<size_t>(config_.getAccountCacheMb()) * 1024 * 1024);
+    // Before any source starts feeding the filters.
+    filter_.setAccountCache(accounts_);
+    if (auto ringName = config_.getShmRingName(); !ringName.empty()) {
+        try {
+            ring_ = std::make_shared<TxRingPublisher>(ringName,
+                static_cast<uint64_t>(
+                    std::max(2, config_.getShmRingCapacity())));
+            Logger::getLogger()->info(
+                "Publishing transactions to shared memory ring {}", ringName);
+        } catch (const std::exception& e) {
+            Logger::getLogger()->error(
+                "Shared memory ring {} disabled: {}", ringName, e.what());
+        }
+    }
+    if (config_.getProbeIntervalMs() > 0) {
+        EndpointProber::Options options;
+        options.interval
+            = std::chrono::milliseconds(config_.getProbeIntervalMs());
+        options.timeout = std::chrono::milliseconds(
+            std::max(1, config_.getProbeTimeoutMs()));
+        options.maxSlotLag
+            = static_cast<uint64_t>(std::max(0, config_.getProbeMaxSlotLag()));
+        prober_ = std::make_unique<EndpointProber>(options,
+            [this](const std::string& sourceId, bool demoted) {
+                onEndpointState(sourceId, demoted);
+            });
+    }
     for (const auto& src : config_.getDataSources()) {
-        addDataSource(src.address, src.type);
+        addDataSource(src);
     }
+    healthCheckThread_ = std::jthread(
+        [this](std::stop_token stoken) { runHealthCheck(std::move(stoken)); });
 }
 
 DataSourceManager::~DataSourceManager()
 {
+    // Both call back into the workers, so they go first.
+    healthCheckThread_.request_stop();
+    if (healthCheckThread_.joinable())
+        healthCheckThread_.join();
+    prober_.reset();
     std::lock_guard lock(mutex_);
     workers_.clear();
 }
 
 std::string DataSourceManager::addDataSource(
     const std::string& address, const std::string& type)
+{
+    ConfigManager::DataSourceConfig source;
+    source.address = address;
+    source.type = type;
+    return addDataSource(source);
+}
+
+std::string DataSourceManager::addDataSource(
+    const ConfigManager::DataSourceConfig& source)
 {
     boost::uuids::random_generator generator;
     boost::uuids::uuid id = generator();
 
     std::string sourceId = boost::uuids::to_string(id);
     std::lock_guard lock(mutex_);
-    workers_[sourceId] = std::make_unique<GeyserClientWorker>(
-        sourceId, address, storage_, notification_, filter_);
-    Logger::getLogger()->info("Added data source: {} ({})", sourceId, address);
-    Q_EMIT sourceAdded(sourceId);
+    if (source.type == "replay") {
+        workers_[sourceId] = std::make_unique<ReplayWorker>(
+            sourceId, source, storage_, notification_, filter_, race_,
+            accounts_, ring_);
+    } else {
+        workers_[sourceId] = std::make_unique<GeyserClientWorker>(sourceId,
+            source, storage_, notification_, filter_, race_, accounts_,
+            ring_);
+    }
+    auto& worker = *workers_[sourceId];
+    worker.dataReceived.subscribe(
+        [this](const std::string& id, const nlohmann::json& data) {
+            dataReceived.publish(id, data);
+        });
+    if (prober_) {
+        if (auto channel = worker.getChannel())
+            prober_->addEndpoint(sourceId, source.address, channel);
+    }
+    Logger::getLogger()->info(
+        "Added data source: {} ({})", sourceId, source.address);
+    sourceAdded.publish(sourceId);
     return sourceId;
 }
 
 void DataSourceManager::removeDataSource(const std::string& sourceId)
 {
+    if (prober_)
+        prober_->removeEndpoint(sourceId);
     std::lock_guard lock(mutex_);
     workers_.erase(sourceId);
     Logger::getLogger()->info("Removed data source: {}", sourceId);
-    Q_EMIT sourceRemoved(sourceId);
+    sourceRemoved.publish(sourceId);
 }
 
 nlohmann::json DataSourceManager::getStats() const
@@ -79,31 +147,107 @@ nlohmann::json DataSourceManager::getStats() const
         json workerStats;
         workerStats["address"] = worker->getAddress();
         workerStats["connected"] = worker->isConnected();
+        workerStats["standby"] = worker->isStandby();
         workerStats["transactions"] = worker->getTotalTransactions();
         workerStats["batches"] = worker->getProcessedBatches();
+        workerStats["bytes_copied_per_tx"]
+            = worker->getBytesCopiedPerTransaction();
+        workerStats["duplicates"] = worker->getDuplicateTransactions();
+        workerStats["reconnects"] = worker->getReconnects();
+        workerStats["checkpoint_slot"] = worker->getCheckpointSlot();
+        workerStats["shards"] = worker->getShardStats();
+        workerStats["pipeline"] = worker->getPipelineStats();
         stats["workers"][id] = workerStats;
     }
+    if (race_)
+        stats["race"] = race_->getStats();
+    stats["accounts"] = accounts_->getStats();
+    if (prober_)
+        stats["probe"] = prober_->getStats();
+    if (ring_)
+        stats["shm_ring"] = ring_->getStats();
     return stats;
 }
 
+void DataSourceManager::visitLatency(const LatencyVisitor& visit) const
+{
+    std::lock_guard lock(mutex_);
+    for (const auto& [id, worker] : workers_) {
+        visit(id, worker->getTracer());
+    }
+}
+
+nlohmann::json DataSourceManager::getLatencyStats() const
+{
+    json stats;
+    stats["sources"] = json::object();
+    // Too large for the stack with all its buckets.
+    auto total = std::make_unique<IngestTracer>();
+    std::lock_guard lock(mutex_);
+    for (const auto& [id, worker] : workers_) {
+        const auto& tracer = worker->getTracer();
+        stats["sources"][id] = { { "address", worker->getAddress() },
+            { "stages", tracer.toJson() } };
+        total->merge(tracer);
+    }
+    stats["total"] = total->toJson();
+    return stats;
+}
+
+void DataSourceManager::onEndpointState(
+    const std::string& sourceId, bool demoted)
+{
+    // Only a redundant feed has another endpoint delivering the same
+    // stream; without racing a lagging source is reported, not parked.
+    if (!race_)
+        return;
+    std::lock_guard lock(mutex_);
+    auto it = workers_.find(sourceId);
+    if (it != workers_.end())
+        it->second->setStandby(demoted);
+}
+
 void DataSourceManager::setHealthCheckInterval(std::chrono::seconds interval)
 {
-    healthCheckTimer_.setInterval(interval.count() * 1000);
+    {
+        std::lock_guard lock(healthCheckMutex_);
+        healthCheckInterval_ = interval;
+        healthCheckRescheduled_ = true;
+    }
+    healthCheckWake_.notify_all();
     Logger::getLogger()->info(
         "Health check interval set to {} seconds", interval.count());
 }
 
+void DataSourceManager::runHealthCheck(std::stop_token stoken)
+{
+    std::unique_lock lock(healthCheckMutex_);
+    while (!stoken.stop_requested()) {
+        // A new interval restarts the wait instead of running a check.
+        if (healthCheckWake_.wait_for(lock, stoken, healthCheckInterval_,
+                [this] { return std::exchange(healthCheckRescheduled_, false); })
+            || stoken.stop_requested())
+            continue;
+        lock.unlock();
+        performHealthCheck();
+        lock.lock();
+    }
+}
+
 void DataSourceManager::performHealthCheck()
 {
-    std::lock_guard lock(mutex_);
-    for (auto it = workers_.begin(); it != workers_.end();) {
-        if (!it->second->isConnected()) {
-            Logger::getLogger()->warn("Unhealthy worker: {}", it->first);
-            it = workers_.erase(it);
-            addDataSource(it->second->getAddress(), "geyser");
-        } else {
-            ++it;
+    // Workers reconnect on their own and resume from their last slot;
+    // recreating one here would throw that position away.
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto& [id, worker] : workers_) {
+            if (!worker->isConnected() && !worker->isStandby()) {
+                Logger::getLogger()->warn(
+                    "Worker {} is reconnecting ({} reconnects so far)", id,
+                    worker->getReconnects());
+            }
         }
     }
+    statsUpdated.publish(getStats());
 }
 }
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "ConfigManager.hpp"
+#include "EventBus.hpp"
+#include "IngestTracer.hpp"
+
+namespace grpc {
+class Channel;
+}
+
+namespace solana {
+
+// A source of Geyser frames feeding an IngestPipeline, live or replayed.
+class DataSourceWorker {
+public:
+    explicit DataSourceWorker(const ConfigManager::DataSourceConfig& source)
+        : source_(source)
+    {
+    }
+
+    virtual ~DataSourceWorker() = default;
+
+    virtual bool isConnected() const = 0;
+    virtual uint64_t getTotalTransactions() const = 0;
+    virtual uint64_t getProcessedBatches() const = 0;
+    virtual uint64_t getDuplicateTransactions() const = 0;
+    virtual uint64_t getReconnects() const = 0;
+    virtual uint64_t getCheckpointSlot() const = 0;
+    virtual double getBytesCopiedPerTransaction() const = 0;
+    virtual json getShardStats() const = 0;
+    virtual json getPipelineStats() const = 0;
+    virtual const IngestTracer& getTracer() const = 0;
+
+    // Live sources expose the channel their stream runs on so it can be
+    // probed; replays have none.
+    virtual std::shared_ptr<grpc::Channel> getChannel() const
+    {
+        return nullptr;
+    }
+
+    // A source on standby keeps its channel but parks its streams until it
+    // is taken off standby, then resumes from the last slot it received.
+    virtual void setStandby(bool /*standby*/) { }
+
+    virtual bool isStandby() const
+    {
+        return false;
+    }
+
+    std::string getAddress() const
+    {
+        return source_.address;
+    }
+
+    const ConfigManager::DataSourceConfig& getSourceConfig() const
+    {
+        return source_;
+    }
+
+    Event<const std::string&, const nlohmann::json&> dataReceived;
+    // Only published by sources with reordering enabled.
+    Event<const std::string&, const nlohmann::json&> slotClosed;
+    Event<const std::string&> error;
+
+protected:
+    ConfigManager::DataSourceConfig source_;
+};
+}
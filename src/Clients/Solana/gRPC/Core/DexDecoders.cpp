@@ -0,0 +1,349 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "DexDecoders.hpp"
+
+#include <array>
+#include <cstring>
+
+namespace solana {
+
+namespace {
+    using Instruction = TransactionView::Instruction;
+    using Discriminator = std::array<uint8_t, 8>;
+
+    // Anchor instruction discriminators: the first 8 bytes of
+    // sha256("global:<instruction name>").
+    constexpr Discriminator SWAP = { 248, 198, 158, 145, 225, 117, 135, 200 };
+    constexpr Discriminator SWAP_V2 = { 43, 4, 237, 11, 26, 201, 30, 98 };
+    constexpr Discriminator SWAP_BASE_INPUT
+        = { 143, 190, 90, 218, 196, 30, 51, 222 };
+    constexpr Discriminator SWAP_BASE_OUTPUT
+        = { 55, 217, 98, 86, 163, 74, 180, 173 };
+    constexpr Discriminator SWAP_EXACT_OUT
+        = { 250, 73, 101, 33, 38, 207, 75, 184 };
+    constexpr Discriminator BUY = { 102, 6, 61, 18, 1, 218, 235, 234 };
+    constexpr Discriminator SELL = { 51, 230, 133, 164, 1, 127, 131, 173 };
+
+    const Pubkey SYSTEM_PROGRAM {};
+    const Pubkey TOKEN_PROGRAM
+        = *Pubkey::fromBase58("TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA");
+    const Pubkey TOKEN_2022_PROGRAM
+        = *Pubkey::fromBase58("TokenzQdBNbLqP5VEhdkAS6EPFLC1PHnBqCXEpPxuEb");
+    const Pubkey WSOL_MINT
+        = *Pubkey::fromBase58("So11111111111111111111111111111111111111112");
+
+    bool hasDiscriminator(std::string_view data, const Discriminator& tag)
+    {
+        return data.size() >= tag.size()
+            && std::memcmp(data.data(), tag.data(), tag.size()) == 0;
+    }
+
+    // Little-endian, as Borsh and the token programs lay them out.
+    uint64_t readU64(std::string_view data, size_t offset)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            value |= uint64_t { static_cast<uint8_t>(data[offset + i]) }
+                << (8 * i);
+        }
+        return value;
+    }
+
+    const Pubkey* accountKey(const TransactionView& view,
+        const Instruction& instruction, size_t position)
+    {
+        if (position >= instruction.accounts.size())
+            return nullptr;
+        auto index = static_cast<uint8_t>(instruction.accounts[position]);
+        return index < view.keys.size() ? &view.keys[index] : nullptr;
+    }
+
+    // Pool and user from their account positions, the amounts from the
+    // two u64 arguments at offset: the specified amount first, unless
+    // thresholdFirst, as in exact-out swaps that take the most input
+    // before the output wanted.
+    bool fill(const TransactionView& view, const Instruction& instruction,
+        DexSwap& swap, size_t pool, size_t user, size_t offset, bool exactIn,
+        bool thresholdFirst = false)
+    {
+        const Pubkey* poolKey = accountKey(view, instruction, pool);
+        const Pubkey* userKey = accountKey(view, instruction, user);
+        if (!poolKey || !userKey || instruction.data.size() < offset + 16)
+            return false;
+        swap.pool = *poolKey;
+        swap.user = *userKey;
+        swap.exactIn = exactIn;
+        swap.amountSpecified
+            = readU64(instruction.data, thresholdFirst ? offset + 8 : offset);
+        swap.otherAmountThreshold
+            = readU64(instruction.data, thresholdFirst ? offset : offset + 8);
+        return true;
+    }
+
+    bool decodeRaydiumAmm(const TransactionView& view,
+        const Instruction& instruction, DexSwap& swap)
+    {
+        constexpr uint8_t SWAP_BASE_IN = 9;
+        constexpr uint8_t SWAP_BASE_OUT = 11;
+        const auto& data = instruction.data;
+        // With or without the target orders account, the user's source,
+        // destination and owner come last.
+        const size_t accounts = instruction.accounts.size();
+        if (data.empty() || accounts < 17)
+            return false;
+        auto tag = static_cast<uint8_t>(data[0]);
+        if (tag != SWAP_BASE_IN && tag != SWAP_BASE_OUT)
+            return false;
+        // SwapBaseOut takes (max_amount_in, amount_out).
+        return fill(view, instruction, swap, 1, accounts - 1, 1,
+            tag == SWAP_BASE_IN, tag == SWAP_BASE_OUT);
+    }
+
+    bool decodeRaydiumCpmm(const TransactionView& view,
+        const Instruction& instruction, DexSwap& swap)
+    {
+        const auto& data = instruction.data;
+        if (hasDiscriminator(data, SWAP_BASE_INPUT))
+            return fill(view, instruction, swap, 3, 0, 8, true);
+        // (max_amount_in, amount_out)
+        if (hasDiscriminator(data, SWAP_BASE_OUTPUT))
+            return fill(view, instruction, swap, 3, 0, 8, false, true);
+        return false;
+    }
+
+    // Concentrated liquidity swaps share one argument layout: amount,
+    // other amount threshold, a u128 price limit and the is-input flag.
+    bool fillConcentrated(const TransactionView& view,
+        const Instruction& instruction, DexSwap& swap, size_t pool,
+        size_t user)
+    {
+        constexpr size_t IS_INPUT = 8 + 8 + 8 + 16;
+        if (instruction.data.size() <= IS_INPUT)
+            return false;
+        return fill(view, instruction, swap, pool, user, 8,
+            instruction.data[IS_INPUT] != 0);
+    }
+
+    bool decodeRaydiumClmm(const TransactionView& view,
+        const Instruction& instruction, DexSwap& swap)
+    {
+        const auto& data = instruction.data;
+        if (hasDiscriminator(data, SWAP) || hasDiscriminator(data, SWAP_V2))
+            return fillConcentrated(view, instruction, swap, 2, 0);
+        return false;
+    }
+
+    bool decodeWhirlpool(const TransactionView& view,
+        const Instruction& instruction, DexSwap& swap)
+    {
+        const auto& data = instruction.data;
+        if (hasDiscriminator(data, SWAP))
+            return fillConcentrated(view, instruction, swap, 2, 1);
+        // Token programs and the memo program go first in v2.
+        if (hasDiscriminator(data, SWAP_V2))
+            return fillConcentrated(view, instruction, swap, 4, 3);
+        return false;
+    }
+
+    bool decodeMeteoraDlmm(const TransactionView& view,
+        const Instruction& instruction, DexSwap& swap)
+    {
+        const auto& data = instruction.data;
+        if (hasDiscriminator(data, SWAP))
+            return fill(view, instruction, swap, 0, 10, 8, true);
+        // (max_in_amount, out_amount)
+        if (hasDiscriminator(data, SWAP_EXACT_OUT))
+            return fill(view, instruction, swap, 0, 10, 8, false, true);
+        return false;
+    }
+
+    // Buys name the tokens wanted and the most SOL to pay; sells the
+    // tokens given and the least SOL to take.
+    bool decodePumpFun(const TransactionView& view,
+        const Instruction& instruction, DexSwap& swap)
+    {
+        const auto& data = instruction.data;
+        if (hasDiscriminator(data, BUY)) {
+            swap.side = DexSwap::Side::Buy;
+            return fill(view, instruction, swap, 3, 6, 8, false);
+        }
+        if (hasDiscriminator(data, SELL)) {
+            swap.side = DexSwap::Side::Sell;
+            return fill(view, instruction, swap, 3, 6, 8, true);
+        }
+        return false;
+    }
+
+    bool decodePumpAmm(const TransactionView& view,
+        const Instruction& instruction, DexSwap& swap)
+    {
+        constexpr size_t QUOTE_MINT = 4;
+        const auto& data = instruction.data;
+        bool buy = hasDiscriminator(data, BUY);
+        if (!buy && !hasDiscriminator(data, SELL))
+            return false;
+        // Most pools quote in WSOL, but not all of them.
+        const Pubkey* quote = accountKey(view, instruction, QUOTE_MINT);
+        if (quote && *quote == WSOL_MINT)
+            swap.side = buy ? DexSwap::Side::Buy : DexSwap::Side::Sell;
+        return fill(view, instruction, swap, 0, 1, 8, !buy);
+    }
+
+    // SPL token Transfer and TransferChecked, and system Transfer.
+    bool readTransfer(const TransactionView& view,
+        const Instruction& instruction, Pubkey& authority, uint64_t& amount)
+    {
+        constexpr uint8_t TOKEN_TRANSFER = 3;
+        constexpr uint8_t TOKEN_TRANSFER_CHECKED = 12;
+        // A u32 instruction tag.
+        constexpr std::string_view SYSTEM_TRANSFER { "\x02\0\0\0", 4 };
+        const auto& data = instruction.data;
+        size_t signer;
+        size_t offset;
+        if (instruction.program == TOKEN_PROGRAM
+            || instruction.program == TOKEN_2022_PROGRAM) {
+            if (data.size() < 9)
+                return false;
+            auto tag = static_cast<uint8_t>(data[0]);
+            if (tag == TOKEN_TRANSFER)
+                signer = 2;
+            else if (tag == TOKEN_TRANSFER_CHECKED)
+                signer = 3;
+            else
+                return false;
+            offset = 1;
+        } else if (instruction.program == SYSTEM_PROGRAM) {
+            if (data.size() < 12 || !data.starts_with(SYSTEM_TRANSFER))
+                return false;
+            signer = 0;
+            offset = 4;
+        } else {
+            return false;
+        }
+        const Pubkey* key = accountKey(view, instruction, signer);
+        if (!key)
+            return false;
+        authority = *key;
+        amount = readU64(data, offset);
+        return true;
+    }
+
+    // The first transfer the user signs is what goes in, the first one
+    // anybody else signs is what comes out. Only transfers the swap made
+    // itself count, which leaves out those of swaps it invoked in turn.
+    void fillTransfers(const TransactionView& view, DexSwap& swap)
+    {
+        const auto& inner = view.innerInstructions;
+        size_t begin;
+        uint32_t height;
+        if (swap.innerIndex < 0) {
+            begin = 0;
+            while (begin < inner.size()
+                && inner[begin].outerIndex != swap.outerIndex) {
+                ++begin;
+            }
+            height = 1;
+        } else {
+            begin = static_cast<size_t>(swap.innerIndex) + 1;
+            height = inner[swap.innerIndex].stackHeight;
+        }
+        for (size_t i = begin; i < inner.size()
+             && inner[i].outerIndex == swap.outerIndex
+             && inner[i].stackHeight > height;
+            ++i) {
+            Pubkey authority;
+            uint64_t amount;
+            if (inner[i].stackHeight != height + 1
+                || !readTransfer(view, inner[i], authority, amount))
+                continue;
+            if (authority == swap.user) {
+                if (!swap.amountIn)
+                    swap.amountIn = amount;
+            } else if (!swap.amountOut) {
+                swap.amountOut = amount;
+            }
+        }
+    }
+}
+
+void DexDecoderRegistry::add(const Pubkey& program, Decoder decoder)
+{
+    decoders_[program] = std::move(decoder);
+}
+
+bool DexDecoderRegistry::decode(const TransactionView& view,
+    uint32_t outerIndex, int32_t innerIndex, DexSwap& swap) const
+{
+    const Instruction* instruction = nullptr;
+    if (innerIndex < 0) {
+        if (outerIndex < view.instructions.size())
+            instruction = &view.instructions[outerIndex];
+    } else if (static_cast<size_t>(innerIndex)
+        < view.innerInstructions.size()) {
+        instruction = &view.innerInstructions[innerIndex];
+    }
+    if (!instruction)
+        return false;
+    auto decoder = decoders_.find(instruction->program);
+    if (decoder == decoders_.end())
+        return false;
+
+    swap = DexSwap {};
+    swap.program = instruction->program;
+    swap.outerIndex = outerIndex;
+    swap.innerIndex = innerIndex;
+    if (!decoder->second(view, *instruction, swap))
+        return false;
+    fillTransfers(view, swap);
+    // Buys pay SOL in, sells take it out.
+    if (swap.side == DexSwap::Side::Buy) {
+        swap.solAmount
+            = swap.amountIn ? swap.amountIn : swap.otherAmountThreshold;
+    } else if (swap.side == DexSwap::Side::Sell) {
+        swap.solAmount
+            = swap.amountOut ? swap.amountOut : swap.otherAmountThreshold;
+    }
+    return true;
+}
+
+std::shared_ptr<const DexDecoderRegistry> DexDecoderRegistry::builtin()
+{
+    static const auto registry = [] {
+        auto registry = std::make_shared<DexDecoderRegistry>();
+        const std::pair<const char*, Decoder> decoders[] = {
+            { "675kPX9MHTjS2zt1qfr1NYHuzeLXfQM9H24wFSUt1Mp8",
+                decodeRaydiumAmm },
+            { "CPMMoo8L3F4NbTegBCKVNunggL7H1ZpdTHKxQB5qKP1C",
+                decodeRaydiumCpmm },
+            { "CAMMCzo5YL8w4VFF8KVHrK22GGUsp5VTaW7grrKgrWqK",
+                decodeRaydiumClmm },
+            { "whirLbMiicVdio4qvUfM5KAg6Ct8VwpYzGff3uctyCc", decodeWhirlpool },
+            { "LBUZKhRxPF3XUpBCjp4YzTKgLccjZhTSDM9YuVaPwxo",
+                decodeMeteoraDlmm },
+            { "6EF8rrecthR5Dkzon8Nwu78hRvfCKubJ14M5uBEwF6P", decodePumpFun },
+            { "pAMMBay6oceH9fJKBRHGP5D4bD4sWpmSwMn52FMfXEA", decodePumpAmm },
+        };
+        for (const auto& [program, decoder] : decoders) {
+            registry->add(*Pubkey::fromBase58(program), decoder);
+        }
+        return std::shared_ptr<const DexDecoderRegistry>(std::move(registry));
+    }();
+    return registry;
+}
+}
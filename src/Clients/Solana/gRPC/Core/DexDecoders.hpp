@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "Pubkey.hpp"
+#include "TransactionView.hpp"
+
+namespace solana {
+
+// One swap instruction, decoded from its data and accounts.
+struct DexSwap {
+    Pubkey program;
+    Pubkey pool;
+    // Signs for the tokens going in.
+    Pubkey user;
+    // As the instruction asked: an exact input and the least output it
+    // accepts, or an exact output and the most input it pays.
+    bool exactIn { true };
+    uint64_t amountSpecified { 0 };
+    uint64_t otherAmountThreshold { 0 };
+    // What moved, read off the transfers the swap made itself. 0 where no
+    // transfer shows it, as for lamports a bonding curve pays out directly
+    // or for nodes that do not record stack heights.
+    uint64_t amountIn { 0 };
+    uint64_t amountOut { 0 };
+    // Buy or sell of a token for SOL, where the decoder knows one side is
+    // SOL: Pump.fun, and Pump AMM pools quoted in WSOL. solAmount is the
+    // lamports transferred, or the instruction's SOL bound where no
+    // transfer shows them.
+    enum class Side : uint8_t { Buy, Sell, Unknown };
+    Side side { Side::Unknown };
+    uint64_t solAmount { 0 };
+    // The outer instruction it runs under, and its position in
+    // innerInstructions when it was invoked by another program; -1 when it
+    // is the outer instruction itself.
+    uint32_t outerIndex { 0 };
+    int32_t innerIndex { -1 };
+};
+
+/**
+ * Swap decoders keyed by program id. Each decoder knows the instruction
+ * layouts of one program; the registry finds the instruction in the
+ * view, hands it to the decoder and then fills in the amounts from the
+ * token and SOL transfers the swap invoked. Account indexes are resolved
+ * through view.keys, so accounts loaded from lookup tables work the same
+ * as static ones.
+ */
+class DexDecoderRegistry {
+public:
+    // Fills pool, user and the requested amounts. Returns false when the
+    // instruction is not a swap, or its data or accounts are too short.
+    using Decoder = std::function<bool(const TransactionView& view,
+        const TransactionView::Instruction& instruction, DexSwap& swap)>;
+
+    // Replaces any decoder already registered for program.
+    void add(const Pubkey& program, Decoder decoder);
+
+    bool contains(const Pubkey& program) const
+    {
+        return decoders_.contains(program);
+    }
+
+    // Decodes view.instructions[outerIndex], or
+    // view.innerInstructions[innerIndex] unless that is -1.
+    bool decode(const TransactionView& view, uint32_t outerIndex,
+        int32_t innerIndex, DexSwap& swap) const;
+
+    // Raydium AMM v4, CPMM and CLMM, Orca Whirlpool, Meteora DLMM,
+    // Pump.fun and the Pump.fun AMM.
+    static std::shared_ptr<const DexDecoderRegistry> builtin();
+
+private:
+    PubkeyMap<Decoder> decoders_;
+};
+}
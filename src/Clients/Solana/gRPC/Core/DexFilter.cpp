@@ -19,99 +19,208 @@
 #include "DexFilter.hpp"
 
 #include "../Utils/Logger.hpp"
+#include "DexPrograms.hpp"
 
 namespace solana {
 
-DexFilter::DexFilter(std::unordered_set<std::string> dexPrograms)
-    : dexPrograms_(std::move(dexPrograms))
+namespace {
+    void insertProgram(PubkeySet& programs, const std::string& program)
+    {
+        if (auto key = Pubkey::fromBase58(program))
+            programs.insert(*key);
+        else
+            Logger::getLogger()->warn(
+                "DexFilter: ignoring invalid program id {}", program);
+    }
+
+    const char* sideName(DexSwap::Side side)
+    {
+        switch (side) {
+        case DexSwap::Side::Buy:
+            return "buy";
+        case DexSwap::Side::Sell:
+            return "sell";
+        case DexSwap::Side::Unknown:
+            break;
+        }
+        return "unknown";
+    }
+}
+
+DexFilter::DexFilter(std::unordered_set<std::string> dexPrograms,
+    std::shared_ptr<const DexDecoderRegistry> decoders)
+    : config_(std::make_unique<const Config>())
+    , decoders_(std::move(decoders))
 {
-    dexNames_["675kPX9MHTjS2zt1qfr1NYHuzeLXfQM9H24wFSUt1Mp8"] = "Raydium";
-    dexNames_["6EF8rrecthR5Dkzon8Nwu78hRvfCKubJ14M5uBEwF6P"] = "Pump.fun";
+    size_t programs = 0;
+    config_.update([&](Config& config) {
+        for (const auto& program : dexPrograms) {
+            insertProgram(config.dexPrograms, program);
+        }
+        for (const auto& [name, address] : DEX_PROGRAMS) {
+            config.dexNames[*Pubkey::fromBase58(address)] = name;
+        }
+        programs = config.dexPrograms.size();
+    });
     Logger::getLogger()->info(
-        "DexFilter initialized with {} programs", dexPrograms_.size());
+        "DexFilter initialized with {} programs", programs);
 }
 
 void DexFilter::processTransaction(
     const std::string& sourceId, const geyser::SubscribeUpdateTransaction& tx)
+{
+    // The view points into the serialized bytes, which must outlive it.
+    const std::string wire = tx.SerializeAsString();
+    TransactionView view;
+    if (view.scanTransaction(wire) && view.resolve())
+        processView(sourceId, view);
+}
+
+void DexFilter::processView(
+    const std::string& sourceId, const TransactionView& view)
 {
     incrementProcessCount();
     try {
-        const auto& transaction = tx.transaction();
-        const auto& signature = transaction.signature();
-        const auto& accountKeys
-            = transaction.transaction().message().account_keys();
-        const auto& instructions
-            = transaction.transaction().message().instructions();
-
-        for (const auto& instr : instructions) {
-            uint32_t programIdIndex = instr.program_id_index();
-            if (programIdIndex >= accountKeys.size())
-                continue;
-            const std::string& programId = accountKeys[programIdIndex];
-            if (!dexPrograms_.contains(programId))
-                continue;
-
-            std::vector<std::string> accounts;
-            for (uint32_t accountIdx : instr.accounts()) {
-                if (accountIdx < accountKeys.size())
-                    accounts.push_back(accountKeys[accountIdx]);
-            }
-            std::string dexName = dexNames_.count(programId)
-                ? dexNames_.at(programId)
-                : "Unknown DEX";
-            DexTransactionInfo info { signature, programId, dexName, {}, {},
-                accounts, std::chrono::system_clock::now() };
-            {
-                std::lock_guard lock(recentTxMutex_);
-                recentTransactions_.push_back(std::move(info));
-                if (recentTransactions_.size() > maxRecentTransactions_) {
-                    recentTransactions_.erase(recentTransactions_.begin());
-                }
+        auto config = config_.read();
+        // Inner instructions catch swaps routed through an aggregator,
+        // where the DEX is only ever invoked by CPI. Every swap is kept;
+        // a transaction that only calls a DEX some other way, or one
+        // without a decoder, is kept once under its first such call.
+        std::optional<DexSwap> undecoded;
+        bool swapped = false;
+        view.forEachInstruction([&](const auto& instruction,
+                                    uint32_t outerIndex, int32_t innerIndex) {
+            if (!config->dexPrograms.contains(instruction.program))
+                return;
+            DexSwap swap;
+            if (decoders_->decode(view, outerIndex, innerIndex, swap)) {
+                recordMatch(view, swap, true, *config);
+                swapped = true;
+            } else if (!undecoded) {
+                undecoded.emplace();
+                undecoded->program = instruction.program;
+                undecoded->outerIndex = outerIndex;
+                undecoded->innerIndex = innerIndex;
             }
+        });
+        if (!swapped && undecoded)
+            recordMatch(view, *undecoded, false, *config);
+        if (swapped || undecoded)
             incrementMatchCount();
-            Logger::getLogger()->info(
-                "DEX transaction detected: {} (Program: {}, DEX: {})",
-                signature, programId, dexName);
-            break;
-        }
     } catch (const std::exception& e) {
         Logger::getLogger()->error("DexFilter error: {}", e.what());
     }
 }
 
+void DexFilter::recordMatch(const TransactionView& view, const DexSwap& swap,
+    bool decoded, const Config& config)
+{
+    DexTransactionInfo info { Signature::fromBytes(view.signature), swap,
+        decoded,
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count() };
+    {
+        std::lock_guard lock(recentTxMutex_);
+        recentTransactions_.push(info);
+    }
+    if (decoded && !swapDecoded.empty())
+        swapDecoded.publish(swap, info.timestampMs);
+    if (!Logger::getLogger()->should_log(spdlog::level::info))
+        return;
+    if (decoded)
+        Logger::getLogger()->info(
+            "DEX swap detected: {} (DEX: {}, pool: {}, in: {}, out: {})",
+            info.signature.toBase58(), dexName(config, swap.program),
+            swap.pool.toBase58(), swap.amountIn, swap.amountOut);
+    else
+        Logger::getLogger()->info(
+            "DEX transaction detected: {} (Program: {}, DEX: {})",
+            info.signature.toBase58(), swap.program.toBase58(),
+            dexName(config, swap.program));
+}
+
+std::string DexFilter::dexName(const Config& config, const Pubkey& program)
+{
+    auto name = config.dexNames.find(program);
+    return name != config.dexNames.end() ? name->second : "Unknown DEX";
+}
+
+std::optional<SubscriptionFilter> DexFilter::subscription() const
+{
+    auto config = config_.read();
+    SubscriptionFilter filter;
+    for (const auto& program : config->dexPrograms) {
+        filter.accountInclude.push_back(program.toBase58());
+    }
+    return filter;
+}
+
 void DexFilter::updateConfig(const std::string& config)
 {
     try {
         auto json = json::parse(config);
-        std::lock_guard lock(mutex_);
-        if (json.contains("dex_programs")) {
-            dexPrograms_.clear();
-            for (const auto& program : json["dex_programs"]) {
-                dexPrograms_.insert(program.get<std::string>());
-            }
-            Logger::getLogger()->info(
-                "Updated DEX programs: {}", dexPrograms_.size());
+        if (!json.contains("dex_programs"))
+            return;
+        // Parsed before the swap, so processView() never sees a partly
+        // filled program set.
+        PubkeySet programs;
+        for (const auto& program : json["dex_programs"]) {
+            insertProgram(programs, program.get<std::string>());
         }
+        size_t count = programs.size();
+        config_.update([&programs](Config& next) {
+            next.dexPrograms = std::move(programs);
+        });
+        Logger::getLogger()->info("Updated DEX programs: {}", count);
     } catch (const std::exception& e) {
         Logger::getLogger()->error(
             "Failed to update DexFilter config: {}", e.what());
     }
 }
 
-json DexFilter::getRecentDexTransactions(size_t maxEntries) const
+json DexFilter::toJson(
+    uint64_t sequence, const DexTransactionInfo& info, const Config& config)
 {
-    std::lock_guard lock(recentTxMutex_);
-    json result = json::array();
-    size_t count = 0;
-    for (auto it = recentTransactions_.rbegin();
-        it != recentTransactions_.rend() && count < maxEntries; ++it, ++count) {
-        json tx;
-        tx["signature"] = it->signature;
-        tx["dex_program"] = it->dexProgram;
-        tx["dex_name"] = it->dexName;
-        result.push_back(tx);
+    json result = { { "seq", sequence },
+        { "signature", info.signature.toBase58() },
+        { "dex_program", info.swap.program.toBase58() },
+        { "dex_name", dexName(config, info.swap.program) },
+        { "timestamp_ms", info.timestampMs } };
+    if (info.decoded) {
+        const DexSwap& swap = info.swap;
+        result["swap"] = { { "pool", swap.pool.toBase58() },
+            { "user", swap.user.toBase58() }, { "exact_in", swap.exactIn },
+            { "amount_specified", swap.amountSpecified },
+            { "other_amount_threshold", swap.otherAmountThreshold },
+            { "amount_in", swap.amountIn }, { "amount_out", swap.amountOut },
+            { "side", sideName(swap.side) }, { "sol_amount", swap.solAmount },
+            { "outer_index", swap.outerIndex },
+            { "inner_index", swap.innerIndex } };
     }
+    return result;
+}
 
+json DexFilter::getRecentDexTransactions(size_t maxEntries) const
+{
+    json result = json::array();
+    auto config = config_.read();
+    recentTransactions_.latest(
+        maxEntries, [&](uint64_t sequence, const DexTransactionInfo& info) {
+            result.push_back(toJson(sequence, info, *config));
+        });
     return result;
 }
+
+json DexFilter::getDexTransactionsSince(
+    uint64_t since, size_t maxEntries) const
+{
+    json transactions = json::array();
+    auto config = config_.read();
+    uint64_t next = recentTransactions_.since(since, maxEntries,
+        [&](uint64_t sequence, const DexTransactionInfo& info) {
+            transactions.push_back(toJson(sequence, info, *config));
+        });
+    return { { "transactions", transactions }, { "next", next } };
+}
 }
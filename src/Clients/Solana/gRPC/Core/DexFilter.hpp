@@ -19,7 +19,6 @@
 #pragma once
 
 #include <mutex>
-#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -27,42 +26,79 @@
 
 using json = nlohmann::json;
 
+#include "DexDecoders.hpp"
+#include "EventBus.hpp"
+#include "Pubkey.hpp"
+#include "RcuPtr.hpp"
+#include "RecentRing.hpp"
 #include "TransactionFilter.hpp"
 
 namespace solana {
 
 class DexFilter : public TransactionFilter {
 public:
-    explicit DexFilter(std::unordered_set<std::string> dexPrograms);
+    explicit DexFilter(std::unordered_set<std::string> dexPrograms,
+        std::shared_ptr<const DexDecoderRegistry> decoders
+        = DexDecoderRegistry::builtin());
     void processTransaction(const std::string& sourceId,
         const geyser::SubscribeUpdateTransaction& tx) override;
+    void processView(
+        const std::string& sourceId, const TransactionView& view) override;
     void updateConfig(const std::string& config) override;
 
+    bool needsFullTransaction() const override
+    {
+        return false;
+    }
+
     std::string name() const override
     {
         return "DexFilter";
     }
 
+    std::optional<SubscriptionFilter> subscription() const override;
+
+    // Newest first.
     json getRecentDexTransactions(size_t maxEntries = 100) const;
+    // Oldest first from sequence since on, as
+    // {"transactions": [...], "next": n} where n is the since to ask for
+    // next.
+    json getDexTransactionsSince(
+        uint64_t since, size_t maxEntries = 100) const;
+
+    // Every decoded swap with when it was seen, in milliseconds since the
+    // epoch, on the filter thread that found it.
+    Event<const DexSwap&, int64_t> swapDecoded;
 
 private:
+    // Kept binary and formatted only when read.
     struct DexTransactionInfo {
-        std::string signature;
-        std::string dexProgram;
-        std::string dexName;
-        std::optional<std::string> market;
-        std::optional<std::string> marketName;
-        std::vector<std::string> accounts;
-        std::chrono::system_clock::time_point timestamp;
+        Signature signature;
+        // Only swap.program and the position are set unless decoded.
+        DexSwap swap;
+        bool decoded;
+        int64_t timestampMs;
+    };
+
+    // Replaced as a whole by updateConfig(), never changed in place.
+    struct Config {
+        PubkeySet dexPrograms;
+        PubkeyMap<std::string> dexNames;
+        PubkeySet marketWhitelist;
+        PubkeySet marketBlacklist;
+        PubkeyMap<std::string> marketNames;
     };
 
-    std::unordered_set<std::string> dexPrograms_;
-    std::unordered_map<std::string, std::string> dexNames_;
-    std::unordered_set<std::string> marketWhitelist_;
-    std::unordered_set<std::string> marketBlacklist_;
-    std::unordered_map<std::string, std::string> marketNames_;
-    std::vector<DexTransactionInfo> recentTransactions_;
-    mutable std::mutex recentTxMutex_;
-    const size_t maxRecentTransactions_ = 1000;
+    void recordMatch(const TransactionView& view, const DexSwap& swap,
+        bool decoded, const Config& config);
+    static std::string dexName(const Config& config, const Pubkey& program);
+    static json toJson(uint64_t sequence, const DexTransactionInfo& info,
+        const Config& config);
+
+    RcuPtr<Config> config_;
+    const std::shared_ptr<const DexDecoderRegistry> decoders_;
+    RecentRing<DexTransactionInfo> recentTransactions_ { 1024 };
+    // Serializes writers of recentTransactions_; readers never take it.
+    std::mutex recentTxMutex_;
 };
 }
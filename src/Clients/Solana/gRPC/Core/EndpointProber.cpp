@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "EndpointProber.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "../Utils/Logger.hpp"
+
+namespace solana {
+
+EndpointProber::EndpointProber(Options options, StateCallback onChange)
+    : options_(options)
+    , onChange_(std::move(onChange))
+{
+    armTick(std::chrono::steady_clock::now());
+    thread_ = std::thread([this] { run(); });
+}
+
+EndpointProber::~EndpointProber()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+        tick_.Cancel();
+        for (auto& probe : inFlight_) {
+            probe->context.TryCancel();
+        }
+    }
+    cq_.Shutdown();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void EndpointProber::addEndpoint(const std::string& id,
+    const std::string& address, std::shared_ptr<grpc::Channel> channel)
+{
+    auto endpoint = std::make_shared<Endpoint>();
+    endpoint->id = id;
+    endpoint->address = address;
+    endpoint->stub = geyser::Geyser::NewStub(std::move(channel));
+    std::lock_guard lock(mutex_);
+    endpoints_[id] = std::move(endpoint);
+}
+
+void EndpointProber::removeEndpoint(const std::string& id)
+{
+    std::lock_guard lock(mutex_);
+    auto it = endpoints_.find(id);
+    if (it == endpoints_.end())
+        return;
+    // Probes still in flight keep the endpoint alive until they complete.
+    it->second->removed = true;
+    endpoints_.erase(it);
+}
+
+bool EndpointProber::isDemoted(const std::string& id) const
+{
+    std::lock_guard lock(mutex_);
+    auto it = endpoints_.find(id);
+    return it != endpoints_.end() && it->second->demoted;
+}
+
+json EndpointProber::getStats() const
+{
+    json stats;
+    stats["rounds"] = rounds_.load();
+    stats["best_slot"] = bestSlot_.load();
+    stats["endpoints"] = json::object();
+    std::lock_guard lock(mutex_);
+    for (const auto& [id, endpoint] : endpoints_) {
+        json endpointStats;
+        endpointStats["address"] = endpoint->address;
+        endpointStats["demoted"] = endpoint->demoted.load();
+        endpointStats["slot"] = endpoint->slot.load();
+        endpointStats["probes"] = endpoint->probes.load();
+        endpointStats["failures"] = endpoint->failures.load();
+        endpointStats["demotions"] = endpoint->demotions.load();
+        endpointStats["promotions"] = endpoint->promotions.load();
+        endpointStats["rtt_us"] = endpoint->rttUs.toJson();
+        endpointStats["slot_lag"] = endpoint->slotLag.toJson();
+        stats["endpoints"][id] = endpointStats;
+    }
+    return stats;
+}
+
+void EndpointProber::run()
+{
+    void* tag;
+    bool ok = false;
+    while (cq_.Next(&tag, &ok)) {
+        if (tag == &tick_) {
+            if (ok)
+                startRound();
+            continue;
+        }
+        onProbe(static_cast<Probe*>(tag));
+    }
+}
+
+void EndpointProber::startRound()
+{
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard lock(mutex_);
+        if (stopping_)
+            return;
+        roundStartedAt_ = now;
+        round_.clear();
+        auto deadline = std::chrono::system_clock::now() + options_.timeout;
+        for (auto& [id, endpoint] : endpoints_) {
+            endpoint->pinged = false;
+            endpoint->slotted = false;
+            ++endpoint->probes;
+            round_.push_back(endpoint);
+
+            auto ping = std::make_unique<Probe>();
+            ping->kind = Probe::Kind::PING;
+            ping->endpoint = endpoint;
+            ping->context.set_deadline(deadline);
+            ping->sentAt = now;
+            geyser::PingRequest pingRequest;
+            pingRequest.set_count(static_cast<int32_t>(rounds_.load()));
+            ping->pingReader = endpoint->stub->AsyncPing(
+                &ping->context, pingRequest, &cq_);
+            ping->pingReader->Finish(&ping->pong, &ping->status, ping.get());
+            inFlight_.push_back(std::move(ping));
+
+            auto slot = std::make_unique<Probe>();
+            slot->kind = Probe::Kind::SLOT;
+            slot->endpoint = endpoint;
+            slot->context.set_deadline(deadline);
+            slot->sentAt = now;
+            geyser::GetSlotRequest slotRequest;
+            slotRequest.set_commitment(geyser::CommitmentLevel::PROCESSED);
+            slot->slotReader = endpoint->stub->AsyncGetSlot(
+                &slot->context, slotRequest, &cq_);
+            slot->slotReader->Finish(&slot->slot, &slot->status, slot.get());
+            inFlight_.push_back(std::move(slot));
+        }
+        if (!inFlight_.empty())
+            return;
+    }
+    armTick(now + options_.interval);
+}
+
+void EndpointProber::onProbe(Probe* probe)
+{
+    auto& endpoint = *probe->endpoint;
+    if (probe->status.ok()) {
+        if (probe->kind == Probe::Kind::PING) {
+            endpoint.rttUs.record(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - probe->sentAt)
+                    .count());
+            endpoint.pinged = true;
+        } else {
+            endpoint.roundSlot = probe->slot.slot();
+            endpoint.slot = endpoint.roundSlot;
+            endpoint.slotted = true;
+        }
+    } else {
+        ++endpoint.failures;
+    }
+
+    bool roundDone = false;
+    {
+        std::lock_guard lock(mutex_);
+        std::erase_if(inFlight_,
+            [probe](const auto& active) { return active.get() == probe; });
+        roundDone = inFlight_.empty();
+    }
+    if (roundDone)
+        finishRound();
+}
+
+void EndpointProber::finishRound()
+{
+    ++rounds_;
+    uint64_t best = 0;
+    for (const auto& endpoint : round_) {
+        if (endpoint->slotted)
+            best = std::max(best, endpoint->roundSlot);
+    }
+    if (best > bestSlot_)
+        bestSlot_ = best;
+
+    // Lag is measured against the most advanced endpoint of this round, so
+    // a stalled cluster does not demote everyone at once.
+    std::vector<bool> healthy(round_.size(), false);
+    size_t healthyActive = 0;
+    for (size_t i = 0; i < round_.size(); ++i) {
+        auto& endpoint = *round_[i];
+        if (endpoint.slotted)
+            endpoint.slotLag.record(best - endpoint.roundSlot);
+        healthy[i] = endpoint.pinged && endpoint.slotted
+            && best - endpoint.roundSlot <= options_.maxSlotLag;
+        if (healthy[i]) {
+            ++endpoint.goodRounds;
+            endpoint.badRounds = 0;
+        } else {
+            ++endpoint.badRounds;
+            endpoint.goodRounds = 0;
+        }
+        if (healthy[i] && !endpoint.demoted && !endpoint.removed)
+            ++healthyActive;
+    }
+
+    std::vector<std::pair<std::string, bool>> changes;
+    for (size_t i = 0; i < round_.size(); ++i) {
+        auto& endpoint = *round_[i];
+        if (endpoint.removed)
+            continue;
+        if (endpoint.demoted && endpoint.goodRounds >= options_.promoteAfter) {
+            endpoint.demoted = false;
+            ++endpoint.promotions;
+            Logger::getLogger()->info(
+                "Promoting endpoint {}: healthy for {} probe rounds",
+                endpoint.address, endpoint.goodRounds);
+            changes.emplace_back(endpoint.id, false);
+        } else if (!endpoint.demoted
+            && endpoint.badRounds >= options_.demoteAfter
+            && healthyActive > 0) {
+            // Never demote the last endpoint that is still keeping up.
+            endpoint.demoted = true;
+            ++endpoint.demotions;
+            Logger::getLogger()->warn(
+                "Demoting endpoint {}: {} slots behind after {} probe rounds",
+                endpoint.address,
+                endpoint.slotted ? best - endpoint.roundSlot : 0,
+                endpoint.badRounds);
+            changes.emplace_back(endpoint.id, true);
+        }
+    }
+    round_.clear();
+
+    {
+        std::lock_guard lock(mutex_);
+        if (stopping_)
+            return;
+    }
+    if (onChange_) {
+        for (const auto& [id, demoted] : changes) {
+            onChange_(id, demoted);
+        }
+    }
+    armTick(roundStartedAt_ + options_.interval);
+}
+
+void EndpointProber::armTick(std::chrono::steady_clock::time_point at)
+{
+    std::lock_guard lock(mutex_);
+    if (stopping_)
+        return;
+    // grpc::Alarm only takes system_clock deadlines.
+    auto wallDeadline = std::chrono::system_clock::now()
+        + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            at - std::chrono::steady_clock::now());
+    tick_.Set(&cq_, wallDeadline, &tick_);
+}
+}
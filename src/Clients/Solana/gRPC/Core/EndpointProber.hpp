@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/alarm.h>
+#include <grpcpp/grpcpp.h>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include <geyser.grpc.pb.h>
+
+#include "LatencyHistogram.hpp"
+
+namespace solana {
+
+/**
+ * Background health check for Geyser endpoints. Every round sends a Ping
+ * and a GetSlot to each endpoint over its own channel, records the round
+ * trip and how many slots it trails the most advanced endpoint, and demotes
+ * endpoints that keep falling behind until they catch up again.
+ */
+class EndpointProber {
+public:
+    struct Options {
+        std::chrono::milliseconds interval { 1000 };
+        std::chrono::milliseconds timeout { 500 };
+        uint64_t maxSlotLag { 4 };
+        int demoteAfter { 3 };
+        int promoteAfter { 5 };
+    };
+
+    // Runs on the prober thread whenever an endpoint is demoted or promoted.
+    using StateCallback
+        = std::function<void(const std::string& id, bool demoted)>;
+
+    explicit EndpointProber(Options options, StateCallback onChange = nullptr);
+    ~EndpointProber();
+
+    void addEndpoint(const std::string& id, const std::string& address,
+        std::shared_ptr<grpc::Channel> channel);
+    void removeEndpoint(const std::string& id);
+    bool isDemoted(const std::string& id) const;
+    json getStats() const;
+
+private:
+    struct Endpoint {
+        std::string id;
+        std::string address;
+        std::unique_ptr<geyser::Geyser::Stub> stub;
+        LatencyHistogram rttUs;
+        LatencyHistogram slotLag;
+        std::atomic<uint64_t> slot { 0 };
+        std::atomic<uint64_t> probes { 0 };
+        std::atomic<uint64_t> failures { 0 };
+        std::atomic<uint64_t> demotions { 0 };
+        std::atomic<uint64_t> promotions { 0 };
+        std::atomic<bool> demoted { false };
+        std::atomic<bool> removed { false };
+        // Round state, only touched by the prober thread.
+        bool pinged { false };
+        bool slotted { false };
+        uint64_t roundSlot { 0 };
+        int badRounds { 0 };
+        int goodRounds { 0 };
+    };
+
+    struct Probe {
+        enum class Kind { PING, SLOT };
+        Kind kind { Kind::PING };
+        std::shared_ptr<Endpoint> endpoint;
+        grpc::ClientContext context;
+        grpc::Status status;
+        geyser::PongResponse pong;
+        geyser::GetSlotResponse slot;
+        std::unique_ptr<grpc::ClientAsyncResponseReader<geyser::PongResponse>>
+            pingReader;
+        std::unique_ptr<
+            grpc::ClientAsyncResponseReader<geyser::GetSlotResponse>>
+            slotReader;
+        std::chrono::steady_clock::time_point sentAt;
+    };
+
+    void run();
+    void startRound();
+    void onProbe(Probe* probe);
+    void finishRound();
+    void armTick(std::chrono::steady_clock::time_point at);
+
+    Options options_;
+    StateCallback onChange_;
+    grpc::CompletionQueue cq_;
+    grpc::Alarm tick_;
+    std::thread thread_;
+
+    std::map<std::string, std::shared_ptr<Endpoint>> endpoints_;
+    // Probes of the current round; owned here so shutdown can cancel them.
+    std::vector<std::unique_ptr<Probe>> inFlight_;
+    std::vector<std::shared_ptr<Endpoint>> round_;
+    std::chrono::steady_clock::time_point roundStartedAt_;
+    bool stopping_ { false };
+    mutable std::mutex mutex_;
+
+    std::atomic<uint64_t> rounds_ { 0 };
+    std::atomic<uint64_t> bestSlot_ { 0 };
+};
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace solana {
+
+/**
+ * Qt-free stand-in for a signal. Handlers run synchronously on the thread
+ * that publishes, in subscription order; a GUI that needs them on its own
+ * thread has to post them there itself. Publishing works on a snapshot of
+ * the handler list, so handlers may subscribe or unsubscribe re-entrantly.
+ */
+template <typename... Args> class Event {
+public:
+    using Handler = std::function<void(Args...)>;
+    using Subscription = uint64_t;
+
+    Event() = default;
+    Event(const Event&) = delete;
+    Event& operator=(const Event&) = delete;
+
+    Subscription subscribe(Handler handler)
+    {
+        std::lock_guard lock(mutex_);
+        auto next = std::make_shared<HandlerList>(*handlers_);
+        Subscription id = ++lastId_;
+        next->emplace_back(id, std::move(handler));
+        handlers_ = std::move(next);
+        return id;
+    }
+
+    void unsubscribe(Subscription id)
+    {
+        std::lock_guard lock(mutex_);
+        auto next = std::make_shared<HandlerList>(*handlers_);
+        std::erase_if(
+            *next, [id](const auto& entry) { return entry.first == id; });
+        handlers_ = std::move(next);
+    }
+
+    void publish(Args... args) const
+    {
+        std::shared_ptr<const HandlerList> handlers;
+        {
+            std::lock_guard lock(mutex_);
+            handlers = handlers_;
+        }
+        for (const auto& [id, handler] : *handlers) {
+            handler(args...);
+        }
+    }
+
+    bool empty() const
+    {
+        std::lock_guard lock(mutex_);
+        return handlers_->empty();
+    }
+
+private:
+    using HandlerList = std::vector<std::pair<Subscription, Handler>>;
+
+    std::shared_ptr<const HandlerList> handlers_
+        = std::make_shared<const HandlerList>();
+    Subscription lastId_ { 0 };
+    mutable std::mutex mutex_;
+};
+}
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "FeedRace.hpp"
+
+#include <chrono>
+#include <stdexcept>
+
+namespace solana {
+
+FeedRace::FeedRace(size_t windowSlots, size_t slotCapacity)
+    : signatures_(windowSlots, slotCapacity)
+{
+}
+
+FeedRace::~FeedRace() = default;
+
+uint64_t FeedRace::nowMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint16_t FeedRace::registerEndpoint(const std::string& address)
+{
+    std::lock_guard lock(mutex_);
+    size_t count = endpointCount_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (endpoints_[i]->address == address)
+            return static_cast<uint16_t>(i);
+    }
+    if (count >= MAX_ENDPOINTS)
+        throw std::runtime_error("Too many redundant endpoints");
+
+    endpoints_[count] = std::make_unique<EndpointStats>();
+    endpoints_[count]->address = address;
+    endpointCount_.store(count + 1, std::memory_order_release);
+    return static_cast<uint16_t>(count);
+}
+
+bool FeedRace::admit(uint16_t endpoint, std::string_view signature,
+    uint64_t slot, uint64_t receivedUs)
+{
+    EndpointStats& self = *endpoints_[endpoint];
+    uint64_t newest = self.newestSlot.load(std::memory_order_relaxed);
+    while (slot > newest
+        && !self.newestSlot.compare_exchange_weak(
+            newest, slot, std::memory_order_relaxed)) { }
+
+    auto result = signatures_.insert(signature, slot, endpoint, receivedUs);
+    if (result.stale)
+        return admitStale(self, endpoint, slot);
+    if (result.first) {
+        self.wins.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Duplicates between shards of the same endpoint are not a lost race.
+    if (result.owner == endpoint
+        || result.owner >= endpointCount_.load(std::memory_order_acquire))
+        return false;
+    EndpointStats& owner = *endpoints_[result.owner];
+    if (receivedUs >= result.firstSeenUs) {
+        self.losses.fetch_add(1, std::memory_order_relaxed);
+        owner.leadUs.record(receivedUs - result.firstSeenUs);
+    } else {
+        // Read first but decoded later: the copy already delivered came
+        // from the slower feed, which is scored as the loser.
+        self.wins.fetch_add(1, std::memory_order_relaxed);
+        owner.wins.fetch_sub(1, std::memory_order_relaxed);
+        owner.losses.fetch_add(1, std::memory_order_relaxed);
+        self.leadUs.record(result.firstSeenUs - receivedUs);
+    }
+    return false;
+}
+
+bool FeedRace::admitStale(
+    EndpointStats& self, uint16_t endpoint, uint64_t slot)
+{
+    self.stale.fetch_add(1, std::memory_order_relaxed);
+    if (slot <= self.replayedSlot.load(std::memory_order_relaxed)) {
+        self.staleDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // Feeds deliver in slot order, so an endpoint a whole window ahead has
+    // already delivered this slot and the copy is a duplicate. Otherwise
+    // it may be the only one and goes through.
+    const uint64_t passed = slot + signatures_.getWindowSlots();
+    size_t count = endpointCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        if (i != endpoint
+            && endpoints_[i]->newestSlot.load(std::memory_order_relaxed)
+                >= passed) {
+            self.staleDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    return true;
+}
+
+void FeedRace::markReplay(uint16_t endpoint)
+{
+    EndpointStats& self = *endpoints_[endpoint];
+    uint64_t newest = self.newestSlot.load(std::memory_order_relaxed);
+    uint64_t replayed = self.replayedSlot.load(std::memory_order_relaxed);
+    while (newest > replayed
+        && !self.replayedSlot.compare_exchange_weak(
+            replayed, newest, std::memory_order_relaxed)) { }
+}
+
+json FeedRace::getStats() const
+{
+    json stats;
+    json endpoints = json::array();
+    size_t count = endpointCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& endpoint = *endpoints_[i];
+        uint64_t wins = endpoint.wins.load(std::memory_order_relaxed);
+        uint64_t losses = endpoint.losses.load(std::memory_order_relaxed);
+        json entry;
+        entry["address"] = endpoint.address;
+        entry["wins"] = wins;
+        entry["losses"] = losses;
+        entry["win_ratio"] = wins + losses
+            ? static_cast<double>(wins) / (wins + losses)
+            : 0.0;
+        entry["lead_us"] = endpoint.leadUs.toJson();
+        // Copies older than the dedup window, and those of them dropped.
+        entry["stale"] = endpoint.stale.load(std::memory_order_relaxed);
+        entry["stale_dropped"]
+            = endpoint.staleDropped.load(std::memory_order_relaxed);
+        endpoints.push_back(entry);
+    }
+    stats["endpoints"] = endpoints;
+    stats["overflows"] = signatures_.getOverflows();
+    stats["stale"] = signatures_.getStale();
+    return stats;
+}
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "LatencyHistogram.hpp"
+#include "SignatureSet.hpp"
+
+namespace solana {
+
+/**
+ * First-wins arbitration between redundant Geyser feeds. Every endpoint
+ * offers each signature it receives; only the first copy is admitted, and
+ * later copies record how far the winning endpoint was ahead.
+ *
+ * Copies are offered by the decoders, after batching and queueing, but
+ * carry the time the network thread read them. The race is scored on
+ * those times, so a copy that was read first wins even when another
+ * endpoint's decoder got to its copy sooner.
+ *
+ * Copies older than the dedup window cannot be checked. They are dropped
+ * when they replay what the endpoint saw before a reconnect, or once
+ * another endpoint is a whole window ahead, and let through otherwise.
+ */
+class FeedRace {
+public:
+    static constexpr size_t MAX_ENDPOINTS = 64;
+
+    FeedRace(size_t windowSlots, size_t slotCapacity);
+    ~FeedRace();
+
+    // The clock receivedUs is read from.
+    static uint64_t nowMicros();
+
+    uint16_t registerEndpoint(const std::string& address);
+    bool admit(uint16_t endpoint, std::string_view signature, uint64_t slot,
+        uint64_t receivedUs);
+
+    // For a copy read just now.
+    bool admit(uint16_t endpoint, std::string_view signature, uint64_t slot)
+    {
+        return admit(endpoint, signature, slot, nowMicros());
+    }
+
+    // Called before an endpoint reconnects with from_slot. Everything up
+    // to the newest slot it has seen so far was delivered already, so the
+    // replay is dropped even where it is older than the window.
+    void markReplay(uint16_t endpoint);
+    json getStats() const;
+
+private:
+    struct EndpointStats {
+        std::string address;
+        std::atomic<uint64_t> wins { 0 };
+        std::atomic<uint64_t> losses { 0 };
+        std::atomic<uint64_t> stale { 0 };
+        std::atomic<uint64_t> staleDropped { 0 };
+        std::atomic<uint64_t> newestSlot { 0 };
+        std::atomic<uint64_t> replayedSlot { 0 };
+        LatencyHistogram leadUs;
+    };
+
+    bool admitStale(EndpointStats& self, uint16_t endpoint, uint64_t slot);
+
+    SignatureSet signatures_;
+    std::array<std::unique_ptr<EndpointStats>, MAX_ENDPOINTS> endpoints_;
+    std::atomic<size_t> endpointCount_ { 0 };
+    mutable std::mutex mutex_;
+};
+}
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "FilterExecutor.hpp"
+
+#include <algorithm>
+
+namespace solana {
+
+FilterExecutor::FilterExecutor(size_t workers)
+{
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // Started only once every queue exists, since they steal from each
+    // other right away.
+    for (size_t i = 0; i < workers; ++i) {
+        workers_[i]->thread = std::jthread([this, i] { runWorker(i); });
+    }
+}
+
+FilterExecutor::~FilterExecutor()
+{
+    stopping_ = true;
+    bell_.fetch_add(1, std::memory_order_release);
+    bell_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+}
+
+void FilterExecutor::run(size_t count, size_t chunkSize, const RangeFn& fn)
+{
+    if (count == 0)
+        return;
+    chunkSize = std::max<size_t>(chunkSize, 1);
+    ++runs_;
+    if (workers_.empty() || count <= chunkSize) {
+        ++inlineRuns_;
+        fn(0, count);
+        callers_.chunks.fetch_add(1, std::memory_order_relaxed);
+        callers_.items.fetch_add(count, std::memory_order_relaxed);
+        return;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->fn = &fn;
+    job->pending.store(
+        (count + chunkSize - 1) / chunkSize, std::memory_order_relaxed);
+    size_t queue = nextQueue_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t begin = 0; begin < count; begin += chunkSize) {
+        auto& worker = *workers_[queue++ % workers_.size()];
+        std::lock_guard lock(worker.mutex);
+        worker.tasks.push_back(
+            Task { job, begin, std::min(begin + chunkSize, count) });
+    }
+    bell_.fetch_add(1, std::memory_order_release);
+    bell_.notify_all();
+
+    // Help with whatever is queued, ours or another run's, until the last
+    // of our chunks is done.
+    while (true) {
+        size_t pending = job->pending.load(std::memory_order_acquire);
+        if (pending == 0)
+            break;
+        Task task;
+        if (trySteal(workers_.size(), task))
+            execute(task, callers_);
+        else
+            job->pending.wait(pending, std::memory_order_acquire);
+    }
+    if (job->error)
+        std::rethrow_exception(job->error);
+}
+
+void FilterExecutor::runWorker(size_t index)
+{
+    auto& self = *workers_[index];
+    while (true) {
+        uint32_t seen = bell_.load(std::memory_order_acquire);
+        Task task;
+        if (tryPop(self, task)) {
+            execute(task, self.counters);
+            continue;
+        }
+        if (trySteal(index, task)) {
+            self.counters.steals.fetch_add(1, std::memory_order_relaxed);
+            execute(task, self.counters);
+            continue;
+        }
+        if (stopping_)
+            break;
+        bell_.wait(seen, std::memory_order_acquire);
+    }
+}
+
+bool FilterExecutor::tryPop(Worker& worker, Task& task)
+{
+    std::lock_guard lock(worker.mutex);
+    if (worker.tasks.empty())
+        return false;
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool FilterExecutor::trySteal(size_t skip, Task& task)
+{
+    const size_t count = workers_.size();
+    for (size_t i = 1; i <= count; ++i) {
+        size_t victim = (skip + i) % count;
+        if (victim == skip)
+            continue;
+        auto& worker = *workers_[victim];
+        std::lock_guard lock(worker.mutex);
+        if (worker.tasks.empty())
+            continue;
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void FilterExecutor::execute(Task& task, Counters& counters)
+{
+    auto& job = *task.job;
+    try {
+        (*job.fn)(task.begin, task.end);
+    } catch (...) {
+        std::lock_guard lock(job.errorMutex);
+        if (!job.error)
+            job.error = std::current_exception();
+    }
+    counters.chunks.fetch_add(1, std::memory_order_relaxed);
+    counters.items.fetch_add(task.end - task.begin, std::memory_order_relaxed);
+    if (job.pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        job.pending.notify_all();
+}
+
+json FilterExecutor::getStats() const
+{
+    auto toJson = [](const Counters& counters) {
+        return json { { "chunks", counters.chunks.load() },
+            { "items", counters.items.load() },
+            { "steals", counters.steals.load() } };
+    };
+    json workers = json::array();
+    for (const auto& worker : workers_) {
+        workers.push_back(toJson(worker->counters));
+    }
+    return { { "workers", workers }, { "callers", toJson(callers_) },
+        { "runs", runs_.load() }, { "inline_runs", inlineRuns_.load() } };
+}
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace solana {
+
+/**
+ * Fixed pool of threads that FilterManager spreads batches over. A run is
+ * cut into chunks that are dealt round-robin onto per-worker queues; a
+ * worker takes from the back of its own queue and, once that is empty,
+ * steals from the front of the others. The calling thread steals too
+ * while it waits, so a pool of N workers runs a batch on N + 1 threads and
+ * one of 0 workers runs it inline. Queue locks are per worker and taken
+ * once per chunk; the counters are per worker and summed by getStats().
+ */
+class FilterExecutor {
+public:
+    using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+    explicit FilterExecutor(size_t workers);
+    ~FilterExecutor();
+
+    FilterExecutor(const FilterExecutor&) = delete;
+    FilterExecutor& operator=(const FilterExecutor&) = delete;
+
+    // Calls fn on consecutive ranges of at most chunkSize covering
+    // [0, count) and returns once all of them are done, rethrowing the
+    // first exception one of them threw. Several threads may run at once.
+    void run(size_t count, size_t chunkSize, const RangeFn& fn);
+
+    size_t getWorkerCount() const
+    {
+        return workers_.size();
+    }
+
+    json getStats() const;
+
+private:
+    struct Job {
+        const RangeFn* fn { nullptr };
+        std::atomic<size_t> pending { 0 };
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    struct Task {
+        // Shared so a worker can still signal the job after the caller
+        // saw its last chunk finish and returned.
+        std::shared_ptr<Job> job;
+        size_t begin { 0 };
+        size_t end { 0 };
+    };
+
+    struct Counters {
+        std::atomic<uint64_t> chunks { 0 };
+        std::atomic<uint64_t> items { 0 };
+        std::atomic<uint64_t> steals { 0 };
+    };
+
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        Counters counters;
+        std::jthread thread;
+    };
+
+    void runWorker(size_t index);
+    bool tryPop(Worker& worker, Task& task);
+    // Takes the oldest task from any queue other than skip's.
+    bool trySteal(size_t skip, Task& task);
+    void execute(Task& task, Counters& counters);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<uint32_t> bell_ { 0 };
+    std::atomic<bool> stopping_ { false };
+    std::atomic<size_t> nextQueue_ { 0 };
+    std::atomic<uint64_t> runs_ { 0 };
+    std::atomic<uint64_t> inlineRuns_ { 0 };
+    Counters callers_;
+};
+}
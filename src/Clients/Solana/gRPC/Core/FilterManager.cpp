@@ -18,13 +18,23 @@
 
 #include "FilterManager.hpp"
 
+#include <algorithm>
+#include <thread>
+
 #include "../Utils/Logger.hpp"
 
 namespace solana {
 
-FilterManager::FilterManager(QObject* parent)
-    : QObject(parent)
-    , maxThreads_(std::thread::hardware_concurrency() / 2)
+namespace {
+    // Chunks per participating thread: enough for stealing to even out
+    // entries of uneven cost without paying a queue lock per entry.
+    constexpr size_t CHUNKS_PER_THREAD = 4;
+    constexpr size_t MIN_CHUNK_ENTRIES = 4;
+}
+
+FilterManager::FilterManager()
+    : maxThreads_(std::max(
+          1, static_cast<int>(std::thread::hardware_concurrency() / 2)))
 {
 }
 
@@ -33,35 +43,53 @@ FilterManager::~FilterManager() = default;
 void FilterManager::addFilter(
     const std::string& name, std::shared_ptr<TransactionFilter> filter)
 {
-    std::lock_guard lock(mutex_);
-    filters_[name] = std::move(filter);
-    filterHits_[name] = 0;
+    {
+        std::lock_guard lock(mutex_);
+        if (accounts_)
+            filter->setAccountCache(accounts_);
+        filters_[name] = FilterEntry {
+            name, std::move(filter), std::make_shared<HitCounter>()
+        };
+    }
     Logger::getLogger()->info("Filter added: {}", name);
-    Q_EMIT filterAdded(QString::fromStdString(name));
+    // Published unlocked: workers call back into compileSubscription().
+    filterAdded.publish(name);
 }
 
-void FilterManager::removeFilter(const std::string& name)
+void FilterManager::setAccountCache(
+    std::shared_ptr<const AccountCache> accounts)
 {
     std::lock_guard lock(mutex_);
-    filters_.erase(name);
-    filterHits_.erase(name);
+    accounts_ = std::move(accounts);
+    for (auto& [name, entry] : filters_) {
+        entry.filter->setAccountCache(accounts_);
+    }
+}
+
+void FilterManager::removeFilter(const std::string& name)
+{
+    {
+        std::lock_guard lock(mutex_);
+        filters_.erase(name);
+    }
     Logger::getLogger()->info("Filter removed: {}", name);
-    Q_EMIT filterRemoved(QString::fromStdString(name));
+    filterRemoved.publish(name);
 }
 
 void FilterManager::updateFilterConfig(
     const std::string& name, const std::string& config)
 {
-    std::lock_guard lock(mutex_);
-    if (auto it = filters_.find(name); it != filters_.end()) {
-        try {
-            it->second->updateConfig(config);
-            Logger::getLogger()->info("Filter config updated: {}", name);
-            Q_EMIT filterUpdated(QString::fromStdString(name));
-        } catch (const std::exception& e) {
-            Logger::getLogger()->error(
-                "Error updating filter {}: {}", name, e.what());
-        }
+    std::shared_ptr<TransactionFilter> filter = getFilter(name);
+    if (!filter)
+        return;
+
+    try {
+        filter->updateConfig(config);
+        Logger::getLogger()->info("Filter config updated: {}", name);
+        filterUpdated.publish(name);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error(
+            "Error updating filter {}: {}", name, e.what());
     }
 }
 
@@ -69,7 +97,8 @@ std::shared_ptr<TransactionFilter> FilterManager::getFilter(
     const std::string& name) const
 {
     std::lock_guard lock(mutex_);
-    return filters_.count(name) ? filters_.at(name) : nullptr;
+    auto it = filters_.find(name);
+    return it != filters_.end() ? it->second.filter : nullptr;
 }
 
 std::vector<std::string> FilterManager::getFilterNames() const
@@ -83,69 +112,172 @@ std::vector<std::string> FilterManager::getFilterNames() const
     return names;
 }
 
+FilterManager::FilterList FilterManager::snapshotFilters() const
+{
+    std::lock_guard lock(mutex_);
+    FilterList filters;
+    filters.reserve(filters_.size());
+    for (const auto& [name, entry] : filters_) {
+        filters.push_back(entry);
+    }
+    return filters;
+}
+
+std::shared_ptr<FilterExecutor> FilterManager::snapshotExecutor()
+{
+    std::lock_guard lock(mutex_);
+    if (!executor_)
+        executor_ = std::make_shared<FilterExecutor>(maxThreads_ - 1);
+    return executor_;
+}
+
+template <typename Apply>
+size_t FilterManager::runFilters(const FilterList& filters, const Apply& apply)
+{
+    // Filters of one entry run back to back on the thread that owns the
+    // entry; the parallelism comes from spreading entries over the pool.
+    size_t hits = 0;
+    for (const auto& entry : filters) {
+        try {
+            apply(*entry.filter);
+            entry.hits->add(1);
+            ++hits;
+        } catch (const std::exception& e) {
+            Logger::getLogger()->error(
+                "Error in filter {}: {}", entry.name, e.what());
+        }
+    }
+    return hits;
+}
+
 size_t FilterManager::processTransaction(
     const std::string& sourceId, const geyser::SubscribeUpdateTransaction& tx)
 {
-    std::lock_guard lock(mutex_);
-    std::vector<std::future<bool>> futures;
-    futures.reserve(filters_.size());
-    for (const auto& [name, filter] : filters_) {
-        futures.push_back(std::async(
-            std::launch::async, [this, &sourceId, &tx, filter, name]() {
-                try {
-                    filter->processTransaction(sourceId, tx);
-                    std::lock_guard lock(mutex_);
-                    filterHits_[name]++;
-                    return true;
-                } catch (const std::exception& e) {
-                    Logger::getLogger()->error(
-                        "Error in filter {}: {}", name, e.what());
-                    return false;
-                }
-            }));
+    return runFilters(snapshotFilters(), [&sourceId, &tx](auto& filter) {
+        filter.processTransaction(sourceId, tx);
+    });
+}
+
+size_t FilterManager::processEntry(const std::string& sourceId,
+    const TransactionBatch::Entry& entry, const FilterList& filters,
+    bool scan)
+{
+    // One view per thread, scanned and resolved once per entry for all
+    // filters; its lists keep their capacity between entries.
+    thread_local TransactionView view;
+    if (scan && !(view.scan(entry.wire) && view.resolve())) {
+        Logger::getLogger()->warn(
+            "Failed to scan Geyser frame of {} bytes", entry.wire.size());
+        scan = false;
     }
-    return std::count_if(
-        futures.begin(), futures.end(), [](auto& f) { return f.get(); });
+
+    return runFilters(filters, [&](auto& filter) {
+        if (!filter.needsFullTransaction()) {
+            if (scan)
+                filter.processView(sourceId, view);
+        } else if (entry.transaction) {
+            filter.processTransaction(sourceId, *entry.transaction);
+        }
+    });
 }
 
-size_t FilterManager::processBatch(const std::string& sourceId,
-    const std::vector<geyser::SubscribeUpdateTransaction>& transactions)
+size_t FilterManager::processBatch(
+    const std::string& sourceId, TransactionBatch& batch)
 {
-    if (transactions.empty())
+    auto filters = snapshotFilters();
+    if (batch.empty() || filters.empty())
         return 0;
 
-    std::vector<std::future<size_t>> futures;
-    futures.reserve(transactions.size());
-    for (const auto& tx : transactions) {
-        futures.push_back(
-            std::async(std::launch::async, [this, &sourceId, &tx]() {
-                return processTransaction(sourceId, tx);
-            }));
+    // Fall back to the full parse only when some filter asks for it.
+    bool scan = false;
+    for (const auto& entry : filters) {
+        if (entry.filter->needsFullTransaction())
+            batch.parseTransactions();
+        else
+            scan = true;
     }
 
-    size_t totalHits = 0;
-    for (auto& future : futures) {
-        totalHits += future.get();
-    }
+    auto executor = snapshotExecutor();
+    const auto& entries = batch.entries();
+    size_t threads = executor->getWorkerCount() + 1;
+    size_t chunkSize = std::max(MIN_CHUNK_ENTRIES,
+        (entries.size() + threads * CHUNKS_PER_THREAD - 1)
+            / (threads * CHUNKS_PER_THREAD));
+
+    std::atomic<size_t> totalHits { 0 };
+    executor->run(entries.size(), chunkSize, [&](size_t begin, size_t end) {
+        size_t hits = 0;
+        for (size_t i = begin; i < end; ++i) {
+            hits += processEntry(sourceId, entries[i], filters, scan);
+        }
+        totalHits.fetch_add(hits, std::memory_order_relaxed);
+    });
 
-    return totalHits;
+    return totalHits.load(std::memory_order_relaxed);
 }
 
 void FilterManager::setMaxConcurrentFilters(int maxThreads)
 {
-    maxThreads_ = std::max(1,
+    int threads = std::max(1,
         std::min(
             maxThreads, static_cast<int>(std::thread::hardware_concurrency())));
-    Logger::getLogger()->info("Max concurrent filters set to {}", maxThreads_);
+    std::shared_ptr<FilterExecutor> previous;
+    {
+        std::lock_guard lock(mutex_);
+        if (threads == maxThreads_)
+            return;
+        maxThreads_ = threads;
+        previous = std::move(executor_);
+    }
+    // The old pool is joined once the last run holding it returns.
+    Logger::getLogger()->info("Max concurrent filters set to {}", threads);
+}
+
+std::map<std::string, geyser::SubscribeRequestFilterTransactions>
+FilterManager::compileSubscription() const
+{
+    std::map<std::string, geyser::SubscribeRequestFilterTransactions> result;
+    std::lock_guard lock(mutex_);
+    for (const auto& [name, entry] : filters_) {
+        auto subscription = entry.filter->subscription();
+        if (!subscription)
+            return {};
+        // A filter with nothing to watch cannot match anything, and an
+        // empty Geyser filter would mean the opposite.
+        if (subscription->empty())
+            continue;
+
+        geyser::SubscribeRequestFilterTransactions txFilter;
+        txFilter.set_vote(false);
+        txFilter.set_failed(false);
+        for (const auto& account : subscription->accountInclude) {
+            txFilter.add_account_include(account);
+        }
+        for (const auto& account : subscription->accountRequired) {
+            txFilter.add_account_required(account);
+        }
+        result.emplace(name, std::move(txFilter));
+    }
+    return result;
 }
 
 json FilterManager::getFilterStats() const
 {
     json stats;
     std::lock_guard lock(mutex_);
-    for (const auto& [name, hits] : filterHits_) {
-        stats[name] = hits;
+    for (const auto& [name, entry] : filters_) {
+        stats[name] = entry.hits->load();
     }
     return stats;
 }
+
+json FilterManager::getExecutorStats() const
+{
+    std::lock_guard lock(mutex_);
+    if (!executor_)
+        return json::object();
+    json stats = executor_->getStats();
+    stats["max_threads"] = maxThreads_;
+    return stats;
+}
 }
@@ -18,27 +18,27 @@
 
 #pragma once
 
-#include <future>
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
 
-#include <QObject>
-
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
+#include "EventBus.hpp"
+#include "FilterExecutor.hpp"
+#include "TransactionBatch.hpp"
 #include "TransactionFilter.hpp"
 
 namespace solana {
 
-class FilterManager : public QObject {
-    Q_OBJECT
-
+class FilterManager {
 public:
-    explicit FilterManager(QObject* parent = nullptr);
+    FilterManager();
     ~FilterManager();
 
     void addFilter(
@@ -47,21 +47,84 @@ public:
     void updateFilterConfig(const std::string& name, const std::string& config);
     std::shared_ptr<TransactionFilter> getFilter(const std::string& name) const;
     std::vector<std::string> getFilterNames() const;
+    // Handed to every filter, those added later included.
+    void setAccountCache(std::shared_ptr<const AccountCache> accounts);
     size_t processTransaction(const std::string& sourceId,
         const geyser::SubscribeUpdateTransaction& tx);
-    size_t processBatch(const std::string& sourceId,
-        const std::vector<geyser::SubscribeUpdateTransaction>& transactions);
+    size_t processBatch(const std::string& sourceId, TransactionBatch& batch);
+    // Total threads a batch is spread over, the caller included.
     void setMaxConcurrentFilters(int maxThreads);
     json getFilterStats() const;
+    json getExecutorStats() const;
+
+    // Geyser transaction filters that together cover every registered
+    // filter, keyed by filter name. Empty when they cannot narrow the feed,
+    // e.g. because one of them has to see every transaction.
+    std::map<std::string, geyser::SubscribeRequestFilterTransactions>
+    compileSubscription() const;
 
-Q_SIGNALS:
-    void filterAdded(const QString& name);
-    void filterRemoved(const QString& name);
-    void filterUpdated(const QString& name);
+    Event<const std::string&> filterAdded;
+    Event<const std::string&> filterRemoved;
+    Event<const std::string&> filterUpdated;
 
 private:
-    std::map<std::string, std::shared_ptr<TransactionFilter>> filters_;
-    std::map<std::string, uint64_t> filterHits_;
+    // Hit count spread over cache-line sized slots, one picked per thread,
+    // so executor threads do not bounce a shared line; read by summing.
+    class HitCounter {
+    public:
+        void add(uint64_t hits)
+        {
+            slots_[threadSlot()].value.fetch_add(
+                hits, std::memory_order_relaxed);
+        }
+
+        uint64_t load() const
+        {
+            uint64_t total = 0;
+            for (const auto& slot : slots_) {
+                total += slot.value.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+    private:
+        static constexpr size_t SLOTS = 16;
+
+        struct alignas(64) Slot {
+            std::atomic<uint64_t> value { 0 };
+        };
+
+        static size_t threadSlot()
+        {
+            static std::atomic<size_t> next { 0 };
+            thread_local size_t slot
+                = next.fetch_add(1, std::memory_order_relaxed) % SLOTS;
+            return slot;
+        }
+
+        std::array<Slot, SLOTS> slots_ {};
+    };
+
+    struct FilterEntry {
+        std::string name;
+        std::shared_ptr<TransactionFilter> filter;
+        std::shared_ptr<HitCounter> hits;
+    };
+    using FilterList = std::vector<FilterEntry>;
+
+    FilterList snapshotFilters() const;
+    std::shared_ptr<FilterExecutor> snapshotExecutor();
+    template <typename Apply>
+    size_t runFilters(const FilterList& filters, const Apply& apply);
+    size_t processEntry(const std::string& sourceId,
+        const TransactionBatch::Entry& entry, const FilterList& filters,
+        bool scan);
+
+    std::map<std::string, FilterEntry> filters_;
+    // Created on first use and replaced when maxThreads_ changes; runs in
+    // flight keep the one they started on alive.
+    std::shared_ptr<FilterExecutor> executor_;
+    std::shared_ptr<const AccountCache> accounts_;
     mutable std::mutex mutex_;
     int maxThreads_;
 };
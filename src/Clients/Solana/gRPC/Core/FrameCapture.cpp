@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "FrameCapture.hpp"
+
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+#include "../Utils/Logger.hpp"
+
+namespace solana {
+
+namespace {
+    template <typename T>
+    T readLittleEndian(const char* data)
+    {
+        T value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            value |= static_cast<T>(static_cast<uint8_t>(data[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    template <typename T>
+    void writeLittleEndian(std::ofstream& out, T value)
+    {
+        char bytes[sizeof(T)];
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            bytes[i] = static_cast<char>(value >> (8 * i));
+        }
+        out.write(bytes, sizeof(bytes));
+    }
+}
+
+FrameCapture::FrameCapture(const std::string& path)
+{
+    bool fresh = !std::filesystem::exists(path)
+        || std::filesystem::file_size(path) == 0;
+    out_.open(path, std::ios::binary | std::ios::app);
+    if (!out_.is_open())
+        throw std::runtime_error("Cannot open capture file: " + path);
+    if (fresh)
+        out_.write(capture::MAGIC.data(), capture::MAGIC.size());
+    Logger::getLogger()->info("Capturing Geyser frames to {}", path);
+}
+
+FrameCapture::~FrameCapture()
+{
+    std::lock_guard lock(mutex_);
+    out_.flush();
+}
+
+void FrameCapture::write(const grpc::ByteBuffer& frame, uint64_t receivedAtNs)
+{
+    std::vector<grpc::Slice> slices;
+    if (!frame.Dump(&slices).ok())
+        return;
+
+    std::lock_guard lock(mutex_);
+    writeLittleEndian(out_, static_cast<uint32_t>(frame.Length()));
+    writeLittleEndian(out_, receivedAtNs);
+    for (const auto& slice : slices) {
+        out_.write(reinterpret_cast<const char*>(slice.begin()),
+            static_cast<std::streamsize>(slice.size()));
+    }
+    ++framesWritten_;
+    bytesWritten_ += capture::RECORD_HEADER_SIZE + frame.Length();
+}
+
+uint64_t FrameCapture::getFramesWritten() const
+{
+    std::lock_guard lock(mutex_);
+    return framesWritten_;
+}
+
+uint64_t FrameCapture::getBytesWritten() const
+{
+    std::lock_guard lock(mutex_);
+    return bytesWritten_;
+}
+
+FrameReader::FrameReader(const std::string& path)
+{
+    if (!std::filesystem::exists(path)
+        || std::filesystem::file_size(path) < capture::MAGIC.size())
+        throw std::runtime_error("Not a capture file: " + path);
+
+    file_ = boost::interprocess::file_mapping(
+        path.c_str(), boost::interprocess::read_only);
+    region_ = boost::interprocess::mapped_region(
+        file_, boost::interprocess::read_only);
+    data_ = static_cast<const char*>(region_.get_address());
+    size_ = region_.get_size();
+    if (std::string_view(data_, capture::MAGIC.size()) != capture::MAGIC)
+        throw std::runtime_error("Not a capture file: " + path);
+    region_.advise(boost::interprocess::mapped_region::advice_sequential);
+    rewind();
+}
+
+bool FrameReader::next(Frame& frame)
+{
+    if (size_ - offset_ < capture::RECORD_HEADER_SIZE)
+        return false;
+
+    auto length = readLittleEndian<uint32_t>(data_ + offset_);
+    // A capture cut off mid-record (e.g. by a crash) just ends early.
+    if (size_ - offset_ - capture::RECORD_HEADER_SIZE < length)
+        return false;
+
+    frame.receivedAtNs
+        = readLittleEndian<uint64_t>(data_ + offset_ + sizeof(uint32_t));
+    frame.bytes = std::string_view(
+        data_ + offset_ + capture::RECORD_HEADER_SIZE, length);
+    offset_ += capture::RECORD_HEADER_SIZE + length;
+    return true;
+}
+
+void FrameReader::rewind()
+{
+    offset_ = capture::MAGIC.size();
+}
+
+size_t FrameReader::getOffset() const
+{
+    return offset_;
+}
+
+size_t FrameReader::getSize() const
+{
+    return size_;
+}
+}
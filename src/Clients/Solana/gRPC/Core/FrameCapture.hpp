@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <grpcpp/support/byte_buffer.h>
+
+namespace solana {
+
+// Capture files hold raw SubscribeUpdate frames as they came off the wire:
+//
+//   "GEYCAP01" { u32 length, u64 received_at_ns, length bytes }*
+//
+// Integers are little-endian and received_at_ns is system_clock time.
+namespace capture {
+    inline constexpr std::string_view MAGIC = "GEYCAP01";
+    inline constexpr size_t RECORD_HEADER_SIZE
+        = sizeof(uint32_t) + sizeof(uint64_t);
+}
+
+class FrameCapture {
+public:
+    explicit FrameCapture(const std::string& path);
+    ~FrameCapture();
+
+    void write(const grpc::ByteBuffer& frame, uint64_t receivedAtNs);
+    uint64_t getFramesWritten() const;
+    uint64_t getBytesWritten() const;
+
+private:
+    std::ofstream out_;
+    uint64_t framesWritten_ { 0 };
+    uint64_t bytesWritten_ { 0 };
+    mutable std::mutex mutex_;
+};
+
+class FrameReader {
+public:
+    struct Frame {
+        uint64_t receivedAtNs { 0 };
+        std::string_view bytes;
+    };
+
+    // Throws std::runtime_error if the file is missing or not a capture.
+    explicit FrameReader(const std::string& path);
+
+    // Views stay valid for the lifetime of the reader.
+    bool next(Frame& frame);
+    void rewind();
+    size_t getOffset() const;
+    size_t getSize() const;
+
+private:
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    const char* data_ { nullptr };
+    size_t size_ { 0 };
+    size_t offset_ { 0 };
+};
+}
@@ -0,0 +1,696 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "GeyserClientWorker.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "../Utils/Logger.hpp"
+
+namespace solana {
+
+GeyserClientWorker::GeyserClientWorker(const std::string& sourceId,
+    const ConfigManager::DataSourceConfig& source, StorageManager& storage,
+    NotificationManager& notifier, FilterManager& filter,
+    std::shared_ptr<FeedRace> race, std::shared_ptr<AccountCache> accounts,
+    std::shared_ptr<TxRingPublisher> ring)
+    : DataSourceWorker(source)
+    , sourceId_(sourceId)
+    , storage_(storage)
+    , notification_(notifier)
+    , filter_(filter)
+{
+    partitionAccounts();
+
+    filterSubscription_ = filter_.compileSubscription();
+    auto refresh = [this](const std::string&) { refreshSubscription(); };
+    filterSubscriptions_ = { filter_.filterAdded.subscribe(refresh),
+        filter_.filterRemoved.subscribe(refresh),
+        filter_.filterUpdated.subscribe(refresh) };
+
+    std::string checkpointKey = "checkpoint:" + source_.address;
+    persistedCheckpoint_ = storage_.loadCheckpoint(checkpointKey);
+    if (persistedCheckpoint_) {
+        Logger::getLogger()->info("Resuming {} from checkpoint slot {}",
+            source_.address, *persistedCheckpoint_);
+    }
+
+    if (!source_.capturePath.empty()) {
+        try {
+            capture_ = std::make_unique<FrameCapture>(source_.capturePath);
+        } catch (const std::exception& e) {
+            Logger::getLogger()->error("Frame capture disabled: {}", e.what());
+        }
+    }
+
+    IngestPipeline::Options options;
+    options.lanes = shards_.size();
+    options.queueCapacity = static_cast<size_t>(source_.queueCapacity);
+    options.overflowPolicy
+        = IngestPipeline::parseOverflowPolicy(source_.overflowPolicy);
+    options.sampleRate = static_cast<uint32_t>(source_.overflowSampleRate);
+    if (source_.reorder) {
+        options.reorder = SlotReorderBuffer::Options {
+            static_cast<size_t>(source_.reorderWindowSlots),
+            std::chrono::milliseconds(source_.reorderTimeoutMs) };
+    }
+    pipeline_ = std::make_unique<IngestPipeline>(sourceId_, source_.address,
+        options, std::move(race), std::move(accounts), std::move(ring),
+        filter_, storage_, notification_, checkpointKey,
+        persistedCheckpoint_.value_or(0));
+    pipeline_->batchProcessed.subscribe([this](const nlohmann::json& data) {
+        dataReceived.publish(sourceId_, data);
+    });
+    pipeline_->slotClosed.subscribe([this](const nlohmann::json& data) {
+        slotClosed.publish(sourceId_, data);
+    });
+    pipeline_->error.subscribe(
+        [this](const std::string& message) { error.publish(message); });
+    start();
+}
+
+GeyserClientWorker::~GeyserClientWorker()
+{
+    filter_.filterAdded.unsubscribe(filterSubscriptions_[0]);
+    filter_.filterRemoved.unsubscribe(filterSubscriptions_[1]);
+    filter_.filterUpdated.unsubscribe(filterSubscriptions_[2]);
+    stop();
+}
+
+bool GeyserClientWorker::isConnected() const
+{
+    return std::any_of(shards_.begin(), shards_.end(),
+        [](const auto& shard) { return shard->connected.load(); });
+}
+
+uint64_t GeyserClientWorker::getTotalTransactions() const
+{
+    return pipeline_->getTotalTransactions();
+}
+
+uint64_t GeyserClientWorker::getProcessedBatches() const
+{
+    return pipeline_->getProcessedBatches();
+}
+
+uint64_t GeyserClientWorker::getDuplicateTransactions() const
+{
+    return pipeline_->getDuplicateTransactions();
+}
+
+uint64_t GeyserClientWorker::getReconnects() const
+{
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->reconnects;
+    }
+    return total;
+}
+
+uint64_t GeyserClientWorker::getCheckpointSlot() const
+{
+    return pipeline_->getCheckpointSlot();
+}
+
+double GeyserClientWorker::getBytesCopiedPerTransaction() const
+{
+    return pipeline_->getBytesCopiedPerTransaction();
+}
+
+json GeyserClientWorker::getPipelineStats() const
+{
+    return pipeline_->getStats();
+}
+
+const IngestTracer& GeyserClientWorker::getTracer() const
+{
+    return pipeline_->getTracer();
+}
+
+json GeyserClientWorker::getShardStats() const
+{
+    json stats = json::array();
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& shard : shards_) {
+        double elapsed
+            = std::chrono::duration<double>(now - shard->startedAt).count();
+        uint64_t transactions = pipeline_->getTransactions(shard->index);
+        json shardStats;
+        shardStats["index"] = shard->index;
+        shardStats["connected"] = shard->connected.load();
+        shardStats["accounts"] = shard->accounts.size();
+        shardStats["frames"] = shard->received.load();
+        shardStats["transactions"] = transactions;
+        shardStats["batches"] = shard->batches.load();
+        shardStats["shed_batches"] = shard->shed.load();
+        shardStats["reconnects"] = shard->reconnects.load();
+        shardStats["processed_slot"]
+            = pipeline_->getProcessedSlot(shard->index);
+        shardStats["batch_size"] = shard->batchTarget.load();
+        shardStats["flushes"] = { { "size", shard->sizeFlushes.load() },
+            { "deadline", shard->deadlineFlushes.load() } };
+        shardStats["tx_per_sec"] = elapsed > 0.0 ? transactions / elapsed : 0.0;
+        stats.push_back(shardStats);
+    }
+    return stats;
+}
+
+std::shared_ptr<grpc::Channel> GeyserClientWorker::getChannel() const
+{
+    return shards_.front()->channel;
+}
+
+void GeyserClientWorker::setStandby(bool standby)
+{
+    if (standby_.exchange(standby) == standby)
+        return;
+    Logger::getLogger()->info(
+        "{} {} standby", source_.address, standby ? "entering" : "leaving");
+
+    // Cancelled streams park in finishCall; cancelling a parked alarm starts
+    // the stream again through resumeCall.
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard->callsMutex);
+        for (auto& call : shard->activeCalls) {
+            if (standby && call->state != AsyncCall::State::BACKOFF)
+                call->context.TryCancel();
+            else if (!standby && call->state == AsyncCall::State::BACKOFF)
+                call->alarm.Cancel();
+        }
+    }
+}
+
+bool GeyserClientWorker::isStandby() const
+{
+    return standby_;
+}
+
+void GeyserClientWorker::partitionAccounts()
+{
+    // The configured count is kept even with few configured accounts:
+    // filter accounts, which come and go at runtime, are split across
+    // the same shards.
+    size_t shardCount = static_cast<size_t>(std::max(1, source_.shards));
+    std::vector<std::string> accounts = source_.accountInclude;
+    std::sort(accounts.begin(), accounts.end());
+    accounts.erase(
+        std::unique(accounts.begin(), accounts.end()), accounts.end());
+
+    for (size_t i = 0; i < shardCount; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->index = i;
+        shard->batchTarget = static_cast<size_t>(source_.batchMinSize);
+        shard->frames = std::make_unique<IngestPipeline::FrameBatch>();
+        shards_.push_back(std::move(shard));
+    }
+
+    for (size_t i = 0; i < accounts.size(); ++i) {
+        shards_[i % shardCount]->accounts.push_back(accounts[i]);
+    }
+}
+
+void GeyserClientWorker::start()
+{
+    for (auto& shard : shards_) {
+        shard->cq = std::make_unique<grpc::CompletionQueue>();
+        shard->channel = grpc::CreateCustomChannel(source_.address,
+            grpc::SslCredentials({}), createChannelArguments());
+        shard->stub = std::make_unique<grpc::GenericStub>(shard->channel);
+        shard->startedAt = std::chrono::steady_clock::now();
+        shard->thread = std::jthread(
+            [this, s = shard.get()](
+                std::stop_token stoken) { runShard(*s, std::move(stoken)); });
+    }
+
+    Logger::getLogger()->info("Started {} with {} shard(s)", source_.address,
+        shards_.size());
+}
+
+void GeyserClientWorker::stop()
+{
+    for (auto& shard : shards_) {
+        shard->thread.request_stop();
+        shard->flushTimer.alarm.Cancel();
+        {
+            std::lock_guard lock(shard->callsMutex);
+            if (shard->resubscriber.wakePending)
+                shard->resubscriber.wakeup.Cancel();
+            for (auto& call : shard->activeCalls) {
+                if (call->state == AsyncCall::State::BACKOFF)
+                    call->alarm.Cancel();
+                else
+                    call->context.TryCancel();
+            }
+        }
+        shard->cq->Shutdown();
+    }
+
+    // A shard blocked on a full pipeline only wakes up once it is closed.
+    pipeline_->close();
+    for (auto& shard : shards_) {
+        if (shard->thread.joinable())
+            shard->thread.join();
+    }
+}
+
+grpc::ChannelArguments GeyserClientWorker::createChannelArguments() const
+{
+    grpc::ChannelArguments args;
+    args.SetInt(GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH, 64 * 1024 * 1024);
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, 30000);
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, 10000);
+    args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+    args.SetInt(GRPC_ARG_ENABLE_RETRIES, 1);
+    // Give every shard its own HTTP/2 connection instead of multiplexing
+    // all streams over one shared subchannel.
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    return args;
+}
+
+geyser::SubscribeRequest GeyserClientWorker::buildSubscribeRequest(
+    const Shard& shard, std::optional<uint64_t> fromSlot) const
+{
+    geyser::SubscribeRequest req;
+    req.set_commitment(geyser::CommitmentLevel::PROCESSED);
+    if (fromSlot)
+        req.set_from_slot(*fromSlot);
+    auto& transactions = *req.mutable_transactions();
+
+    // Filter accounts are split across shards like the configured ones.
+    // Entries without any go to the first shard only, the others would
+    // just deliver the same transactions again. Required and excluded
+    // accounts stay whole on every shard that gets a part.
+    {
+        std::lock_guard lock(subscriptionMutex_);
+        for (const auto& [name, entry] : filterSubscription_) {
+            if (entry.account_include().empty()) {
+                if (shard.index == 0)
+                    transactions[name] = entry;
+                continue;
+            }
+            auto part = entry;
+            part.clear_account_include();
+            for (int i = 0; i < entry.account_include_size(); ++i) {
+                if (static_cast<size_t>(i) % shards_.size() == shard.index)
+                    part.add_account_include(entry.account_include(i));
+            }
+            if (!part.account_include().empty())
+                transactions[name] = std::move(part);
+        }
+    }
+
+    // Configured accounts go in their own entry. Without them or any
+    // narrowing filter the first shard subscribes to every non-vote
+    // transaction, and the others to none.
+    if (!shard.accounts.empty()
+        || (transactions.empty() && shard.index == 0)) {
+        geyser::SubscribeRequestFilterTransactions txFilter;
+        txFilter.set_vote(false);
+        txFilter.set_failed(false);
+        for (const auto& account : shard.accounts) {
+            txFilter.add_account_include(account);
+        }
+        transactions["tokens"] = txFilter;
+    }
+
+    // Account state is the same on every shard, so only the first one
+    // streams it.
+    if (shard.index == 0
+        && (!source_.accountWatch.empty() || !source_.accountOwners.empty())) {
+        geyser::SubscribeRequestFilterAccounts accountFilter;
+        for (const auto& account : source_.accountWatch) {
+            accountFilter.add_account(account);
+        }
+        for (const auto& owner : source_.accountOwners) {
+            accountFilter.add_owner(owner);
+        }
+        (*req.mutable_accounts())["accounts"] = accountFilter;
+    }
+
+    // Slot statuses and block meta close slots in the reorder stage. Each
+    // shard needs its own, a lane only passes the slots its stream closed.
+    if (source_.reorder) {
+        (*req.mutable_slots())["reorder"]
+            = geyser::SubscribeRequestFilterSlots();
+        (*req.mutable_blocks_meta())["reorder"]
+            = geyser::SubscribeRequestFilterBlocksMeta();
+    }
+    return req;
+}
+
+void GeyserClientWorker::refreshSubscription()
+{
+    auto compiled = filter_.compileSubscription();
+    Logger::getLogger()->info("Updating {} subscription for {} filter(s)",
+        source_.address, compiled.size());
+    {
+        std::lock_guard lock(subscriptionMutex_);
+        filterSubscription_ = std::move(compiled);
+    }
+
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard->callsMutex);
+        if (shard->thread.get_stop_token().stop_requested()
+            || shard->resubscriber.wakePending)
+            continue;
+        shard->resubscriber.wakePending = true;
+        shard->resubscriber.wakeup.Set(shard->cq.get(),
+            std::chrono::system_clock::now(), &shard->resubscriber.wakeup);
+    }
+}
+
+void GeyserClientWorker::onResubscribe(Shard& shard)
+{
+    {
+        std::lock_guard lock(shard.callsMutex);
+        shard.resubscriber.wakePending = false;
+    }
+    // One write at a time per stream: queue another round behind it.
+    if (shard.resubscriber.writing)
+        shard.resubscriber.again = true;
+    else
+        writeSubscription(shard);
+}
+
+void GeyserClientWorker::writeSubscription(Shard& shard)
+{
+    AsyncCall* live = nullptr;
+    {
+        std::lock_guard lock(shard.callsMutex);
+        for (auto& call : shard.activeCalls) {
+            if (call->state == AsyncCall::State::READ)
+                live = call.get();
+        }
+    }
+    // A stream that is still being set up sends the new filters anyway.
+    if (!live)
+        return;
+
+    bool ownBuffer = false;
+    grpc::SerializationTraits<geyser::SubscribeRequest>::Serialize(
+        buildSubscribeRequest(shard, std::nullopt), &shard.resubscriber.request,
+        &ownBuffer);
+    shard.resubscriber.writing = true;
+    live->reader->Write(
+        shard.resubscriber.request, &shard.resubscriber.request);
+}
+
+std::optional<uint64_t> GeyserClientWorker::resumeSlot(
+    const Shard& shard) const
+{
+    if (shard.resumeRejected)
+        return std::nullopt;
+    // Replay from the first slot not yet fully processed; the pipeline
+    // starts from the persisted checkpoint. After a reconnect
+    // markReplay() lets dedup drop the overlap even where it is older
+    // than the window.
+    if (uint64_t checkpoint = pipeline_->getCheckpointSlot())
+        return checkpoint + 1;
+    return std::nullopt;
+}
+
+void GeyserClientWorker::runShard(Shard& shard, std::stop_token stoken)
+{
+    try {
+        initiateAsyncCall(shard);
+        processAsyncResponses(shard, stoken);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error("Worker error for {} shard {}: {}",
+            sourceId_, shard.index, e.what());
+        error.publish(e.what());
+    }
+}
+
+void GeyserClientWorker::initiateAsyncCall(Shard& shard)
+{
+    auto call = std::make_unique<AsyncCall>();
+    auto* raw = call.get();
+    {
+        std::lock_guard lock(shard.callsMutex);
+        shard.activeCalls.push_back(std::move(call));
+    }
+    startCall(shard, raw);
+}
+
+void GeyserClientWorker::startCall(Shard& shard, AsyncCall* call)
+{
+    call->context.set_deadline(
+        std::chrono::system_clock::now() + std::chrono::hours(24));
+    call->fromSlot = resumeSlot(shard);
+    if (call->fromSlot)
+        pipeline_->markReplay();
+    call->reader = shard.stub->PrepareCall(
+        &call->context, SUBSCRIBE_METHOD, shard.cq.get());
+    call->state = AsyncCall::State::START;
+    call->reader->StartCall(call);
+}
+
+void GeyserClientWorker::resumeCall(Shard& shard, AsyncCall* call)
+{
+    {
+        std::lock_guard lock(shard.callsMutex);
+        if (standby_) {
+            call->alarm.Set(shard.cq.get(),
+                std::chrono::system_clock::now() + STANDBY_PARK, call);
+            return;
+        }
+        // Out of BACKOFF before the lock drops, so a standby request made
+        // from here on cancels the call instead of missing it.
+        call->state = AsyncCall::State::START;
+    }
+    startCall(shard, call);
+}
+
+void GeyserClientWorker::finishCall(Shard& shard, AsyncCall* call)
+{
+    if (!call->status.ok() && !standby_) {
+        Logger::getLogger()->warn("Stream {} shard {} ended: {} ({})",
+            source_.address, shard.index, call->status.error_message(),
+            static_cast<int>(call->status.error_code()));
+    }
+
+    // Endpoints reject from_slot once it falls out of their replay window;
+    // give up on the backfill rather than fail the same way forever.
+    if (call->fromSlot && !call->receivedData
+        && (call->status.error_code() == grpc::StatusCode::INVALID_ARGUMENT
+            || call->status.error_code() == grpc::StatusCode::OUT_OF_RANGE)) {
+        Logger::getLogger()->warn(
+            "{} cannot replay from slot {}, subscribing without backfill",
+            source_.address, *call->fromSlot);
+        shard.resumeRejected = true;
+    }
+
+    {
+        std::lock_guard lock(shard.callsMutex);
+        std::erase_if(shard.activeCalls,
+            [call](const auto& active) { return active.get() == call; });
+    }
+    scheduleReconnect(shard);
+}
+
+void GeyserClientWorker::scheduleReconnect(Shard& shard)
+{
+    auto call = std::make_unique<AsyncCall>();
+    call->state = AsyncCall::State::BACKOFF;
+    std::lock_guard lock(shard.callsMutex);
+    if (standby_) {
+        // Parked until setStandby(false) cancels the alarm.
+        call->alarm.Set(shard.cq.get(),
+            std::chrono::system_clock::now() + STANDBY_PARK, call.get());
+        shard.activeCalls.push_back(std::move(call));
+        return;
+    }
+
+    ++shard.reconnects;
+    auto delay = shard.backoff;
+    shard.backoff = std::min(shard.backoff * 2, MAX_BACKOFF);
+    Logger::getLogger()->info("Reconnecting {} shard {} in {} ms",
+        source_.address, shard.index, delay.count());
+    call->alarm.Set(
+        shard.cq.get(), std::chrono::system_clock::now() + delay, call.get());
+    shard.activeCalls.push_back(std::move(call));
+}
+
+void GeyserClientWorker::processAsyncResponses(
+    Shard& shard, std::stop_token stoken)
+{
+    void* tag;
+    bool ok = false;
+    while (shard.cq->Next(&tag, &ok)) {
+        // Keep draining after a stop so the queue can shut down cleanly.
+        if (stoken.stop_requested())
+            continue;
+
+        if (tag == &shard.flushTimer) {
+            onFlushTimer(shard, ok);
+            continue;
+        }
+        if (tag == &shard.resubscriber.wakeup) {
+            onResubscribe(shard);
+            continue;
+        }
+        if (tag == &shard.resubscriber.request) {
+            shard.resubscriber.writing = false;
+            if (std::exchange(shard.resubscriber.again, false) && ok)
+                writeSubscription(shard);
+            continue;
+        }
+
+        auto* call = static_cast<AsyncCall*>(tag);
+        if (!ok && call->state != AsyncCall::State::FINISHING) {
+            shard.connected = false;
+            if (call->state == AsyncCall::State::BACKOFF) {
+                resumeCall(shard, call);
+            } else {
+                call->state = AsyncCall::State::FINISHING;
+                call->reader->Finish(&call->status, call);
+            }
+            continue;
+        }
+        switch (call->state) {
+        case AsyncCall::State::BACKOFF:
+            resumeCall(shard, call);
+            break;
+        case AsyncCall::State::START: {
+            call->state = AsyncCall::State::WRITE;
+            bool ownBuffer = false;
+            grpc::SerializationTraits<geyser::SubscribeRequest>::Serialize(
+                buildSubscribeRequest(shard, call->fromSlot), &call->request,
+                &ownBuffer);
+            call->reader->Write(call->request, call);
+            break;
+        }
+        case AsyncCall::State::WRITE:
+            call->state = AsyncCall::State::READ;
+            call->reader->Read(&call->response, call);
+            break;
+        case AsyncCall::State::READ:
+            if (!call->receivedData) {
+                call->receivedData = true;
+                shard.connected = true;
+                shard.backoff = INITIAL_BACKOFF;
+            }
+            // Decoding happens in the pipeline; this thread only moves the
+            // frame along so Read() is never held up by parsing.
+            if (capture_) {
+                capture_->write(call->response,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count());
+            }
+            shard.frames->push_back(
+                { std::move(call->response), FeedRace::nowMicros() });
+            onFrame(shard);
+            call->response.Clear();
+            call->reader->Read(&call->response, call);
+            break;
+        case AsyncCall::State::FINISHING:
+            finishCall(shard, call);
+            break;
+        }
+    }
+}
+
+void GeyserClientWorker::onFrame(Shard& shard)
+{
+    auto now = std::chrono::steady_clock::now();
+    ++shard.received;
+    updateBatchTarget(shard, now);
+
+    if (shard.frames->size() == 1) {
+        shard.batchOpenedAt = now;
+        if (!shard.flushTimer.armed) {
+            armFlushTimer(shard,
+                now + std::chrono::milliseconds(source_.batchTargetLatencyMs));
+        }
+    }
+    if (shard.frames->size() >= shard.batchTarget)
+        flushShardBatch(shard, FlushReason::SIZE);
+}
+
+void GeyserClientWorker::onFlushTimer(Shard& shard, bool ok)
+{
+    shard.flushTimer.armed = false;
+    if (!ok || shard.frames->empty())
+        return;
+
+    // The timer may have been armed for a batch that has since been
+    // flushed by size, in which case the open batch gets its own deadline.
+    auto deadline = shard.batchOpenedAt
+        + std::chrono::milliseconds(source_.batchTargetLatencyMs);
+    if (std::chrono::steady_clock::now() >= deadline)
+        flushShardBatch(shard, FlushReason::DEADLINE);
+    else
+        armFlushTimer(shard, deadline);
+}
+
+void GeyserClientWorker::armFlushTimer(
+    Shard& shard, std::chrono::steady_clock::time_point deadline)
+{
+    // grpc::Alarm only takes system_clock deadlines.
+    auto wallDeadline = std::chrono::system_clock::now()
+        + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            deadline - std::chrono::steady_clock::now());
+    shard.flushTimer.armed = true;
+    shard.flushTimer.alarm.Set(shard.cq.get(), wallDeadline, &shard.flushTimer);
+}
+
+void GeyserClientWorker::updateBatchTarget(
+    Shard& shard, std::chrono::steady_clock::time_point now)
+{
+    if (shard.lastArrival != std::chrono::steady_clock::time_point {}) {
+        double gapUs = std::chrono::duration<double, std::micro>(
+            now - shard.lastArrival)
+                           .count();
+        shard.meanGapUs = shard.meanGapUs == 0.0
+            ? gapUs
+            : shard.meanGapUs + (gapUs - shard.meanGapUs) * ARRIVAL_SMOOTHING;
+    }
+    shard.lastArrival = now;
+    if (shard.meanGapUs <= 0.0)
+        return;
+
+    // Size batches to what arrives within the latency target, so a busy
+    // feed flushes on size before the deadline and a quiet one on time.
+    double expected = source_.batchTargetLatencyMs * 1000.0 / shard.meanGapUs;
+    shard.batchTarget = std::clamp(static_cast<size_t>(expected),
+        static_cast<size_t>(source_.batchMinSize),
+        static_cast<size_t>(source_.batchMaxSize));
+}
+
+void GeyserClientWorker::flushShardBatch(Shard& shard, FlushReason reason)
+{
+    if (shard.frames->empty())
+        return;
+
+    ++shard.batches;
+    if (reason == FlushReason::SIZE)
+        ++shard.sizeFlushes;
+    else
+        ++shard.deadlineFlushes;
+    auto frames = std::move(shard.frames);
+    shard.frames = std::make_unique<IngestPipeline::FrameBatch>();
+    shard.frames->reserve(shard.batchTarget);
+    // Blocks here under the block policy, which stops reading and lets
+    // HTTP/2 flow control push back on the server.
+    if (!pipeline_->submit(
+            shard.index, std::move(frames), shard.batchOpenedAt))
+        ++shard.shed;
+}
+}
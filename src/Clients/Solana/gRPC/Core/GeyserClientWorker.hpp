@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/alarm.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/grpcpp.h>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "AccountCache.hpp"
+#include "ConfigManager.hpp"
+#include "DataSourceWorker.hpp"
+#include "FeedRace.hpp"
+#include "FilterManager.hpp"
+#include "FrameCapture.hpp"
+#include "IngestPipeline.hpp"
+#include "NotificationManager.hpp"
+#include "StorageManager.hpp"
+#include "TxRingPublisher.hpp"
+
+namespace solana {
+
+// Network stage of a Geyser source: keeps the shard streams alive and hands
+// batches of raw frames to the IngestPipeline.
+class GeyserClientWorker : public DataSourceWorker {
+public:
+    GeyserClientWorker(const std::string& sourceId,
+        const ConfigManager::DataSourceConfig& source, StorageManager& storage,
+        NotificationManager& notifier, FilterManager& filter,
+        std::shared_ptr<FeedRace> race = nullptr,
+        std::shared_ptr<AccountCache> accounts = nullptr,
+        std::shared_ptr<TxRingPublisher> ring = nullptr);
+    ~GeyserClientWorker();
+
+    bool isConnected() const override;
+    uint64_t getTotalTransactions() const override;
+    uint64_t getProcessedBatches() const override;
+    uint64_t getDuplicateTransactions() const override;
+    uint64_t getReconnects() const override;
+    uint64_t getCheckpointSlot() const override;
+    double getBytesCopiedPerTransaction() const override;
+    json getShardStats() const override;
+    json getPipelineStats() const override;
+    const IngestTracer& getTracer() const override;
+    std::shared_ptr<grpc::Channel> getChannel() const override;
+    void setStandby(bool standby) override;
+    bool isStandby() const override;
+
+private:
+    static constexpr const char* SUBSCRIBE_METHOD = "/geyser.Geyser/Subscribe";
+    static constexpr double ARRIVAL_SMOOTHING = 0.125;
+    static constexpr std::chrono::milliseconds INITIAL_BACKOFF { 500 };
+    static constexpr std::chrono::milliseconds MAX_BACKOFF { 30000 };
+    static constexpr std::chrono::hours STANDBY_PARK { 24 };
+
+    struct AsyncCall {
+        grpc::ByteBuffer request;
+        grpc::ByteBuffer response;
+        std::unique_ptr<grpc::GenericClientAsyncReaderWriter> reader;
+        grpc::ClientContext context;
+        grpc::Status status;
+        grpc::Alarm alarm;
+        std::optional<uint64_t> fromSlot;
+        bool receivedData { false };
+        enum class State { BACKOFF, START, WRITE, READ, FINISHING };
+        State state = State::START;
+    };
+
+    enum class FlushReason { SIZE, DEADLINE };
+
+    struct FlushTimer {
+        grpc::Alarm alarm;
+        bool armed { false };
+    };
+
+    // Pushes a new subscription onto a live stream. The wakeup alarm hands
+    // the request to the shard thread; the write completes on &request.
+    struct Resubscriber {
+        grpc::Alarm wakeup;
+        bool wakePending { false };
+        bool writing { false };
+        bool again { false };
+        grpc::ByteBuffer request;
+    };
+
+    struct Shard {
+        size_t index { 0 };
+        std::vector<std::string> accounts;
+        std::jthread thread;
+        std::unique_ptr<grpc::CompletionQueue> cq;
+        std::shared_ptr<grpc::Channel> channel;
+        std::unique_ptr<grpc::GenericStub> stub;
+        std::vector<std::unique_ptr<AsyncCall>> activeCalls;
+        std::mutex callsMutex;
+        std::unique_ptr<IngestPipeline::FrameBatch> frames;
+        std::atomic<bool> connected { false };
+        std::atomic<uint64_t> received { 0 };
+        std::atomic<uint64_t> batches { 0 };
+        std::atomic<uint64_t> shed { 0 };
+        std::atomic<uint64_t> reconnects { 0 };
+        bool resumeRejected { false };
+        std::chrono::milliseconds backoff { INITIAL_BACKOFF };
+        FlushTimer flushTimer;
+        Resubscriber resubscriber;
+        std::chrono::steady_clock::time_point batchOpenedAt;
+        std::chrono::steady_clock::time_point lastArrival;
+        double meanGapUs { 0.0 };
+        std::atomic<size_t> batchTarget { 0 };
+        std::atomic<uint64_t> sizeFlushes { 0 };
+        std::atomic<uint64_t> deadlineFlushes { 0 };
+        std::chrono::steady_clock::time_point startedAt;
+    };
+
+    void start();
+    void stop();
+    void partitionAccounts();
+    grpc::ChannelArguments createChannelArguments() const;
+    geyser::SubscribeRequest buildSubscribeRequest(
+        const Shard& shard, std::optional<uint64_t> fromSlot) const;
+    std::optional<uint64_t> resumeSlot(const Shard& shard) const;
+
+    void refreshSubscription();
+    void onResubscribe(Shard& shard);
+    void writeSubscription(Shard& shard);
+
+    void runShard(Shard& shard, std::stop_token stoken);
+    void initiateAsyncCall(Shard& shard);
+    void startCall(Shard& shard, AsyncCall* call);
+    void resumeCall(Shard& shard, AsyncCall* call);
+    void finishCall(Shard& shard, AsyncCall* call);
+    void scheduleReconnect(Shard& shard);
+    void processAsyncResponses(Shard& shard, std::stop_token stoken);
+    void onFrame(Shard& shard);
+    void onFlushTimer(Shard& shard, bool ok);
+    void armFlushTimer(
+        Shard& shard, std::chrono::steady_clock::time_point deadline);
+    void updateBatchTarget(
+        Shard& shard, std::chrono::steady_clock::time_point now);
+    void flushShardBatch(Shard& shard, FlushReason reason);
+
+    std::string sourceId_;
+    StorageManager& storage_;
+    NotificationManager& notification_;
+    FilterManager& filter_;
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::unique_ptr<IngestPipeline> pipeline_;
+    std::unique_ptr<FrameCapture> capture_;
+
+    std::map<std::string, geyser::SubscribeRequestFilterTransactions>
+        filterSubscription_;
+    mutable std::mutex subscriptionMutex_;
+    std::array<Event<const std::string&>::Subscription, 3>
+        filterSubscriptions_ {};
+
+    std::optional<uint64_t> persistedCheckpoint_;
+    std::atomic<bool> standby_ { false };
+};
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace solana {
+
+/**
+ * HyperLogLog sketch of how many distinct items were added, with 64
+ * registers of 4 bits each: 32 bytes, for a standard error of about 13%.
+ * Small counts are estimated by linear counting and are close to exact.
+ * Sketches of disjoint periods merge into one of their union, which is
+ * what lets a window be counted from the sketches of its buckets.
+ *
+ * Items go in as 64-bit hashes, which must be well mixed.
+ */
+class HyperLogLog {
+public:
+    static constexpr uint32_t REGISTERS = 64;
+
+    void add(uint64_t hash)
+    {
+        const uint32_t index = static_cast<uint32_t>(hash >> 58);
+        // Position of the first set bit among the 58 left, at most 15.
+        const uint64_t rest = hash << 6;
+        const auto rank = static_cast<uint8_t>(
+            rest == 0 ? 15 : std::min(std::countl_zero(rest) + 1, 15));
+        if (rank > get(index))
+            set(index, rank);
+    }
+
+    void merge(const HyperLogLog& other)
+    {
+        // Both registers of a byte at once.
+        for (size_t i = 0; i < registers_.size(); ++i) {
+            const uint8_t a = registers_[i];
+            const uint8_t b = other.registers_[i];
+            registers_[i] = static_cast<uint8_t>(
+                std::max(a & 0x0f, b & 0x0f) | std::max(a & 0xf0, b & 0xf0));
+        }
+    }
+
+    void clear()
+    {
+        registers_.fill(0);
+    }
+
+    double estimate() const
+    {
+        double sum = 0.0;
+        uint32_t zeros = 0;
+        for (uint32_t i = 0; i < REGISTERS; ++i) {
+            const uint8_t rank = get(i);
+            sum += 1.0 / static_cast<double>(1u << rank);
+            zeros += rank == 0;
+        }
+        constexpr double m = REGISTERS;
+        const double raw = 0.709 * m * m / sum;
+        if (raw <= 2.5 * m && zeros > 0)
+            return m * std::log(m / zeros);
+        return raw;
+    }
+
+private:
+    uint8_t get(uint32_t index) const
+    {
+        return (registers_[index / 2] >> (index % 2 * 4)) & 0x0f;
+    }
+
+    void set(uint32_t index, uint8_t rank)
+    {
+        uint8_t& byte = registers_[index / 2];
+        const int shift = index % 2 * 4;
+        byte = static_cast<uint8_t>((byte & ~(0x0f << shift)) | rank << shift);
+    }
+
+    std::array<uint8_t, REGISTERS / 2> registers_ {};
+};
+}
@@ -0,0 +1,613 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "IngestPipeline.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "WireReader.hpp"
+
+#include "../Utils/Logger.hpp"
+
+namespace solana {
+
+namespace {
+    // SubscribeUpdate field numbers from geyser.proto.
+    namespace field {
+        constexpr uint32_t FILTERS = 1;
+        constexpr uint32_t ACCOUNT = 2;
+        constexpr uint32_t SLOT = 3;
+        constexpr uint32_t TRANSACTION = 4;
+        constexpr uint32_t BLOCK_META = 7;
+        constexpr uint32_t CREATED_AT = 11;
+    }
+
+    void ring(std::atomic<uint32_t>& bell)
+    {
+        bell.fetch_add(1, std::memory_order_release);
+        bell.notify_all();
+    }
+
+    bool flatten(const grpc::ByteBuffer& frame, std::string& wire)
+    {
+        std::vector<grpc::Slice> slices;
+        if (!frame.Dump(&slices).ok())
+            return false;
+        wire.reserve(frame.Length());
+        for (const auto& slice : slices) {
+            wire.append(
+                reinterpret_cast<const char*>(slice.begin()), slice.size());
+        }
+        return true;
+    }
+
+    // Field number of the update a SubscribeUpdate carries, 0 if none.
+    uint32_t updateKind(std::string_view frame)
+    {
+        WireReader reader(frame);
+        while (!reader.done()) {
+            uint32_t number, type;
+            if (!reader.readTag(number, type))
+                return 0;
+            if (number != field::FILTERS && number != field::CREATED_AT)
+                return number;
+            if (!reader.skip(type))
+                return 0;
+        }
+        return 0;
+    }
+}
+
+IngestPipeline::IngestPipeline(const std::string& sourceId,
+    const std::string& endpoint, const Options& options,
+    std::shared_ptr<FeedRace> race, std::shared_ptr<AccountCache> accounts,
+    std::shared_ptr<TxRingPublisher> ring, FilterManager& filter,
+    StorageManager& storage, NotificationManager& notifier,
+    const std::string& checkpointKey, uint64_t checkpointSlot)
+    : sourceId_(sourceId)
+    , options_(options)
+    , race_(std::move(race))
+    , accounts_(std::move(accounts))
+    , ring_(std::move(ring))
+    , filter_(filter)
+    , storage_(storage)
+    , notification_(notifier)
+    , sink_(options.queueCapacity)
+    , checkpointKey_(checkpointKey)
+    , checkpointSlot_(checkpointSlot)
+{
+    options_.lanes = std::max<size_t>(1, options_.lanes);
+    options_.sampleRate = std::max<uint32_t>(1, options_.sampleRate);
+
+    // Overlapping shard partitions and from_slot replays after a reconnect
+    // both deliver signatures we already have, so every source dedups even
+    // when it is not racing other endpoints.
+    if (!race_) {
+        race_ = std::make_shared<FeedRace>(
+            DEDUP_WINDOW_SLOTS, DEDUP_SLOT_CAPACITY);
+    }
+    endpointId_ = race_->registerEndpoint(endpoint);
+    if (options_.reorder)
+        reorder_ = std::make_unique<SlotReorderBuffer>(
+            *options_.reorder, options_.lanes);
+
+    for (size_t i = 0; i < options_.lanes; ++i) {
+        lanes_.push_back(std::make_unique<Lane>(options_.queueCapacity));
+    }
+    sinkStage_ = std::jthread([this] { runSink(); });
+    filterStage_ = std::jthread([this] { runFilter(); });
+    for (size_t i = 0; i < lanes_.size(); ++i) {
+        lanes_[i]->decoder
+            = std::jthread([this, i] { runDecoder(*lanes_[i], i); });
+    }
+}
+
+IngestPipeline::~IngestPipeline()
+{
+    close();
+}
+
+IngestPipeline::OverflowPolicy IngestPipeline::parseOverflowPolicy(
+    const std::string& name)
+{
+    if (name == "drop_oldest")
+        return OverflowPolicy::DROP_OLDEST;
+    if (name == "sample")
+        return OverflowPolicy::SAMPLE;
+    if (name != "block") {
+        Logger::getLogger()->warn(
+            "Unknown overflow policy '{}', using block", name);
+    }
+    return OverflowPolicy::BLOCK;
+}
+
+bool IngestPipeline::submit(size_t lane, std::unique_ptr<FrameBatch> frames,
+    std::chrono::steady_clock::time_point receivedAt)
+{
+    auto& target = *lanes_[lane];
+    auto now = std::chrono::steady_clock::now();
+    tracer_.record(IngestTracer::BUFFER, receivedAt, now);
+    FrameItem item { std::move(frames), now, receivedAt };
+    // Raised before the closed check, so the decoder cannot stop between
+    // that check and the push.
+    target.submitting = true;
+    bool pushed = false;
+    if (target.input.closed)
+        recordDrop(target.input, item);
+    else
+        pushed = push(target.input, std::move(item), target.bell);
+    target.submitting = false;
+    if (!pushed)
+        ring(target.bell);
+    return pushed;
+}
+
+void IngestPipeline::close()
+{
+    if (closed_.exchange(true))
+        return;
+
+    // One stage at a time, so each drains what the one before it left:
+    // only the inputs shed, the later stages block as usual.
+    for (auto& lane : lanes_) {
+        lane->input.closed = true;
+        ring(lane->input.space);
+        ring(lane->bell);
+    }
+    for (auto& lane : lanes_) {
+        if (lane->decoder.joinable())
+            lane->decoder.join();
+    }
+    decodersDone_ = true;
+    ring(filterBell_);
+    if (filterStage_.joinable())
+        filterStage_.join();
+    filterDone_ = true;
+    ring(sinkBell_);
+    if (sinkStage_.joinable())
+        sinkStage_.join();
+
+    // The last write may have been throttled.
+    if (!checkpointKey_.empty() && checkpointSlot_)
+        storage_.storeCheckpoint(checkpointKey_, checkpointSlot_);
+}
+
+void IngestPipeline::markReplay()
+{
+    race_->markReplay(endpointId_);
+}
+
+template <typename T>
+bool IngestPipeline::push(Link<T>& link, T item, std::atomic<uint32_t>& bell)
+{
+    while (true) {
+        uint32_t seen = link.space.load(std::memory_order_acquire);
+        if (link.ring.tryPush(item))
+            break;
+        if (link.closed) {
+            recordDrop(link, item);
+            return false;
+        }
+
+        switch (options_.overflowPolicy) {
+        case OverflowPolicy::BLOCK:
+            link.space.wait(seen, std::memory_order_acquire);
+            continue;
+        case OverflowPolicy::SAMPLE:
+            // Under sustained overflow keep one in sampleRate batches; the
+            // kept one displaces the oldest like DROP_OLDEST does.
+            if (++link.overflows % options_.sampleRate != 0) {
+                recordDrop(link, item);
+                return false;
+            }
+            [[fallthrough]];
+        case OverflowPolicy::DROP_OLDEST: {
+            T evicted;
+            if (link.ring.tryPop(evicted))
+                recordDrop(link, evicted);
+            break;
+        }
+        }
+    }
+    ring(bell);
+    return true;
+}
+
+template <typename T>
+bool IngestPipeline::pop(Link<T>& link, T& item)
+{
+    if (!link.ring.tryPop(item))
+        return false;
+    ring(link.space);
+    return true;
+}
+
+template <typename T>
+void IngestPipeline::recordDrop(Link<T>& link, const T& item)
+{
+    ++link.drops;
+    if constexpr (std::is_same_v<T, LaneBatch>) {
+        size_t transactions = item.batch ? item.batch->size() : 0;
+        link.droppedItems += transactions;
+        settle(item, transactions);
+    } else
+        link.droppedItems += item.frames ? item.frames->size() : 0;
+}
+
+template <typename T>
+json IngestPipeline::linkStats(const Link<T>& link)
+{
+    json stats;
+    stats["depth"] = link.ring.size();
+    stats["capacity"] = link.ring.capacity();
+    stats["drops"] = link.drops.load();
+    stats["dropped_items"] = link.droppedItems.load();
+    return stats;
+}
+
+void IngestPipeline::runDecoder(Lane& lane, size_t index)
+{
+    while (true) {
+        uint32_t seen = lane.bell.load(std::memory_order_acquire);
+        // Read before the pop, so nothing can be pushed after it is seen.
+        bool done = lane.input.closed && !lane.submitting;
+        FrameItem item;
+        // Raised before the pop so the filter stage never sees an item
+        // between the input ring and the decoder.
+        lane.decoding = true;
+        if (!pop(lane.input, item)) {
+            lane.decoding = false;
+            if (done)
+                break;
+            lane.bell.wait(seen, std::memory_order_acquire);
+            continue;
+        }
+
+        const auto& frames = *item.frames;
+        for (size_t next = 0; next < frames.size();) {
+            LaneBatch decoded;
+            decoded.lane = index;
+            decoded.submittedAt = item.submittedAt;
+            decoded.receivedAt = item.receivedAt;
+            next = decode(lane, frames, next, decoded);
+            // Counted here, where the frames were copied; the reorder stage
+            // only moves them into other batches.
+            totalBytesCopied_ += decoded.batch->getBytesCopied();
+            if (!decoded.batch->empty() || decoded.slotEventCount)
+                push(lane.output, std::move(decoded), filterBell_);
+        }
+        lane.decoding = false;
+    }
+}
+
+size_t IngestPipeline::decode(
+    Lane& lane, const FrameBatch& frames, size_t begin, LaneBatch& item)
+{
+    item.batch = std::make_unique<TransactionBatch>(frames.size() - begin);
+    auto& batch = item.batch;
+    size_t next = begin;
+    while (next < frames.size()
+        && item.slotEventCount < item.slotEvents.size()) {
+        const auto& frame = frames[next++];
+        std::string wire;
+        if (!flatten(frame.buffer, wire))
+            continue;
+
+        switch (updateKind(wire)) {
+        case field::TRANSACTION:
+            break;
+        case field::ACCOUNT:
+            if (accounts_ && accounts_->apply(wire))
+                ++accountUpdates_;
+            continue;
+        case field::SLOT:
+        case field::BLOCK_META: {
+            SlotReorderBuffer::SlotEvent event;
+            // Only closing events move the reorder stage.
+            if (reorder_ && SlotReorderBuffer::parseEvent(wire, event)
+                && event.closes)
+                item.slotEvents[item.slotEventCount++] = event;
+            continue;
+        }
+        default:
+            continue;
+        }
+
+        if (!batch->append(std::move(wire)))
+            continue;
+        const auto& entry = batch->entries().back();
+        if (!race_->admit(
+                endpointId_, entry.signature, entry.slot, frame.receivedUs)) {
+            batch->popBack();
+            ++duplicates_;
+        } else {
+            ++lane.transactions;
+        }
+    }
+    lane.receivedSlot
+        = std::max(lane.receivedSlot.load(), batch->getMaxSlot());
+    return next;
+}
+
+void IngestPipeline::runFilter()
+{
+    size_t next = 0;
+    while (true) {
+        uint32_t seen = filterBell_.load(std::memory_order_acquire);
+        // Read before the pops, so the decoders' last batches are seen.
+        bool done = decodersDone_;
+        bool busy = false;
+        // Round-robin so one hot lane cannot starve the others.
+        for (size_t i = 0; i < lanes_.size(); ++i) {
+            auto& lane = *lanes_[(next + i) % lanes_.size()];
+            LaneBatch item;
+            if (!pop(lane.output, item))
+                continue;
+            busy = true;
+            if (!reorder_) {
+                filterBatch(std::move(item));
+                continue;
+            }
+            auto now = SlotReorderBuffer::Clock::now();
+            reorder_->hold(item.lane, *item.batch, item.submittedAt,
+                item.receivedAt, now);
+            for (size_t i = 0; i < item.slotEventCount; ++i) {
+                reorder_->apply(item.lane, item.slotEvents[i], now);
+            }
+        }
+        next = (next + 1) % lanes_.size();
+        if (reorder_) {
+            for (size_t i = 0; i < lanes_.size(); ++i) {
+                reorder_->setIdle(i, idle(*lanes_[i]));
+            }
+            releaseSlots(done && !busy);
+        }
+
+        if (!busy) {
+            if (done)
+                break;
+            if (reorder_ && !reorder_->empty()) {
+                // Held slots time out even when nothing else arrives.
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            filterBell_.wait(seen, std::memory_order_acquire);
+        }
+    }
+}
+
+void IngestPipeline::filterBatch(LaneBatch item)
+{
+    auto start = std::chrono::steady_clock::now();
+    tracer_.record(IngestTracer::QUEUE, item.submittedAt, start);
+    try {
+        item.hits = filter_.processBatch(sourceId_, *item.batch);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error("Error filtering batch: {}", e.what());
+        error.publish(e.what());
+    }
+    item.filteredAt = std::chrono::steady_clock::now();
+    tracer_.record(IngestTracer::FILTER, start, item.filteredAt);
+    push(sink_, std::move(item), sinkBell_);
+}
+
+bool IngestPipeline::idle(const Lane& lane) const
+{
+    // In the order items move through the lane, so one in transit is
+    // always seen somewhere.
+    return lane.input.ring.size() == 0 && !lane.decoding
+        && lane.output.ring.size() == 0;
+}
+
+void IngestPipeline::releaseSlots(bool flush)
+{
+    for (auto& released :
+        reorder_->release(SlotReorderBuffer::Clock::now(), flush)) {
+        json data;
+        data["source_id"] = sourceId_;
+        data["slot"] = released.slot;
+        data["transactions"] = released.batch->size();
+        data["reason"] = SlotReorderBuffer::reasonName(released.reason);
+        data["held_us"] = released.heldUs;
+        if (released.reason != SlotReorderBuffer::Reason::LATE)
+            slotClosed.publish(data);
+        if (released.batch->empty())
+            continue;
+
+        LaneBatch item;
+        item.lane = released.lanes.front().lane;
+        item.lanes = std::move(released.lanes);
+        item.batch = std::move(released.batch);
+        item.submittedAt = released.submittedAt;
+        item.receivedAt = released.receivedAt;
+        filterBatch(std::move(item));
+    }
+}
+
+void IngestPipeline::runSink()
+{
+    while (true) {
+        uint32_t seen = sinkBell_.load(std::memory_order_acquire);
+        bool done = filterDone_;
+        LaneBatch item;
+        if (!pop(sink_, item)) {
+            if (done)
+                break;
+            sinkBell_.wait(seen, std::memory_order_acquire);
+            continue;
+        }
+        deliver(item);
+    }
+}
+
+void IngestPipeline::deliver(LaneBatch& item)
+{
+    auto& batch = *item.batch;
+    auto start = std::chrono::steady_clock::now();
+    tracer_.record(IngestTracer::SINK_QUEUE, item.filteredAt, start);
+    const size_t count = batch.size();
+    try {
+        // Before storage takes the frames out of the batch.
+        if (ring_)
+            ring_->publish(batch);
+        auto storing = std::chrono::steady_clock::now();
+        storage_.storeBatch(batch.releaseRecords());
+        auto stored = std::chrono::steady_clock::now();
+        tracer_.record(IngestTracer::STORE, storing, stored);
+        notification_.sendBatchNotifications(
+            "Processed " + std::to_string(count) + " transactions");
+        auto notified = std::chrono::steady_clock::now();
+        tracer_.record(IngestTracer::NOTIFY, stored, notified);
+        tracer_.record(IngestTracer::END_TO_END, item.receivedAt, notified);
+        json data;
+        data["source_id"] = sourceId_;
+        data["transactions"] = count;
+        data["hits"] = item.hits;
+        batchProcessed.publish(data);
+        Logger::getLogger()->debug(
+            "Processed batch of {} transactions with {} filter hits", count,
+            item.hits);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error("Error processing batch: {}", e.what());
+        error.publish(e.what());
+    }
+    ++processedBatches_;
+
+    // Reordered batches are released in slot order, so every lane that
+    // contributed has nothing older left in flight.
+    auto credit = [this, &batch](size_t index) {
+        auto& lane = *lanes_[index];
+        lane.processedSlot
+            = std::max(lane.processedSlot.load(), batch.getMaxSlot());
+    };
+    credit(item.lane);
+    for (const auto& share : item.lanes) {
+        credit(share.lane);
+    }
+    settle(item, count);
+    updateCheckpoint();
+}
+
+void IngestPipeline::settle(const LaneBatch& item, size_t transactions)
+{
+    if (item.lanes.empty()) {
+        lanes_[item.lane]->settled += transactions;
+        return;
+    }
+    for (const auto& share : item.lanes) {
+        lanes_[share.lane]->settled += share.transactions;
+    }
+}
+
+void IngestPipeline::updateCheckpoint()
+{
+    // A lane with nothing in flight has caught up with the newest slot any
+    // lane received; the others hold it at what they delivered, and one
+    // that has delivered nothing yet holds it where it is. The newest slot
+    // may still be receiving transactions, so the one before the lowest
+    // is fully processed.
+    uint64_t lowest = 0;
+    for (const auto& lane : lanes_) {
+        lowest = std::max(lowest, lane->receivedSlot.load());
+    }
+    for (const auto& lane : lanes_) {
+        // Read transactions before settled, which never overtakes it.
+        bool drained = idle(*lane) && lane->transactions == lane->settled;
+        if (!drained)
+            lowest = std::min(lowest, lane->processedSlot.load());
+    }
+    if (lowest <= 1 || lowest - 1 <= checkpointSlot_)
+        return;
+
+    checkpointSlot_ = lowest - 1;
+    if (checkpointKey_.empty())
+        return;
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastCheckpointWrite_ >= CHECKPOINT_INTERVAL) {
+        storage_.storeCheckpoint(checkpointKey_, checkpointSlot_);
+        lastCheckpointWrite_ = now;
+    }
+}
+
+uint64_t IngestPipeline::getReceivedSlot(size_t lane) const
+{
+    return lanes_[lane]->receivedSlot;
+}
+
+uint64_t IngestPipeline::getProcessedSlot(size_t lane) const
+{
+    return lanes_[lane]->processedSlot;
+}
+
+uint64_t IngestPipeline::getTransactions(size_t lane) const
+{
+    return lanes_[lane]->transactions;
+}
+
+uint64_t IngestPipeline::getTotalTransactions() const
+{
+    uint64_t total = 0;
+    for (const auto& lane : lanes_) {
+        total += lane->transactions;
+    }
+    return total;
+}
+
+uint64_t IngestPipeline::getProcessedBatches() const
+{
+    return processedBatches_;
+}
+
+uint64_t IngestPipeline::getDuplicateTransactions() const
+{
+    return duplicates_;
+}
+
+uint64_t IngestPipeline::getCheckpointSlot() const
+{
+    return checkpointSlot_;
+}
+
+double IngestPipeline::getBytesCopiedPerTransaction() const
+{
+    uint64_t transactions = getTotalTransactions();
+    if (transactions == 0)
+        return 0.0;
+    return static_cast<double>(totalBytesCopied_) / transactions;
+}
+
+json IngestPipeline::getStats() const
+{
+    json stats;
+    json decoders = json::array();
+    json filters = json::array();
+    for (const auto& lane : lanes_) {
+        decoders.push_back(linkStats(lane->input));
+        filters.push_back(linkStats(lane->output));
+    }
+    stats["decode"] = decoders;
+    stats["filter"] = filters;
+    stats["sink"] = linkStats(sink_);
+    stats["account_updates"] = accountUpdates_.load();
+    if (reorder_)
+        stats["reorder"] = reorder_->getStats();
+    stats["latency_us"] = tracer_.toJson();
+    return stats;
+}
+}
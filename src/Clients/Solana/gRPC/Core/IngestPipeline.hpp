@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/support/byte_buffer.h>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "AccountCache.hpp"
+#include "EventBus.hpp"
+#include "FeedRace.hpp"
+#include "FilterManager.hpp"
+#include "IngestTracer.hpp"
+#include "NotificationManager.hpp"
+#include "SlotReorderBuffer.hpp"
+#include "SpscRing.hpp"
+#include "StorageManager.hpp"
+#include "TransactionBatch.hpp"
+#include "TxRingPublisher.hpp"
+
+namespace solana {
+
+// Everything a Geyser source does with a frame after it leaves the network:
+// per-lane decoders parse and dedup, one filter stage runs FilterManager and
+// one sink stage stores, notifies and checkpoints. Stages are linked by
+// bounded rings, so a slow stage pushes back on (or sheds load from) the
+// one before it instead of stalling the completion queue indefinitely.
+class IngestPipeline {
+public:
+    enum class OverflowPolicy { BLOCK, DROP_OLDEST, SAMPLE };
+
+    struct Options {
+        size_t lanes { 1 };
+        size_t queueCapacity { 64 };
+        OverflowPolicy overflowPolicy { OverflowPolicy::BLOCK };
+        uint32_t sampleRate { 10 };
+        // Puts transactions back into slot order before the filter stage.
+        std::optional<SlotReorderBuffer::Options> reorder;
+    };
+
+    // receivedUs is read from FeedRace::nowMicros() when the frame comes
+    // off the network, so the race is not skewed by batching and queueing.
+    struct Frame {
+        grpc::ByteBuffer buffer;
+        uint64_t receivedUs { 0 };
+    };
+    using FrameBatch = std::vector<Frame>;
+
+    // An empty checkpointKey keeps the checkpoint in memory only. Account
+    // updates are dropped unless an account cache is given, and delivered
+    // transactions are only published to shared memory given a ring.
+    IngestPipeline(const std::string& sourceId, const std::string& endpoint,
+        const Options& options, std::shared_ptr<FeedRace> race,
+        std::shared_ptr<AccountCache> accounts,
+        std::shared_ptr<TxRingPublisher> ring, FilterManager& filter,
+        StorageManager& storage, NotificationManager& notifier,
+        const std::string& checkpointKey, uint64_t checkpointSlot);
+    ~IngestPipeline();
+
+    // Called only by the network thread that owns the lane, receivedAt
+    // being when the oldest of the frames arrived. Returns false when the
+    // batch was shed or the pipeline is closed.
+    bool submit(size_t lane, std::unique_ptr<FrameBatch> frames,
+        std::chrono::steady_clock::time_point receivedAt);
+    // Sheds further submits, then drains and joins the stages in order.
+    void close();
+    // Before a lane's stream is resubscribed with from_slot.
+    void markReplay();
+
+    uint64_t getReceivedSlot(size_t lane) const;
+    uint64_t getProcessedSlot(size_t lane) const;
+    uint64_t getTransactions(size_t lane) const;
+    uint64_t getTotalTransactions() const;
+    uint64_t getProcessedBatches() const;
+    uint64_t getDuplicateTransactions() const;
+    uint64_t getCheckpointSlot() const;
+    double getBytesCopiedPerTransaction() const;
+    json getStats() const;
+
+    const IngestTracer& getTracer() const
+    {
+        return tracer_;
+    }
+
+    static OverflowPolicy parseOverflowPolicy(const std::string& name);
+
+    // Published from the stage threads.
+    Event<const nlohmann::json&> batchProcessed;
+    Event<const nlohmann::json&> slotClosed;
+    Event<const std::string&> error;
+
+private:
+    static constexpr size_t DEDUP_WINDOW_SLOTS = 32;
+    static constexpr size_t DEDUP_SLOT_CAPACITY = 16384;
+    static constexpr std::chrono::seconds CHECKPOINT_INTERVAL { 1 };
+    // A frame batch is split once this many slots closed inside it.
+    static constexpr size_t SLOT_EVENTS = 8;
+
+    struct FrameItem {
+        std::unique_ptr<FrameBatch> frames;
+        std::chrono::steady_clock::time_point submittedAt;
+        std::chrono::steady_clock::time_point receivedAt;
+    };
+
+    struct LaneBatch {
+        size_t lane { 0 };
+        std::unique_ptr<TransactionBatch> batch;
+        std::chrono::steady_clock::time_point submittedAt;
+        size_t hits { 0 };
+        // The lanes the reorder stage merged it from; empty when all of it
+        // came from lane.
+        std::vector<SlotReorderBuffer::LaneShare> lanes;
+        // Closing slot events, kept inline so batches do not allocate.
+        std::array<SlotReorderBuffer::SlotEvent, SLOT_EVENTS> slotEvents {};
+        size_t slotEventCount { 0 };
+        std::chrono::steady_clock::time_point receivedAt;
+        std::chrono::steady_clock::time_point filteredAt;
+    };
+
+    // One edge of the pipeline. The consumer bumps `space` on every pop so
+    // a blocked producer can sleep on it; drops count shed items and the
+    // frames or transactions inside them.
+    template <typename T>
+    struct Link {
+        explicit Link(size_t capacity)
+            : ring(capacity)
+        {
+        }
+
+        SpscRing<T> ring;
+        std::atomic<uint32_t> space { 0 };
+        // Producers shed instead of blocking once set.
+        std::atomic<bool> closed { false };
+        std::atomic<uint64_t> drops { 0 };
+        std::atomic<uint64_t> droppedItems { 0 };
+        uint64_t overflows { 0 };
+    };
+
+    struct Lane {
+        explicit Lane(size_t capacity)
+            : input(capacity)
+            , output(capacity)
+        {
+        }
+
+        Link<FrameItem> input;
+        Link<LaneBatch> output;
+        std::atomic<uint32_t> bell { 0 };
+        std::jthread decoder;
+        std::atomic<bool> decoding { false };
+        std::atomic<bool> submitting { false };
+        std::atomic<uint64_t> receivedSlot { 0 };
+        std::atomic<uint64_t> processedSlot { 0 };
+        std::atomic<uint64_t> transactions { 0 };
+        // Of those, the ones delivered or shed after decoding.
+        std::atomic<uint64_t> settled { 0 };
+    };
+
+    template <typename T>
+    bool push(Link<T>& link, T item, std::atomic<uint32_t>& bell);
+    template <typename T>
+    bool pop(Link<T>& link, T& item);
+    template <typename T>
+    void recordDrop(Link<T>& link, const T& item);
+    template <typename T>
+    static json linkStats(const Link<T>& link);
+
+    void runDecoder(Lane& lane, size_t index);
+    void runFilter();
+    void runSink();
+    // Decodes frames from begin into item; returns where it stopped.
+    size_t decode(
+        Lane& lane, const FrameBatch& frames, size_t begin, LaneBatch& item);
+    void filterBatch(LaneBatch item);
+    bool idle(const Lane& lane) const;
+    void settle(const LaneBatch& item, size_t transactions);
+    void releaseSlots(bool flush);
+    void deliver(LaneBatch& item);
+    void updateCheckpoint();
+
+    std::string sourceId_;
+    Options options_;
+    std::shared_ptr<FeedRace> race_;
+    uint16_t endpointId_ { 0 };
+    std::shared_ptr<AccountCache> accounts_;
+    std::shared_ptr<TxRingPublisher> ring_;
+    std::unique_ptr<SlotReorderBuffer> reorder_;
+    FilterManager& filter_;
+    StorageManager& storage_;
+    NotificationManager& notification_;
+
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::atomic<uint32_t> filterBell_ { 0 };
+    Link<LaneBatch> sink_;
+    std::atomic<uint32_t> sinkBell_ { 0 };
+    std::jthread filterStage_;
+    std::jthread sinkStage_;
+    std::atomic<bool> closed_ { false };
+    std::atomic<bool> decodersDone_ { false };
+    std::atomic<bool> filterDone_ { false };
+
+    std::string checkpointKey_;
+    std::atomic<uint64_t> checkpointSlot_ { 0 };
+    std::chrono::steady_clock::time_point lastCheckpointWrite_;
+
+    std::atomic<uint64_t> processedBatches_ { 0 };
+    std::atomic<uint64_t> totalBytesCopied_ { 0 };
+    std::atomic<uint64_t> duplicates_ { 0 };
+    std::atomic<uint64_t> accountUpdates_ { 0 };
+    IngestTracer tracer_;
+};
+}
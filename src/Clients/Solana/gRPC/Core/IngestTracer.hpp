@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "LatencyHistogram.hpp"
+
+namespace solana {
+
+/**
+ * Per-stage latency of one source's ingest path, in microseconds from the
+ * monotonic clock. Timestamps travel with each batch, so every stage gets
+ * one sample per batch; the receive hop is the oldest frame of the batch,
+ * which makes the percentiles an upper bound on what a transaction in it
+ * saw. Stages:
+ *
+ *   buffer      frame received to batch flushed by the network thread
+ *   queue       flushed to filter start: decode, dedup and slot reorder
+ *   filter      FilterManager::processBatch
+ *   sink_queue  filter done to the sink stage picking the batch up
+ *   store       StorageManager::storeBatch
+ *   notify      NotificationManager::sendBatchNotifications
+ *   end_to_end  frame received to notified
+ */
+class IngestTracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum Stage : size_t {
+        BUFFER,
+        QUEUE,
+        FILTER,
+        SINK_QUEUE,
+        STORE,
+        NOTIFY,
+        END_TO_END,
+        STAGE_COUNT
+    };
+
+    static const char* stageName(Stage stage)
+    {
+        static constexpr const char* names[STAGE_COUNT] = { "buffer", "queue",
+            "filter", "sink_queue", "store", "notify", "end_to_end" };
+        return names[stage];
+    }
+
+    void record(Stage stage, Clock::time_point from, Clock::time_point to)
+    {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+            to - from)
+                      .count();
+        stages_[stage].record(static_cast<uint64_t>(std::max<int64_t>(0, us)));
+    }
+
+    const LatencyHistogram& get(Stage stage) const
+    {
+        return stages_[stage];
+    }
+
+    void merge(const IngestTracer& other)
+    {
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            stages_[i].merge(other.stages_[i]);
+        }
+    }
+
+    json toJson() const
+    {
+        json stats;
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            stats[stageName(static_cast<Stage>(i))] = stages_[i].toJson();
+        }
+        return stats;
+    }
+
+private:
+    std::array<LatencyHistogram, STAGE_COUNT> stages_ {};
+};
+}
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace solana {
+
+/**
+ * Lock-free log-linear histogram in the spirit of HdrHistogram. Values below
+ * 64 get exact buckets; above that every power of two is split into 32 linear
+ * sub-buckets, which bounds the relative error of any reported percentile to
+ * about 3%. Recording is a handful of relaxed atomic increments.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;
+    static constexpr uint64_t LINEAR_LIMIT = SUB_BUCKETS * 2;
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr uint64_t MAX_VALUE = (1ull << (MAX_EXPONENT + 1)) - 1;
+    static constexpr size_t BUCKET_COUNT = LINEAR_LIMIT
+        + (MAX_EXPONENT - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    void record(uint64_t value)
+    {
+        value = std::min(value, MAX_VALUE);
+        buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (value > max
+            && !max_.compare_exchange_weak(
+                max, value, std::memory_order_relaxed)) { }
+    }
+
+    void merge(const LatencyHistogram& other)
+    {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            uint64_t n = other.buckets_[i].load(std::memory_order_relaxed);
+            if (n)
+                buckets_[i].fetch_add(n, std::memory_order_relaxed);
+        }
+        count_.fetch_add(other.getCount(), std::memory_order_relaxed);
+        sum_.fetch_add(
+            other.sum_.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        uint64_t otherMax = other.getMax();
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (otherMax > max
+            && !max_.compare_exchange_weak(
+                max, otherMax, std::memory_order_relaxed)) { }
+    }
+
+    uint64_t getCount() const
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t getMax() const
+    {
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t getSum() const
+    {
+        return sum_.load(std::memory_order_relaxed);
+    }
+
+    double getMean() const
+    {
+        uint64_t count = getCount();
+        if (count == 0)
+            return 0.0;
+        return static_cast<double>(sum_.load(std::memory_order_relaxed))
+            / count;
+    }
+
+    uint64_t percentile(double quantile) const
+    {
+        uint64_t count = getCount();
+        if (count == 0)
+            return 0;
+
+        auto target = static_cast<uint64_t>(
+            std::ceil(std::clamp(quantile, 0.0, 1.0) * count));
+        target = std::max<uint64_t>(target, 1);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= target)
+                return std::min(bucketMidpoint(i), getMax());
+        }
+        return getMax();
+    }
+
+    json toJson() const
+    {
+        return { { "count", getCount() }, { "mean", getMean() },
+            { "p50", percentile(0.50) }, { "p90", percentile(0.90) },
+            { "p99", percentile(0.99) }, { "p999", percentile(0.999) },
+            { "max", getMax() } };
+    }
+
+private:
+    static size_t bucketIndex(uint64_t value)
+    {
+        if (value < LINEAR_LIMIT)
+            return static_cast<size_t>(value);
+        int exponent = std::bit_width(value) - 1;
+        uint64_t group = exponent - SUB_BUCKET_BITS - 1;
+        uint64_t sub = (value >> (exponent - SUB_BUCKET_BITS))
+            & (SUB_BUCKETS - 1);
+        return static_cast<size_t>(LINEAR_LIMIT + group * SUB_BUCKETS + sub);
+    }
+
+    static uint64_t bucketMidpoint(size_t index)
+    {
+        if (index < LINEAR_LIMIT)
+            return index;
+        uint64_t group = (index - LINEAR_LIMIT) / SUB_BUCKETS;
+        uint64_t sub = (index - LINEAR_LIMIT) % SUB_BUCKETS;
+        int exponent = static_cast<int>(group) + SUB_BUCKET_BITS + 1;
+        uint64_t width = 1ull << (exponent - SUB_BUCKET_BITS);
+        uint64_t lower = (1ull << exponent) | (sub * width);
+        return lower + width / 2;
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_ {};
+    std::atomic<uint64_t> count_ { 0 };
+    std::atomic<uint64_t> sum_ { 0 };
+    std::atomic<uint64_t> max_ { 0 };
+};
+}
@@ -18,12 +18,62 @@
 
 #include "MetricsManager.hpp"
 
+#include <utility>
+
+#include <prometheus/collectable.h>
+#include <prometheus/metric_family.h>
+
 #include "../Utils/Logger.hpp"
 
 namespace solana {
 
-MetricsManager::MetricsManager(uint16_t port, QObject* parent)
-    : QObject(parent)
+// Turns the pipelines' log-linear histograms into a Prometheus summary at
+// scrape time, so recording never touches prometheus-cpp.
+class LatencyCollector : public prometheus::Collectable {
+public:
+    void setSource(std::function<void(const MetricsManager::LatencyVisitor&)>
+            source)
+    {
+        std::lock_guard lock(mutex_);
+        source_ = std::move(source);
+    }
+
+    std::vector<prometheus::MetricFamily> Collect() const override
+    {
+        prometheus::MetricFamily family;
+        family.name = "solana_ingest_stage_latency_seconds";
+        family.help = "Ingest latency by source and pipeline stage";
+        family.type = prometheus::MetricType::Summary;
+
+        std::lock_guard lock(mutex_);
+        if (!source_)
+            return {};
+        source_([&family](const std::string& sourceId,
+                    const IngestTracer& tracer) {
+            for (size_t i = 0; i < IngestTracer::STAGE_COUNT; ++i) {
+                auto stage = static_cast<IngestTracer::Stage>(i);
+                const auto& histogram = tracer.get(stage);
+                prometheus::ClientMetric metric;
+                metric.label = { { "source_id", sourceId },
+                    { "stage", IngestTracer::stageName(stage) } };
+                metric.summary.sample_count = histogram.getCount();
+                metric.summary.sample_sum = histogram.getSum() / 1e6;
+                for (double quantile : { 0.5, 0.9, 0.99, 0.999 }) {
+                    metric.summary.quantile.push_back({ quantile,
+                        histogram.percentile(quantile) / 1e6 });
+                }
+                family.metric.push_back(std::move(metric));
+            }
+        });
+        return { std::move(family) };
+    }
+
+private:
+    std::function<void(const MetricsManager::LatencyVisitor&)> source_;
+    mutable std::mutex mutex_;
+};
+
+MetricsManager::MetricsManager(uint16_t port)
 {
     try {
         registry_ = std::make_shared<prometheus::Registry>();
@@ -49,9 +99,27 @@ MetricsManager::MetricsManager(uint16_t port, QObject* parent)
                          "0=disconnected)")
                    .Register(*registry_);
 
+        // Initialize adaptive batch size gauge family
+        batch_size_family_
+            = &prometheus::BuildGauge()
+                   .Name("solana_batch_size")
+                   .Help("Current adaptive batch size by source and shard")
+                   .Register(*registry_);
+
+        // Initialize batch flush counter family
+        batch_flushes_family_
+            = &prometheus::BuildCounter()
+                   .Name("solana_batch_flushes_total")
+                   .Help("Batch flushes by source and reason (size, deadline)")
+                   .Register(*registry_);
+
+        latencyCollector_ = std::make_shared<LatencyCollector>();
+
         // Start Prometheus exposer
-        prometheus::Exposer exposer { "0.hover" };
-        exposer.RegisterCollectable(registry_);
+        exposer_ = std::make_unique<prometheus::Exposer>(
+            "0.0.0.0:" + std::to_string(port));
+        exposer_->RegisterCollectable(registry_);
+        exposer_->RegisterCollectable(latencyCollector_);
         Logger::getLogger()->info(
             "MetricsManager initialized on port {}", port);
 
@@ -63,6 +131,13 @@ MetricsManager::MetricsManager(uint16_t port, QObject* parent)
 
 MetricsManager::~MetricsManager() = default;
 
+void MetricsManager::setLatencySource(
+    std::function<void(const LatencyVisitor&)> source)
+{
+    if (latencyCollector_)
+        latencyCollector_->setSource(std::move(source));
+}
+
 void MetricsManager::incrementTransactionCount(
     const std::string& sourceId, uint64_t count)
 {
@@ -71,8 +146,7 @@ void MetricsManager::incrementTransactionCount(
         auto& counter
             = transaction_counter_family_->Add({ { "source_id", sourceId } });
         counter.Increment(count);
-        Q_EMIT metricsUpdated(
-            QString::fromStdString("solana_transactions_total"), count);
+        metricsUpdated.publish("solana_transactions_total", count);
     } catch (const std::exception& e) {
         Logger::getLogger()->error(
             "Failed to increment transaction count: {}", e.what());
@@ -87,8 +161,7 @@ void MetricsManager::incrementFilterHits(
         auto& counter
             = filter_hits_family_->Add({ { "filter_name", filterName } });
         counter.Increment(hits);
-        Q_EMIT metricsUpdated(
-            QString::fromStdString("solana_filter_hits_total"), hits);
+        metricsUpdated.publish("solana_filter_hits_total", hits);
     } catch (const std::exception& e) {
         Logger::getLogger()->error(
             "Failed to increment filter hits: {}", e.what());
@@ -103,12 +176,70 @@ void MetricsManager::setConnectionStatus(
         auto& gauge
             = connection_status_family_->Add({ { "source_id", sourceId } });
         gauge.Set(connected ? 1.0 : 0.0);
-        Q_EMIT metricsUpdated(
-            QString::fromStdString("solana_connection_status"),
-            connected ? 1.0 : 0.0);
+        metricsUpdated.publish(
+            "solana_connection_status", connected ? 1.0 : 0.0);
     } catch (const std::exception& e) {
         Logger::getLogger()->error(
             "Failed to set connection status: {}", e.what());
     }
 }
+
+void MetricsManager::setBatchSize(
+    const std::string& sourceId, size_t shard, uint64_t batchSize)
+{
+    try {
+        std::lock_guard lock(mutex_);
+        auto& gauge = batch_size_family_->Add(
+            { { "source_id", sourceId }, { "shard", std::to_string(shard) } });
+        gauge.Set(static_cast<double>(batchSize));
+        metricsUpdated.publish("solana_batch_size", batchSize);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error("Failed to set batch size: {}", e.what());
+    }
+}
+
+void MetricsManager::incrementBatchFlushes(
+    const std::string& sourceId, const std::string& reason, uint64_t count)
+{
+    try {
+        std::lock_guard lock(mutex_);
+        auto& counter = batch_flushes_family_->Add(
+            { { "source_id", sourceId }, { "reason", reason } });
+        counter.Increment(count);
+        metricsUpdated.publish("solana_batch_flushes_total", count);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error(
+            "Failed to increment batch flushes: {}", e.what());
+    }
+}
+
+void MetricsManager::updateDataSourceStats(const nlohmann::json& stats)
+{
+    if (!stats.contains("workers"))
+        return;
+
+    for (const auto& [sourceId, worker] : stats["workers"].items()) {
+        setConnectionStatus(sourceId, worker.value("connected", false));
+        std::map<std::string, uint64_t> flushes;
+        auto shards = worker.value("shards", nlohmann::json::array());
+        for (const auto& shard : shards) {
+            setBatchSize(sourceId, shard.value("index", size_t { 0 }),
+                shard.value("batch_size", uint64_t { 0 }));
+            for (const auto& [reason, count] : shard["flushes"].items()) {
+                flushes[reason] += count.get<uint64_t>();
+            }
+        }
+        // Workers report running totals; the counters only take deltas.
+        for (const auto& [reason, total] : flushes) {
+            uint64_t previous = 0;
+            {
+                std::lock_guard lock(mutex_);
+                auto& last = lastFlushes_[{ sourceId, reason }];
+                previous = std::exchange(last, total);
+            }
+            if (total > previous)
+                incrementBatchFlushes(sourceId, reason, total - previous);
+        }
+    }
+}
 }
@@ -18,9 +18,11 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
-
-#include <QObject>
+#include <string>
 
 #include <prometheus/counter.h>
 #include <prometheus/exposer.h>
@@ -28,27 +30,49 @@
 #include <prometheus/gauge.h>
 #include <prometheus/registry.h>
 
+#include <nlohmann/json.hpp>
+
+#include "EventBus.hpp"
+#include "IngestTracer.hpp"
+
 namespace solana {
 
-class MetricsManager : public QObject {
-    Q_OBJECT
+class LatencyCollector;
 
+class MetricsManager {
 public:
-    MetricsManager(uint16_t port = 9090, QObject* parent = nullptr);
+    MetricsManager(uint16_t port = 9090);
     ~MetricsManager();
 
     void incrementTransactionCount(const std::string& sourceId, uint64_t count);
     void incrementFilterHits(const std::string& filterName, uint64_t hits);
     void setConnectionStatus(const std::string& sourceId, bool connected);
+    void setBatchSize(
+        const std::string& sourceId, size_t shard, uint64_t batchSize);
+    void incrementBatchFlushes(
+        const std::string& sourceId, const std::string& reason, uint64_t count);
+    void updateDataSourceStats(const nlohmann::json& stats);
+
+    using LatencyVisitor = std::function<void(
+        const std::string& sourceId, const IngestTracer& tracer)>;
+    // Stage latencies are read on every scrape by calling source with a
+    // visitor, e.g. DataSourceManager::visitLatency. The source has to
+    // stay valid until it is replaced or the manager is destroyed.
+    void setLatencySource(std::function<void(const LatencyVisitor&)> source);
 
-Q_SIGNALS:
-    void metricsUpdated(const QString& metricName, double value);
+    Event<const std::string&, double> metricsUpdated;
 
 private:
     std::shared_ptr<prometheus::Registry> registry_;
     prometheus::Family<prometheus::Counter>* transaction_counter_family_;
     prometheus::Family<prometheus::Counter>* filter_hits_family_;
     prometheus::Family<prometheus::Gauge>* connection_status_family_;
+    prometheus::Family<prometheus::Gauge>* batch_size_family_;
+    prometheus::Family<prometheus::Counter>* batch_flushes_family_;
+    std::map<std::pair<std::string, std::string>, uint64_t> lastFlushes_;
+    std::shared_ptr<LatencyCollector> latencyCollector_;
     mutable std::mutex mutex_;
+    // Last, so scrapes stop before anything they read goes away.
+    std::unique_ptr<prometheus::Exposer> exposer_;
 };
 }
@@ -18,46 +18,39 @@
 
 #include "NotificationManager.hpp"
 
-#include <QEventLoop>
-#include <QNetworkReply>
-
+#include "../HTTP/HttpClient.hpp"
 #include "../Utils/Logger.hpp"
 
 namespace solana {
 
 class TelegramPlugin : public NotificationPlugin {
 public:
-    TelegramPlugin(const QString& botToken, const QString& chatId)
+    TelegramPlugin(const std::string& botToken, const std::string& chatId)
         : botToken_(botToken)
         , chatId_(chatId)
     {
-        networkManager_.setTransferTimeout(10000);
     }
 
-    bool sendNotification(const QString& message) override
+    bool sendNotification(const std::string& message) override
     {
         constexpr int MAX_RETRIES = 3;
         for (int retry = 0; retry < MAX_RETRIES; ++retry) {
-            QString url = QString("https://api.telegram.org/bot%1/sendMessage")
-                              .arg(botToken_);
-            QNetworkRequest request { QUrl(url) };
-            request.setHeader(
-                QNetworkRequest::ContentTypeHeader, "application/json");
+            std::string url
+                = "https://api.telegram.org/bot" + botToken_ + "/sendMessage";
 
             json json;
-            json["chat_id"] = chatId_.toStdString();
-            json["text"] = message.toStdString();
+            json["chat_id"] = chatId_;
+            json["text"] = message;
             json["parse_mode"] = "HTML";
 
-            QEventLoop loop;
-            auto reply = std::unique_ptr<QNetworkReply>(networkManager_.post(
-                request, QByteArray::fromStdString(json.dump())));
-
-            QObject::connect(reply.get(), &QNetworkReply::finished, &loop,
-                &QEventLoop::quit);
-            loop.exec();
-
-            bool success = reply->error() == QNetworkReply::NoError;
+            bool success = false;
+            try {
+                unsigned status = client_.postJson(url, json.dump());
+                success = status >= 200 && status < 300;
+            } catch (const std::exception& e) {
+                Logger::getLogger()->debug("Telegram request failed: {}",
+                    e.what());
+            }
 
             if (success) {
                 ++successCount_;
@@ -92,41 +85,35 @@ public:
     }
 
 private:
-    QString botToken_;
-    QString chatId_;
+    std::string botToken_;
+    std::string chatId_;
     uint64_t successCount_ { 0 };
     uint64_t failureCount_ { 0 };
-    QNetworkAccessManager networkManager_;
+    HttpClient client_;
 };
 
 class DiscordPlugin : public NotificationPlugin {
 public:
-    explicit DiscordPlugin(const QString& webhookUrl)
+    explicit DiscordPlugin(const std::string& webhookUrl)
         : webhookUrl_(webhookUrl)
     {
-        networkManager_.setTransferTimeout(10000);
     }
 
-    bool sendNotification(const QString& message) override
+    bool sendNotification(const std::string& message) override
     {
         constexpr int MAX_RETRIES = 3;
         for (int retry = 0; retry < MAX_RETRIES; ++retry) {
-            QNetworkRequest request { QUrl(webhookUrl_) };
-            request.setHeader(
-                QNetworkRequest::ContentTypeHeader, "application/json");
-
             json json;
-            json["content"] = message.toStdString();
-
-            QEventLoop loop;
-            auto reply = std::unique_ptr<QNetworkReply>(networkManager_.post(
-                request, QByteArray::fromStdString(json.dump())));
-
-            QObject::connect(reply.get(), &QNetworkReply::finished, &loop,
-                &QEventLoop::quit);
-            loop.exec();
-
-            bool success = reply->error() == QNetworkReply::NoError;
+            json["content"] = message;
+
+            bool success = false;
+            try {
+                unsigned status = client_.postJson(webhookUrl_, json.dump());
+                success = status >= 200 && status < 300;
+            } catch (const std::exception& e) {
+                Logger::getLogger()->debug("Discord request failed: {}",
+                    e.what());
+            }
 
             if (success) {
                 ++successCount_;
@@ -161,10 +148,10 @@ public:
     }
 
 private:
-    QString webhookUrl_;
+    std::string webhookUrl_;
     uint64_t successCount_ { 0 };
     uint64_t failureCount_ { 0 };
-    QNetworkAccessManager networkManager_;
+    HttpClient client_;
 };
 
 class NotificationWorker {
@@ -179,7 +166,8 @@ public:
         stop();
     }
 
-    void enqueueNotification(const QString& message, NotificationPlugin* plugin)
+    void enqueueNotification(
+        const std::string& message, NotificationPlugin* plugin)
     {
         if (!plugin)
             return;
@@ -190,7 +178,7 @@ public:
 
 private:
     struct NotificationTask {
-        QString message;
+        std::string message;
         NotificationPlugin* plugin;
     };
 
@@ -238,21 +226,17 @@ private:
     bool shouldRun_ { true };
 };
 
-NotificationManager::NotificationManager(
-    const ConfigManager& config, QObject* parent)
-    : QObject(parent)
-    , config_(config)
+NotificationManager::NotificationManager(const ConfigManager& config)
+    : config_(config)
     , notificationsEnabled_(true)
 {
     if (auto telegram = config_.getTelegramConfig()) {
-        addPlugin(std::make_unique<TelegramPlugin>(
-            QString::fromStdString(telegram->first),
-            QString::fromStdString(telegram->second)));
+        addPlugin(
+            std::make_unique<TelegramPlugin>(telegram->first, telegram->second));
     }
 
     if (auto discord = config_.getDiscordConfig()) {
-        addPlugin(
-            std::make_unique<DiscordPlugin>(QString::fromStdString(*discord)));
+        addPlugin(std::make_unique<DiscordPlugin>(*discord));
     }
 
     worker_ = std::make_unique<NotificationWorker>();
@@ -262,21 +246,26 @@ NotificationManager::~NotificationManager() = default;
 
 void NotificationManager::addPlugin(std::unique_ptr<NotificationPlugin> plugin)
 {
-    std::lock_guard lock(mutex_);
-    plugins_[plugin->name()] = std::move(plugin);
-    Logger::getLogger()->info("Notification plugin added: {}", plugin->name());
-    Q_EMIT pluginAdded(QString::fromStdString(plugin->name()));
+    std::string name = plugin->name();
+    {
+        std::lock_guard lock(mutex_);
+        plugins_[name] = std::move(plugin);
+    }
+    Logger::getLogger()->info("Notification plugin added: {}", name);
+    pluginAdded.publish(name);
 }
 
 void NotificationManager::removePlugin(const std::string& name)
 {
-    std::lock_guard lock(mutex_);
-    plugins_.erase(name);
+    {
+        std::lock_guard lock(mutex_);
+        plugins_.erase(name);
+    }
     Logger::getLogger()->info("Notification plugin removed: {}", name);
-    Q_EMIT pluginRemoved(QString::fromStdString(name));
+    pluginRemoved.publish(name);
 }
 
-void NotificationManager::sendBatchNotifications(const QString& message)
+void NotificationManager::sendBatchNotifications(const std::string& message)
 {
     if (!notificationsEnabled_)
         return;
@@ -22,16 +22,15 @@
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
 
-#include <QNetworkAccessManager>
-#include <QObject>
-
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
 #include "ConfigManager.hpp"
+#include "EventBus.hpp"
 
 namespace solana {
 
@@ -40,32 +39,27 @@ class NotificationWorker;
 class NotificationPlugin {
 public:
     virtual ~NotificationPlugin() = default;
-    virtual bool sendNotification(const QString& message) = 0;
+    virtual bool sendNotification(const std::string& message) = 0;
     virtual std::string name() const = 0;
     virtual uint64_t getSuccessCount() const = 0;
     virtual uint64_t getFailureCount() const = 0;
 };
 
-class NotificationManager : public QObject {
-    Q_OBJECT
-
+class NotificationManager {
 public:
-    explicit NotificationManager(
-        const ConfigManager& config, QObject* parent = nullptr);
+    explicit NotificationManager(const ConfigManager& config);
     ~NotificationManager();
 
     void addPlugin(std::unique_ptr<NotificationPlugin> plugin);
     void removePlugin(const std::string& name);
-    void sendBatchNotifications(const QString& message);
+    void sendBatchNotifications(const std::string& message);
     void setNotificationsEnabled(bool enabled);
     json getNotificationStats() const;
 
-Q_SIGNALS:
-    void notificationSent(const QString& pluginName, bool success);
-    void notificationError(
-        const QString& pluginName, const QString& errorMessage);
-    void pluginAdded(const QString& name);
-    void pluginRemoved(const QString& name);
+    Event<const std::string&, bool> notificationSent;
+    Event<const std::string&, const std::string&> notificationError;
+    Event<const std::string&> pluginAdded;
+    Event<const std::string&> pluginRemoved;
 
 private:
     std::map<std::string, std::unique_ptr<NotificationPlugin>> plugins_;
@@ -0,0 +1,436 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PnlEngine.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace solana {
+
+namespace {
+    const Pubkey WSOL_MINT
+        = *Pubkey::fromBase58("So11111111111111111111111111111111111111112");
+
+    constexpr char SNAPSHOT_MAGIC[8] = { 'P', 'N', 'L', '1', 0, 0, 0, 0 };
+
+    // Snapshots are raw little-endian fields, read back on the same kind
+    // of machine that wrote them.
+    template <typename T> void put(std::string& out, const T& value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    class Reader {
+    public:
+        explicit Reader(std::string_view data)
+            : data_(data)
+        {
+        }
+
+        template <typename T> bool get(T& value)
+        {
+            if (data_.size() < sizeof(T))
+                return false;
+            std::memcpy(&value, data_.data(), sizeof(T));
+            data_.remove_prefix(sizeof(T));
+            return true;
+        }
+
+        size_t remaining() const
+        {
+            return data_.size();
+        }
+
+    private:
+        std::string_view data_;
+    };
+
+    // Fields of a wallet as stored in a snapshot.
+    struct WalletRecord {
+        Pubkey wallet;
+        double realized;
+        double volume;
+        uint32_t buys;
+        uint32_t sells;
+        uint32_t trades;
+        uint32_t wins;
+        uint32_t positions;
+        uint32_t reserved;
+    };
+
+    struct PositionRecord {
+        Pubkey mint;
+        double quantity;
+        double cost;
+        double realized;
+    };
+}
+
+PnlEngine::PnlEngine(size_t shards, uint32_t minTrades)
+    : minTrades_(minTrades)
+    , shards_(std::make_unique<Shard[]>(std::max<size_t>(shards, 1)))
+    , shardCount_(std::max<size_t>(shards, 1))
+{
+}
+
+PnlEngine::Shard& PnlEngine::shardOf(const Pubkey& wallet) const
+{
+    return shards_[PubkeyHash {}(wallet) % shardCount_];
+}
+
+PnlEngine::PriceShard& PnlEngine::priceShardOf(const Pubkey& mint) const
+{
+    // The high bits, so the price shard of a mint does not follow from
+    // the wallet shard of the same key.
+    return priceShards_[(PubkeyHash {}(mint) >> 56) % priceShards_.size()];
+}
+
+std::optional<double> PnlEngine::price(const Pubkey& mint) const
+{
+    PriceShard& shard = priceShardOf(mint);
+    std::lock_guard lock(shard.mutex);
+    auto price = shard.prices.find(mint);
+    if (price == shard.prices.end())
+        return std::nullopt;
+    return price->second;
+}
+
+void PnlEngine::onSwap(const SwapFilter::SwapInfo& swap)
+{
+    if (!swap.hasQuote || swap.quoteMint != WSOL_MINT) {
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    onSwap(swap.wallet, swap.tokenMint, swap.buy, swap.tokenAmount,
+        swap.quoteAmount);
+}
+
+void PnlEngine::onSwap(const Pubkey& wallet, const Pubkey& mint, bool buy,
+    double tokenAmount, double solAmount)
+{
+    if (!(tokenAmount > 0.0) || !(solAmount > 0.0)) {
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    {
+        PriceShard& prices = priceShardOf(mint);
+        std::lock_guard lock(prices.mutex);
+        prices.prices[mint] = solAmount / tokenAmount;
+    }
+    Shard& shard = shardOf(wallet);
+    {
+        std::lock_guard lock(shard.mutex);
+        apply(shard, wallet, mint, buy, tokenAmount, solAmount);
+    }
+    swaps_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PnlEngine::apply(Shard& shard, const Pubkey& wallet, const Pubkey& mint,
+    bool buy, double tokenAmount, double solAmount)
+{
+    auto walletEntry = shard.wallets.try_emplace(wallet).first;
+    const auto index
+        = static_cast<uint32_t>(walletEntry - shard.wallets.begin());
+    WalletState& state = walletEntry->second;
+
+    auto [positionEntry, newPosition]
+        = shard.positions.try_emplace({ index, mint });
+    Position& position = positionEntry->second;
+    if (newPosition) {
+        position.next = state.firstPosition;
+        state.firstPosition
+            = static_cast<uint32_t>(positionEntry - shard.positions.begin());
+    }
+
+    state.volume += solAmount;
+    if (buy) {
+        ++state.buys;
+        position.quantity += tokenAmount;
+        position.cost += solAmount;
+    } else {
+        ++state.sells;
+        const double matched = std::min(tokenAmount, position.quantity);
+        if (matched > 0.0) {
+            const double basis = position.cost * matched / position.quantity;
+            const double pnl = solAmount * matched / tokenAmount - basis;
+            if (matched == position.quantity) {
+                position.quantity = 0.0;
+                position.cost = 0.0;
+            } else {
+                position.quantity -= matched;
+                position.cost -= basis;
+            }
+            position.realized += pnl;
+            state.realized += pnl;
+            ++state.trades;
+            state.wins += pnl > 0.0;
+        }
+    }
+    rank(shard, index);
+}
+
+void PnlEngine::rank(Shard& shard, uint32_t index) const
+{
+    const WalletState& state = (shard.wallets.begin() + index)->second;
+    shard.rankings[static_cast<size_t>(Ranking::RealizedPnl)].set(
+        index, state.realized);
+    shard.rankings[static_cast<size_t>(Ranking::Volume)].set(
+        index, state.volume);
+    if (state.trades >= minTrades_ && state.trades > 0)
+        shard.rankings[static_cast<size_t>(Ranking::WinRate)].set(index,
+            static_cast<double>(state.wins)
+                / static_cast<double>(state.trades));
+}
+
+json PnlEngine::walletJson(
+    const Shard& shard, uint32_t index, bool withPositions) const
+{
+    const auto& [wallet, state] = *(shard.wallets.begin() + index);
+    double unrealized = 0.0;
+    json positions = json::array();
+    for (uint32_t i = state.firstPosition; i != NONE;) {
+        const auto& [key, position] = *(shard.positions.begin() + i);
+        std::optional<double> open;
+        if (position.quantity > 0.0) {
+            if (auto last = price(key.mint)) {
+                open = position.quantity * *last - position.cost;
+                unrealized += *open;
+            }
+        }
+        if (withPositions)
+            positions.push_back({ { "mint", key.mint.toBase58() },
+                { "quantity", position.quantity }, { "cost", position.cost },
+                { "realized_pnl", position.realized },
+                { "unrealized_pnl", open ? json(*open) : json(nullptr) } });
+        i = position.next;
+    }
+    json result = { { "wallet", wallet.toBase58() },
+        { "realized_pnl", state.realized },
+        { "unrealized_pnl", unrealized }, { "volume", state.volume },
+        { "buys", state.buys }, { "sells", state.sells },
+        { "trades", state.trades }, { "wins", state.wins },
+        { "win_rate",
+            state.trades ? static_cast<double>(state.wins)
+                    / static_cast<double>(state.trades)
+                         : 0.0 } };
+    if (withPositions)
+        result["positions"] = std::move(positions);
+    return result;
+}
+
+json PnlEngine::wallet(const Pubkey& wallet) const
+{
+    const Shard& shard = shardOf(wallet);
+    std::lock_guard lock(shard.mutex);
+    auto entry = shard.wallets.find(wallet);
+    if (entry == shard.wallets.end())
+        return nullptr;
+    return walletJson(shard,
+        static_cast<uint32_t>(entry - shard.wallets.begin()), true);
+}
+
+json PnlEngine::leaderboard(Ranking ranking, size_t maxEntries) const
+{
+    // The best maxEntries of each shard hold the best maxEntries overall;
+    // only those that make the cut are formatted.
+    struct Candidate {
+        double score;
+        uint32_t shard;
+        uint32_t index;
+    };
+    std::vector<Candidate> candidates;
+    for (size_t s = 0; s < shardCount_; ++s) {
+        const Shard& shard = shards_[s];
+        std::lock_guard lock(shard.mutex);
+        shard.rankings[static_cast<size_t>(ranking)].top(
+            maxEntries, [&](uint32_t index, double score) {
+                candidates.push_back(
+                    { score, static_cast<uint32_t>(s), index });
+            });
+    }
+    const size_t count = std::min(maxEntries, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + count,
+        candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.score > b.score;
+        });
+    json result = json::array();
+    for (size_t i = 0; i < count; ++i) {
+        const Shard& shard = shards_[candidates[i].shard];
+        std::lock_guard lock(shard.mutex);
+        json entry = walletJson(shard, candidates[i].index, false);
+        entry["rank"] = i + 1;
+        result.push_back(std::move(entry));
+    }
+    return result;
+}
+
+std::optional<PnlEngine::Ranking> PnlEngine::rankingFromName(
+    std::string_view name)
+{
+    if (name == "pnl" || name == "realized_pnl")
+        return Ranking::RealizedPnl;
+    if (name == "volume")
+        return Ranking::Volume;
+    if (name == "win_rate")
+        return Ranking::WinRate;
+    return std::nullopt;
+}
+
+json PnlEngine::getStats() const
+{
+    size_t wallets = 0;
+    size_t positions = 0;
+    size_t bytes = 0;
+    for (size_t s = 0; s < shardCount_; ++s) {
+        const Shard& shard = shards_[s];
+        std::lock_guard lock(shard.mutex);
+        wallets += shard.wallets.size();
+        positions += shard.positions.size();
+        bytes += shard.wallets.values().capacity()
+                * sizeof(std::pair<Pubkey, WalletState>)
+            + shard.positions.values().capacity()
+                * sizeof(std::pair<PositionKey, Position>)
+            + (shard.wallets.bucket_count() + shard.positions.bucket_count())
+                * 8;
+    }
+    return { { "wallets", wallets }, { "positions", positions },
+        { "swaps", swaps_.load(std::memory_order_relaxed) },
+        { "skipped", skipped_.load(std::memory_order_relaxed) },
+        { "approx_bytes", bytes } };
+}
+
+std::string PnlEngine::snapshot() const
+{
+    std::string out(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    // Wallet count, filled in at the end.
+    put(out, uint64_t { 0 });
+    uint64_t wallets = 0;
+    for (size_t s = 0; s < shardCount_; ++s) {
+        const Shard& shard = shards_[s];
+        std::lock_guard lock(shard.mutex);
+        for (const auto& [wallet, state] : shard.wallets) {
+            WalletRecord record { wallet, state.realized, state.volume,
+                state.buys, state.sells, state.trades, state.wins, 0, 0 };
+            for (uint32_t i = state.firstPosition; i != NONE;
+                 i = (shard.positions.begin() + i)->second.next) {
+                ++record.positions;
+            }
+            put(out, record);
+            for (uint32_t i = state.firstPosition; i != NONE;) {
+                const auto& [key, position] = *(shard.positions.begin() + i);
+                put(out,
+                    PositionRecord { key.mint, position.quantity,
+                        position.cost, position.realized });
+                i = position.next;
+            }
+        }
+        wallets += shard.wallets.size();
+    }
+    std::memcpy(out.data() + sizeof(SNAPSHOT_MAGIC), &wallets,
+        sizeof(wallets));
+
+    std::string prices;
+    uint64_t priceCount = 0;
+    for (const auto& shard : priceShards_) {
+        std::lock_guard lock(shard.mutex);
+        for (const auto& [mint, price] : shard.prices) {
+            put(prices, mint);
+            put(prices, price);
+        }
+        priceCount += shard.prices.size();
+    }
+    put(out, priceCount);
+    out += prices;
+    return out;
+}
+
+bool PnlEngine::restore(std::string_view snapshot)
+{
+    Reader reader(snapshot);
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    uint64_t wallets = 0;
+    if (!reader.get(magic)
+        || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0
+        || !reader.get(wallets)
+        || wallets > reader.remaining() / sizeof(WalletRecord))
+        return false;
+
+    // Built aside and swapped in shard by shard, so a bad snapshot leaves
+    // the current state alone.
+    auto fresh = std::make_unique<Shard[]>(shardCount_);
+    for (uint64_t w = 0; w < wallets; ++w) {
+        WalletRecord record;
+        if (!reader.get(record)
+            || record.positions > reader.remaining() / sizeof(PositionRecord))
+            return false;
+        Shard& shard = fresh[PubkeyHash {}(record.wallet) % shardCount_];
+        auto [walletEntry, added] = shard.wallets.try_emplace(record.wallet,
+            WalletState { record.realized, record.volume, record.buys,
+                record.sells, record.trades, record.wins, NONE });
+        if (!added)
+            return false;
+        const auto index
+            = static_cast<uint32_t>(walletEntry - shard.wallets.begin());
+        // Linked in the order they were written, which keeps sums over a
+        // wallet's positions the same after a restore.
+        uint32_t* link = &walletEntry->second.firstPosition;
+        for (uint32_t p = 0; p < record.positions; ++p) {
+            PositionRecord position;
+            reader.get(position);
+            auto [positionEntry, placed]
+                = shard.positions.try_emplace({ index, position.mint },
+                    Position { position.quantity, position.cost,
+                        position.realized, NONE });
+            if (!placed)
+                return false;
+            *link = static_cast<uint32_t>(
+                positionEntry - shard.positions.begin());
+            link = &positionEntry->second.next;
+        }
+        rank(shard, index);
+    }
+
+    uint64_t priceCount = 0;
+    if (!reader.get(priceCount)
+        || priceCount > reader.remaining() / (sizeof(Pubkey) + sizeof(double)))
+        return false;
+    std::array<PubkeyMap<double>, std::tuple_size_v<decltype(priceShards_)>>
+        prices;
+    for (uint64_t i = 0; i < priceCount; ++i) {
+        Pubkey mint;
+        double price = 0.0;
+        reader.get(mint);
+        reader.get(price);
+        prices[&priceShardOf(mint) - priceShards_.data()][mint] = price;
+    }
+
+    for (size_t s = 0; s < shardCount_; ++s) {
+        Shard& shard = shards_[s];
+        std::lock_guard lock(shard.mutex);
+        shard.wallets = std::move(fresh[s].wallets);
+        shard.positions = std::move(fresh[s].positions);
+        shard.rankings = std::move(fresh[s].rankings);
+    }
+    for (size_t s = 0; s < priceShards_.size(); ++s) {
+        std::lock_guard lock(priceShards_[s].mutex);
+        priceShards_[s].prices = std::move(prices[s]);
+    }
+    return true;
+}
+}
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "Pubkey.hpp"
+#include "RankHeap.hpp"
+#include "SwapFilter.hpp"
+
+namespace solana {
+
+/**
+ * Running position and profit of every wallet SwapFilter sees trade,
+ * kept as the swaps arrive instead of replayed from storage.
+ *
+ * Positions are per (wallet, mint) at average cost, in SOL: a buy adds
+ * its tokens and what it paid, a sell takes out its share of that cost
+ * and realizes the difference to what it got. A sell of more than the
+ * wallet is known to hold realizes only the part it held. Each sell that
+ * realizes something is a trade, won when it realized a profit.
+ * Unrealized PnL is priced at the mint's last traded price when read.
+ *
+ * Wallets are spread over shards by hash, each behind its own mutex, so
+ * swaps of different wallets rarely wait on each other; a swap is a hash
+ * lookup and a few additions, plus an O(log n) move in each leaderboard
+ * heap of its shard.
+ */
+class PnlEngine {
+public:
+    enum class Ranking : uint8_t { RealizedPnl, Volume, WinRate };
+
+    // Wallets rank by win rate once they have made minTrades trades.
+    explicit PnlEngine(size_t shards = 16, uint32_t minTrades = 5);
+
+    // Only swaps priced against SOL move positions; the rest are counted
+    // and skipped, as their cost has no value in SOL.
+    void onSwap(const SwapFilter::SwapInfo& swap);
+    void onSwap(const Pubkey& wallet, const Pubkey& mint, bool buy,
+        double tokenAmount, double solAmount);
+
+    // The wallet's totals and open and closed positions, or null if it
+    // never traded.
+    json wallet(const Pubkey& wallet) const;
+    // The best maxEntries wallets by the ranking, best first.
+    json leaderboard(Ranking ranking, size_t maxEntries) const;
+    static std::optional<Ranking> rankingFromName(std::string_view name);
+    json getStats() const;
+
+    // Every wallet and position, for StorageManager; each shard is copied
+    // under its own lock.
+    std::string snapshot() const;
+    // Replaces the state with a snapshot. False, with the state left as
+    // it was, if the snapshot is malformed.
+    bool restore(std::string_view snapshot);
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Position {
+        double quantity { 0.0 };
+        // SOL paid for the tokens still held.
+        double cost { 0.0 };
+        double realized { 0.0 };
+        // The wallet's next position, NONE at the end.
+        uint32_t next { NONE };
+    };
+
+    struct WalletState {
+        double realized { 0.0 };
+        double volume { 0.0 };
+        uint32_t buys { 0 };
+        uint32_t sells { 0 };
+        uint32_t trades { 0 };
+        uint32_t wins { 0 };
+        uint32_t firstPosition { NONE };
+    };
+
+    struct PositionKey {
+        uint32_t wallet;
+        Pubkey mint;
+
+        bool operator==(const PositionKey&) const = default;
+    };
+
+    struct PositionKeyHash {
+        using is_avalanching = void;
+
+        uint64_t operator()(const PositionKey& key) const noexcept
+        {
+            return PubkeyHash {}(key.mint)
+                ^ (key.wallet * 0x9e3779b97f4a7c15ull);
+        }
+    };
+
+    // State is kept in the maps themselves, which store their entries
+    // densely in insertion order and never erase here, so an entry's
+    // offset is a stable id: one lookup reaches key and state together.
+    struct Shard {
+        mutable std::mutex mutex;
+        PubkeyMap<WalletState> wallets;
+        ankerl::unordered_dense::map<PositionKey, Position, PositionKeyHash>
+            positions;
+        // Wallet ids by score.
+        std::array<RankHeap, 3> rankings;
+    };
+
+    struct PriceShard {
+        mutable std::mutex mutex;
+        PubkeyMap<double> prices;
+    };
+
+    Shard& shardOf(const Pubkey& wallet) const;
+    PriceShard& priceShardOf(const Pubkey& mint) const;
+    std::optional<double> price(const Pubkey& mint) const;
+    void apply(Shard& shard, const Pubkey& wallet, const Pubkey& mint,
+        bool buy, double tokenAmount, double solAmount);
+    void rank(Shard& shard, uint32_t index) const;
+    json walletJson(
+        const Shard& shard, uint32_t index, bool withPositions) const;
+
+    const uint32_t minTrades_;
+    std::unique_ptr<Shard[]> shards_;
+    const size_t shardCount_;
+    mutable std::array<PriceShard, 16> priceShards_;
+    std::atomic<uint64_t> swaps_ { 0 };
+    std::atomic<uint64_t> skipped_ { 0 };
+};
+}
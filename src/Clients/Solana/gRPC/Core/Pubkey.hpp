@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <ankerl/unordered_dense.h>
+
+#include "Utils/Base58.hpp"
+
+namespace solana {
+
+/**
+ * A 32-byte account address in binary form. Filters key their lookups on
+ * this rather than on base58 strings, which only appear at the edges:
+ * config files, the HTTP API and logs.
+ */
+struct Pubkey {
+    static constexpr size_t SIZE = 32;
+
+    std::array<uint8_t, SIZE> bytes {};
+
+    // Raw key bytes as they appear on the wire.
+    static std::optional<Pubkey> fromBytes(std::string_view raw)
+    {
+        if (raw.size() != SIZE)
+            return std::nullopt;
+        Pubkey key;
+        std::memcpy(key.bytes.data(), raw.data(), SIZE);
+        return key;
+    }
+
+    // Accepts only the canonical encoding of exactly 32 bytes. Decodes
+    // into fixed limbs, so unlike DecodeBase58 it never allocates.
+    static std::optional<Pubkey> fromBase58(std::string_view text)
+    {
+        // 58^44 > 2^256, so no 32-byte key needs more digits.
+        if (text.empty() || text.size() > 44)
+            return std::nullopt;
+
+        size_t ones = 0;
+        while (ones < text.size() && text[ones] == '1') {
+            ++ones;
+        }
+        // Most significant limb first. Digits are folded in ten at a
+        // time, the most that keeps 58^n within a limb.
+        std::array<uint64_t, SIZE / 8> limbs {};
+        for (size_t pos = 0; pos < text.size();) {
+            uint64_t chunk = 0;
+            uint64_t scale = 1;
+            for (size_t end = std::min(pos + 10, text.size()); pos < end;
+                ++pos) {
+                int digit = mapBase58[static_cast<uint8_t>(text[pos])];
+                if (digit < 0)
+                    return std::nullopt;
+                chunk = chunk * 58 + static_cast<uint64_t>(digit);
+                scale *= 58;
+            }
+            unsigned __int128 carry = chunk;
+            for (size_t i = limbs.size(); i-- > 0;) {
+                carry += static_cast<unsigned __int128>(limbs[i]) * scale;
+                limbs[i] = static_cast<uint64_t>(carry);
+                carry >>= 64;
+            }
+            if (carry)
+                return std::nullopt;
+        }
+
+        Pubkey key;
+        for (size_t i = 0; i < key.bytes.size(); ++i) {
+            key.bytes[i] = static_cast<uint8_t>(
+                limbs[i / 8] >> (56 - 8 * (i % 8)));
+        }
+        // Each leading zero byte is written as one leading '1'; any other
+        // count means the text encodes fewer or more than 32 bytes.
+        size_t zeros = 0;
+        while (zeros < SIZE && key.bytes[zeros] == 0) {
+            ++zeros;
+        }
+        if (zeros != ones)
+            return std::nullopt;
+        return key;
+    }
+
+    std::string toBase58() const
+    {
+        return EncodeBase58(bytes);
+    }
+
+    std::string_view view() const
+    {
+        return { reinterpret_cast<const char*>(bytes.data()), SIZE };
+    }
+
+    bool operator==(const Pubkey&) const = default;
+    auto operator<=>(const Pubkey&) const = default;
+};
+
+// A transaction signature in binary form, for records that keep it
+// without formatting it.
+struct Signature {
+    static constexpr size_t SIZE = 64;
+
+    std::array<uint8_t, SIZE> bytes {};
+
+    // Copies up to 64 raw bytes and zero-fills the rest.
+    static Signature fromBytes(std::string_view raw)
+    {
+        Signature signature;
+        std::memcpy(signature.bytes.data(), raw.data(),
+            std::min(raw.size(), SIZE));
+        return signature;
+    }
+
+    std::string toBase58() const
+    {
+        return EncodeBase58(bytes);
+    }
+};
+
+struct PubkeyHash {
+    using is_avalanching = void;
+
+    uint64_t operator()(const Pubkey& key) const noexcept
+    {
+        // Not just a prefix: vanity program ids share their leading bytes.
+        return ankerl::unordered_dense::detail::wyhash::hash(
+            key.bytes.data(), key.bytes.size());
+    }
+};
+
+using PubkeySet = ankerl::unordered_dense::set<Pubkey, PubkeyHash>;
+
+template <typename T>
+using PubkeyMap = ankerl::unordered_dense::map<Pubkey, T, PubkeyHash>;
+}
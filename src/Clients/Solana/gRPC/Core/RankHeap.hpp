@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace solana {
+
+/**
+ * Max-heap of scores for ids 0..n-1 that also knows where each id sits,
+ * so a changed score moves its id up or down in O(log n) instead of the
+ * whole ranking being sorted again on every read. top() walks the heap
+ * from the root with a small frontier queue and costs O(k log k) for the
+ * k best, however many ids there are.
+ *
+ * Not thread-safe.
+ */
+class RankHeap {
+public:
+    bool contains(uint32_t id) const
+    {
+        return id < position_.size() && position_[id] != ABSENT;
+    }
+
+    size_t size() const
+    {
+        return heap_.size();
+    }
+
+    // Inserts id or moves it to its new score.
+    void set(uint32_t id, double score)
+    {
+        if (id >= position_.size()) {
+            position_.resize(id + 1, ABSENT);
+            scores_.resize(id + 1, 0.0);
+        }
+        if (position_[id] == ABSENT) {
+            position_[id] = static_cast<uint32_t>(heap_.size());
+            heap_.push_back(id);
+            scores_[id] = score;
+            up(position_[id]);
+            return;
+        }
+        const double previous = scores_[id];
+        scores_[id] = score;
+        if (score > previous)
+            up(position_[id]);
+        else
+            down(position_[id]);
+    }
+
+    double score(uint32_t id) const
+    {
+        return scores_[id];
+    }
+
+    // Calls visit(id, score) for the best k ids, best first.
+    template <typename Visit> void top(size_t k, Visit&& visit) const
+    {
+        if (heap_.empty() || k == 0)
+            return;
+        // Heap slots ordered by score: the next best id is always the root
+        // or a child of one already visited.
+        auto worse = [this](uint32_t a, uint32_t b) {
+            return scores_[heap_[a]] < scores_[heap_[b]];
+        };
+        std::priority_queue<uint32_t, std::vector<uint32_t>, decltype(worse)>
+            frontier(worse);
+        frontier.push(0);
+        while (k-- > 0 && !frontier.empty()) {
+            const uint32_t slot = frontier.top();
+            frontier.pop();
+            visit(heap_[slot], scores_[heap_[slot]]);
+            for (uint32_t child = 2 * slot + 1;
+                 child <= 2 * slot + 2 && child < heap_.size(); ++child) {
+                frontier.push(child);
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t ABSENT = UINT32_MAX;
+
+    void place(uint32_t slot, uint32_t id)
+    {
+        heap_[slot] = id;
+        position_[id] = slot;
+    }
+
+    void up(uint32_t slot)
+    {
+        const uint32_t id = heap_[slot];
+        while (slot > 0) {
+            const uint32_t parent = (slot - 1) / 2;
+            if (scores_[heap_[parent]] >= scores_[id])
+                break;
+            place(slot, heap_[parent]);
+            slot = parent;
+        }
+        place(slot, id);
+    }
+
+    void down(uint32_t slot)
+    {
+        const uint32_t id = heap_[slot];
+        const auto size = static_cast<uint32_t>(heap_.size());
+        for (;;) {
+            uint32_t child = 2 * slot + 1;
+            if (child >= size)
+                break;
+            if (child + 1 < size
+                && scores_[heap_[child + 1]] > scores_[heap_[child]])
+                ++child;
+            if (scores_[heap_[child]] <= scores_[id])
+                break;
+            place(slot, heap_[child]);
+            slot = child;
+        }
+        place(slot, id);
+    }
+
+    std::vector<uint32_t> heap_;
+    // By id.
+    std::vector<uint32_t> position_;
+    std::vector<double> scores_;
+};
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "RcuPtr.hpp"
+
+#include <array>
+#include <stdexcept>
+
+namespace solana::rcu {
+
+namespace {
+    struct alignas(64) HazardRecord {
+        std::array<std::atomic<const void*>, HAZARDS_PER_THREAD> hazards {};
+        std::atomic<bool> owned { false };
+        HazardRecord* next { nullptr };
+    };
+
+    // Records are never freed, only handed to the next thread, so writers
+    // can walk the list without synchronizing with threads coming and
+    // going.
+    std::atomic<HazardRecord*> records { nullptr };
+
+    HazardRecord* claimRecord()
+    {
+        for (auto* record = records.load(std::memory_order_acquire); record;
+            record = record->next) {
+            bool owned = false;
+            if (record->owned.compare_exchange_strong(
+                    owned, true, std::memory_order_acquire))
+                return record;
+        }
+        auto* record = new HazardRecord;
+        record->owned.store(true, std::memory_order_relaxed);
+        record->next = records.load(std::memory_order_relaxed);
+        while (!records.compare_exchange_weak(record->next, record,
+            std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return record;
+    }
+
+    struct ThreadHazards {
+        HazardRecord* record { claimRecord() };
+        size_t depth { 0 };
+
+        ~ThreadHazards()
+        {
+            record->owned.store(false, std::memory_order_release);
+        }
+    };
+
+    ThreadHazards& threadHazards()
+    {
+        thread_local ThreadHazards hazards;
+        return hazards;
+    }
+}
+
+std::atomic<const void*>& acquireHazard()
+{
+    auto& hazards = threadHazards();
+    if (hazards.depth == HAZARDS_PER_THREAD)
+        throw std::logic_error("too many RCU snapshots held by one thread");
+    return hazards.record->hazards[hazards.depth++];
+}
+
+void releaseHazard(std::atomic<const void*>& hazard)
+{
+    // Guards are scoped, so the one released is always the newest.
+    hazard.store(nullptr, std::memory_order_release);
+    --threadHazards().depth;
+}
+
+std::vector<const void*> protectedPointers()
+{
+    std::vector<const void*> pointers;
+    for (auto* record = records.load(std::memory_order_acquire); record;
+        record = record->next) {
+        for (const auto& hazard : record->hazards) {
+            if (const void* pointer = hazard.load(std::memory_order_seq_cst))
+                pointers.push_back(pointer);
+        }
+    }
+    std::sort(pointers.begin(), pointers.end());
+    return pointers;
+}
+}
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace solana {
+
+namespace rcu {
+    // Hazard slots of the calling thread, claimed on first use and handed
+    // back when the thread exits. A thread can hold this many snapshots
+    // at once.
+    constexpr size_t HAZARDS_PER_THREAD = 4;
+
+    std::atomic<const void*>& acquireHazard();
+    void releaseHazard(std::atomic<const void*>& hazard);
+
+    // Every pointer some thread currently protects, sorted.
+    std::vector<const void*> protectedPointers();
+}
+
+/**
+ * Read-mostly pointer to an immutable snapshot, for filter configuration
+ * that is read on every transaction and replaced now and then. Readers
+ * publish the snapshot they use in a per-thread hazard slot, which costs
+ * them a store and a re-check and never a lock. Writers build the next
+ * snapshot on their own thread, swap it in and free the old one once no
+ * hazard slot names it any more.
+ */
+template <typename T> class RcuPtr {
+public:
+    class Guard {
+    public:
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard()
+        {
+            rcu::releaseHazard(hazard_);
+        }
+
+        const T& operator*() const
+        {
+            return *snapshot_;
+        }
+
+        const T* operator->() const
+        {
+            return snapshot_;
+        }
+
+    private:
+        friend class RcuPtr;
+
+        explicit Guard(const std::atomic<const T*>& current)
+            : hazard_(rcu::acquireHazard())
+        {
+            // Published and then re-checked, so a writer that swapped the
+            // pointer in between cannot miss the hazard when it frees.
+            const T* snapshot = current.load(std::memory_order_acquire);
+            while (true) {
+                hazard_.store(snapshot, std::memory_order_seq_cst);
+                const T* again = current.load(std::memory_order_seq_cst);
+                if (again == snapshot)
+                    break;
+                snapshot = again;
+            }
+            snapshot_ = snapshot;
+        }
+
+        std::atomic<const void*>& hazard_;
+        const T* snapshot_;
+    };
+
+    explicit RcuPtr(std::unique_ptr<const T> initial)
+        : current_(initial.release())
+    {
+    }
+
+    ~RcuPtr()
+    {
+        delete current_.load(std::memory_order_relaxed);
+        for (const T* snapshot : retired_) {
+            delete snapshot;
+        }
+    }
+
+    RcuPtr(const RcuPtr&) = delete;
+    RcuPtr& operator=(const RcuPtr&) = delete;
+
+    Guard read() const
+    {
+        return Guard(current_);
+    }
+
+    // Builds the next snapshot from a copy of the current one. Updates
+    // are serialized so none of them is lost, but readers keep going on
+    // the old snapshot until the new one is swapped in.
+    template <typename Fn> void update(Fn&& fn)
+    {
+        std::lock_guard lock(writeMutex_);
+        auto next
+            = std::make_unique<T>(*current_.load(std::memory_order_acquire));
+        fn(*next);
+        swap(std::move(next));
+    }
+
+private:
+    void swap(std::unique_ptr<const T> next)
+    {
+        retired_.push_back(
+            current_.exchange(next.release(), std::memory_order_seq_cst));
+        auto hazards = rcu::protectedPointers();
+        std::erase_if(retired_, [&hazards](const T* snapshot) {
+            if (std::binary_search(hazards.begin(), hazards.end(),
+                    static_cast<const void*>(snapshot)))
+                return false;
+            delete snapshot;
+            return true;
+        });
+    }
+
+    std::atomic<const T*> current_;
+    std::mutex writeMutex_;
+    // Swapped out but possibly still read.
+    std::vector<const T*> retired_;
+};
+}
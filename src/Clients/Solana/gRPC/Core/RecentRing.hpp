@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace solana {
+
+/**
+ * Fixed-capacity ring of the most recent items a filter recorded, read
+ * by HTTP handlers while filter threads keep writing. Item n lives in
+ * slot n % capacity, whose version is 2n + 1 while it is written and
+ * 2n + 2 once it is done; readers copy an item and re-check the version,
+ * as with TxRing, so they never block the writer or each other. Slots
+ * are cache-line aligned so a reader polling one slot does not disturb
+ * the writer filling the next.
+ *
+ * push() is single-writer: callers that record from several threads
+ * serialize it among themselves.
+ */
+template <typename T> class RecentRing {
+    static_assert(std::is_trivially_copyable_v<T>,
+        "items are copied while they may be overwritten");
+
+public:
+    explicit RecentRing(size_t capacity)
+        : capacity_(std::bit_ceil(std::max<size_t>(capacity, 2)))
+        , mask_(capacity_ - 1)
+        , slots_(std::make_unique<Slot[]>(capacity_))
+    {
+    }
+
+    // Returns the item's sequence number.
+    uint64_t push(const T& item)
+    {
+        const uint64_t sequence = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[sequence & mask_];
+        slot.version.store(2 * sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.item = item;
+        slot.version.store(2 * sequence + 2, std::memory_order_release);
+        head_.store(sequence + 1, std::memory_order_release);
+        return sequence;
+    }
+
+    // Sequence the next item will get, i.e. how many were pushed.
+    uint64_t head() const
+    {
+        return head_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    // Calls visit(sequence, item) for up to max items from sequence from
+    // on, oldest first, and returns the sequence to pass as from next
+    // time. Items overwritten before they could be read are skipped.
+    template <typename Visit>
+    uint64_t since(uint64_t from, size_t max, Visit&& visit) const
+    {
+        const uint64_t head = this->head();
+        if (head - std::min(from, head) > capacity_)
+            from = head - capacity_;
+        T item;
+        size_t visited = 0;
+        for (; from < head && visited < max; ++from) {
+            if (read(from, item)) {
+                visit(from, item);
+                ++visited;
+            }
+        }
+        return std::min(from, head);
+    }
+
+    // Calls visit(sequence, item) for up to max of the newest items,
+    // newest first, and returns how many it visited.
+    template <typename Visit> size_t latest(size_t max, Visit&& visit) const
+    {
+        const uint64_t head = this->head();
+        const uint64_t oldest = head - std::min<uint64_t>(head, capacity_);
+        T item;
+        size_t visited = 0;
+        for (uint64_t sequence = head; sequence > oldest && visited < max;) {
+            if (read(--sequence, item)) {
+                visit(sequence, item);
+                ++visited;
+            }
+        }
+        return visited;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> version { 0 };
+        T item {};
+    };
+
+    // False when the slot no longer, or not yet, holds that sequence.
+    bool read(uint64_t sequence, T& out) const
+    {
+        const Slot& slot = slots_[sequence & mask_];
+        const uint64_t expected = 2 * sequence + 2;
+        if (slot.version.load(std::memory_order_acquire) != expected)
+            return false;
+        out = slot.item;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.version.load(std::memory_order_relaxed) == expected;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<uint64_t> head_ { 0 };
+};
+}
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ReplayWorker.hpp"
+
+#include <algorithm>
+
+#include "../Utils/Logger.hpp"
+
+namespace solana {
+
+namespace {
+    int64_t steadyNowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+}
+
+ReplayWorker::ReplayWorker(const std::string& sourceId,
+    const ConfigManager::DataSourceConfig& source, StorageManager& storage,
+    NotificationManager& notifier, FilterManager& filter,
+    std::shared_ptr<FeedRace> race, std::shared_ptr<AccountCache> accounts,
+    std::shared_ptr<TxRingPublisher> ring)
+    : DataSourceWorker(source)
+    , sourceId_(sourceId)
+{
+    IngestPipeline::Options options;
+    options.queueCapacity = static_cast<size_t>(source_.queueCapacity);
+    options.overflowPolicy
+        = IngestPipeline::parseOverflowPolicy(source_.overflowPolicy);
+    options.sampleRate = static_cast<uint32_t>(source_.overflowSampleRate);
+    if (source_.reorder) {
+        options.reorder = SlotReorderBuffer::Options {
+            static_cast<size_t>(source_.reorderWindowSlots),
+            std::chrono::milliseconds(source_.reorderTimeoutMs) };
+    }
+    // Replays never resume, so their checkpoint is not persisted.
+    pipeline_ = std::make_unique<IngestPipeline>(sourceId_, source_.address,
+        options, std::move(race), std::move(accounts), std::move(ring),
+        filter, storage, notifier, "", 0);
+    pipeline_->batchProcessed.subscribe([this](const nlohmann::json& data) {
+        dataReceived.publish(sourceId_, data);
+    });
+    pipeline_->slotClosed.subscribe([this](const nlohmann::json& data) {
+        slotClosed.publish(sourceId_, data);
+    });
+    pipeline_->error.subscribe(
+        [this](const std::string& message) { error.publish(message); });
+
+    try {
+        reader_ = std::make_unique<FrameReader>(source_.address);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error("Cannot replay {}: {}", source_.address,
+            e.what());
+        return;
+    }
+    Logger::getLogger()->info("Replaying {} ({} bytes, {} pace)",
+        source_.address, reader_->getSize(), source_.replayPace);
+    thread_ = std::jthread(
+        [this](std::stop_token stoken) { run(std::move(stoken)); });
+}
+
+ReplayWorker::~ReplayWorker()
+{
+    thread_.request_stop();
+    pipeline_->close();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+bool ReplayWorker::isConnected() const
+{
+    return reader_ != nullptr;
+}
+
+uint64_t ReplayWorker::getTotalTransactions() const
+{
+    return pipeline_->getTotalTransactions();
+}
+
+uint64_t ReplayWorker::getProcessedBatches() const
+{
+    return pipeline_->getProcessedBatches();
+}
+
+uint64_t ReplayWorker::getDuplicateTransactions() const
+{
+    return pipeline_->getDuplicateTransactions();
+}
+
+uint64_t ReplayWorker::getReconnects() const
+{
+    return 0;
+}
+
+uint64_t ReplayWorker::getCheckpointSlot() const
+{
+    return pipeline_->getCheckpointSlot();
+}
+
+double ReplayWorker::getBytesCopiedPerTransaction() const
+{
+    return pipeline_->getBytesCopiedPerTransaction();
+}
+
+json ReplayWorker::getShardStats() const
+{
+    int64_t startedAt = startedAtNs_;
+    int64_t finishedAt = finishedAtNs_;
+    int64_t until = finishedAt ? finishedAt : steadyNowNs();
+    double elapsed = startedAt ? (until - startedAt) / 1e9 : 0.0;
+    uint64_t transactions = pipeline_->getTransactions(0);
+
+    json shardStats;
+    shardStats["index"] = 0;
+    shardStats["connected"] = isConnected();
+    shardStats["frames"] = frames_.load();
+    shardStats["transactions"] = transactions;
+    shardStats["batches"] = batches_.load();
+    shardStats["shed_batches"] = shed_.load();
+    shardStats["processed_slot"] = pipeline_->getProcessedSlot(0);
+    shardStats["finished"] = finishedAt != 0;
+    shardStats["elapsed_sec"] = elapsed;
+    shardStats["tx_per_sec"] = elapsed > 0.0 ? transactions / elapsed : 0.0;
+    if (reader_) {
+        shardStats["progress"] = static_cast<double>(reader_->getOffset())
+            / std::max<size_t>(1, reader_->getSize());
+    }
+    return json::array({ shardStats });
+}
+
+json ReplayWorker::getPipelineStats() const
+{
+    return pipeline_->getStats();
+}
+
+const IngestTracer& ReplayWorker::getTracer() const
+{
+    return pipeline_->getTracer();
+}
+
+void ReplayWorker::run(std::stop_token stoken)
+{
+    const bool paced = source_.replayPace == "realtime";
+    const double speed = std::max(source_.replaySpeed, 1e-3);
+    const size_t batchSize = static_cast<size_t>(source_.batchMaxSize);
+
+    auto frames = std::make_unique<IngestPipeline::FrameBatch>();
+    frames->reserve(batchSize);
+    auto startedAt = std::chrono::steady_clock::now();
+    startedAtNs_ = steadyNowNs();
+    uint64_t firstFrameNs = 0;
+
+    FrameReader::Frame frame;
+    while (!stoken.stop_requested() && reader_->next(frame)) {
+        if (paced) {
+            if (firstFrameNs == 0)
+                firstFrameNs = frame.receivedAtNs;
+            auto offset = std::chrono::duration<double, std::nano>(
+                (frame.receivedAtNs - firstFrameNs) / speed);
+            auto due = startedAt
+                + std::chrono::duration_cast<std::chrono::nanoseconds>(offset);
+            if (due > std::chrono::steady_clock::now()) {
+                // Everything read so far was due already; don't hold it
+                // back while waiting for the next frame.
+                submit(frames);
+                if (!waitUntil(due, stoken))
+                    break;
+            }
+        }
+
+        // The mapping outlives the pipeline, so frames can point into it.
+        grpc::Slice slice(frame.bytes.data(), frame.bytes.size(),
+            grpc::Slice::STATIC_SLICE);
+        if (frames->empty())
+            batchOpenedAt_ = std::chrono::steady_clock::now();
+        frames->push_back(
+            { grpc::ByteBuffer(&slice, 1), FeedRace::nowMicros() });
+        ++frames_;
+        if (frames->size() >= batchSize)
+            submit(frames);
+    }
+    submit(frames);
+    finishedAtNs_ = steadyNowNs();
+
+    Logger::getLogger()->info("Replay of {} finished: {} frames in {:.3f}s",
+        source_.address, frames_.load(),
+        (finishedAtNs_ - startedAtNs_) / 1e9);
+}
+
+void ReplayWorker::submit(std::unique_ptr<IngestPipeline::FrameBatch>& frames)
+{
+    if (frames->empty())
+        return;
+
+    ++batches_;
+    auto batch = std::move(frames);
+    frames = std::make_unique<IngestPipeline::FrameBatch>();
+    frames->reserve(batch->size());
+    if (!pipeline_->submit(0, std::move(batch), batchOpenedAt_))
+        ++shed_;
+}
+
+bool ReplayWorker::waitUntil(
+    std::chrono::steady_clock::time_point due, const std::stop_token& stoken)
+{
+    std::unique_lock lock(pacingMutex_);
+    pacingCondition_.wait_until(lock, stoken, due, [] { return false; });
+    return !stoken.stop_requested();
+}
+}
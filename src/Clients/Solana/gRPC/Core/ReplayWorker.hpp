@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "AccountCache.hpp"
+#include "DataSourceWorker.hpp"
+#include "FeedRace.hpp"
+#include "FilterManager.hpp"
+#include "FrameCapture.hpp"
+#include "IngestPipeline.hpp"
+#include "NotificationManager.hpp"
+#include "StorageManager.hpp"
+#include "TxRingPublisher.hpp"
+
+namespace solana {
+
+// Feeds a FrameCapture file through the ingest pipeline, either as fast as
+// the pipeline accepts it or paced to the recorded receive times.
+class ReplayWorker : public DataSourceWorker {
+public:
+    ReplayWorker(const std::string& sourceId,
+        const ConfigManager::DataSourceConfig& source, StorageManager& storage,
+        NotificationManager& notifier, FilterManager& filter,
+        std::shared_ptr<FeedRace> race = nullptr,
+        std::shared_ptr<AccountCache> accounts = nullptr,
+        std::shared_ptr<TxRingPublisher> ring = nullptr);
+    ~ReplayWorker();
+
+    bool isConnected() const override;
+    uint64_t getTotalTransactions() const override;
+    uint64_t getProcessedBatches() const override;
+    uint64_t getDuplicateTransactions() const override;
+    uint64_t getReconnects() const override;
+    uint64_t getCheckpointSlot() const override;
+    double getBytesCopiedPerTransaction() const override;
+    json getShardStats() const override;
+    json getPipelineStats() const override;
+    const IngestTracer& getTracer() const override;
+
+private:
+    void run(std::stop_token stoken);
+    void submit(std::unique_ptr<IngestPipeline::FrameBatch>& frames);
+    bool waitUntil(std::chrono::steady_clock::time_point due,
+        const std::stop_token& stoken);
+
+    std::string sourceId_;
+    std::unique_ptr<FrameReader> reader_;
+    std::unique_ptr<IngestPipeline> pipeline_;
+    std::jthread thread_;
+    std::mutex pacingMutex_;
+    std::condition_variable_any pacingCondition_;
+    // When the first frame of the open batch was read; run() thread only.
+    std::chrono::steady_clock::time_point batchOpenedAt_;
+
+    std::atomic<uint64_t> frames_ { 0 };
+    std::atomic<uint64_t> batches_ { 0 };
+    std::atomic<uint64_t> shed_ { 0 };
+    std::atomic<int64_t> startedAtNs_ { 0 };
+    std::atomic<int64_t> finishedAtNs_ { 0 };
+};
+}
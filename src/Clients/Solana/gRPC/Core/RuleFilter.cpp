@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "RuleFilter.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "../Utils/Logger.hpp"
+
+namespace solana {
+
+namespace {
+    using WalletLists
+        = std::map<std::string, std::shared_ptr<const WalletSet>>;
+
+    // A file path, or the addresses themselves.
+    WalletLists loadWalletLists(const json& config)
+    {
+        WalletLists lists;
+        for (const auto& [name, value] : config.items()) {
+            std::vector<Pubkey> wallets;
+            if (value.is_string()) {
+                wallets = WalletSet::readFile(value.get<std::string>());
+            } else {
+                for (const auto& text : value) {
+                    if (auto key = Pubkey::fromBase58(text.get<std::string>()))
+                        wallets.push_back(*key);
+                    else
+                        Logger::getLogger()->warn(
+                            "RuleFilter: ignoring invalid address {} in {}",
+                            text.get<std::string>(), name);
+                }
+            }
+            lists[name] = std::make_shared<const WalletSet>(wallets);
+        }
+        return lists;
+    }
+
+    // What the pair of clock reads around a sampled evaluation costs by
+    // itself, taken off the time reported.
+    uint64_t clockOverheadNanos()
+    {
+        static const uint64_t overhead = [] {
+            auto least = std::chrono::nanoseconds::max();
+            for (int i = 0; i < 1000; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                least = std::min(least,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start));
+            }
+            return static_cast<uint64_t>(least.count());
+        }();
+        return overhead;
+    }
+}
+
+RuleFilter::RuleFilter()
+    : config_(std::make_unique<const Config>())
+{
+    clockOverheadNanos();
+}
+
+void RuleFilter::processTransaction(
+    const std::string& sourceId, const geyser::SubscribeUpdateTransaction& tx)
+{
+    // The view points into the serialized bytes, which must outlive it.
+    const std::string wire = tx.SerializeAsString();
+    TransactionView view;
+    if (view.scanTransaction(wire) && view.resolve())
+        processView(sourceId, view);
+}
+
+void RuleFilter::processView(
+    const std::string& sourceId, const TransactionView& view)
+{
+    incrementProcessCount();
+    try {
+        auto config = config_.read();
+        thread_local uint32_t tick = 0;
+        const bool sampling = ++tick % SAMPLE_EVERY == 0;
+        RuleContext context(view);
+        bool matchedAny = false;
+        std::shared_ptr<RuleStats> due;
+        for (const auto& rule : config->rules) {
+            bool matched;
+            if (sampling) {
+                auto start = std::chrono::steady_clock::now();
+                matched = rule.program.evaluate(context);
+                auto nanos = std::chrono::duration_cast<
+                    std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                                 .count();
+                if (sample(rule, context, nanos))
+                    due = rule.stats;
+            } else {
+                matched = rule.program.evaluate(context);
+            }
+            if (!matched)
+                continue;
+
+            matchedAny = true;
+            rule.stats->hits.fetch_add(1, std::memory_order_relaxed);
+            if (Logger::getLogger()->should_log(spdlog::level::info))
+                Logger::getLogger()->info("Rule {} matched {}", rule.name,
+                    Signature::fromBytes(view.signature).toBase58());
+            if (rule.notify && !ruleMatched.empty())
+                ruleMatched.publish(rule.name,
+                    Signature::fromBytes(view.signature).toBase58());
+        }
+        if (matchedAny)
+            incrementMatchCount();
+        // At most one rule comes due on a given transaction.
+        if (due)
+            reorder(due);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error("RuleFilter error: {}", e.what());
+    }
+}
+
+bool RuleFilter::sample(const Rule& rule, RuleContext& context, uint64_t nanos)
+{
+    RuleStats& stats = *rule.stats;
+    const uint64_t overhead = clockOverheadNanos();
+    stats.sampledNanos.fetch_add(
+        nanos > overhead ? nanos - overhead : 0, std::memory_order_relaxed);
+    for (size_t leaf = 0; leaf < rule.program.leafCount(); ++leaf) {
+        if (rule.program.evaluateLeaf(leaf, context))
+            stats.leafPasses[leaf].fetch_add(1, std::memory_order_relaxed);
+    }
+    return (stats.sampled.fetch_add(1, std::memory_order_relaxed) + 1)
+        % REORDER_SAMPLES
+        == 0;
+}
+
+void RuleFilter::reorder(const std::shared_ptr<RuleStats>& stats)
+{
+    config_.update([&stats](Config& next) {
+        for (auto& rule : next.rules) {
+            if (rule.stats != stats)
+                continue;
+            const double sampled = static_cast<double>(
+                stats->sampled.load(std::memory_order_relaxed));
+            std::vector<double> passRates(rule.program.leafCount());
+            for (size_t leaf = 0; leaf < passRates.size(); ++leaf) {
+                const uint64_t passes
+                    = stats->leafPasses[leaf].load(std::memory_order_relaxed);
+                passRates[leaf] = static_cast<double>(passes) / sampled;
+            }
+            std::string before = rule.program.toString();
+            rule.program = rule.program.reordered(passRates);
+            std::string after = rule.program.toString();
+            if (after != before)
+                Logger::getLogger()->debug(
+                    "Rule {} reordered to {}", rule.name, after);
+        }
+    });
+}
+
+std::optional<SubscriptionFilter> RuleFilter::subscription() const
+{
+    // Narrowed only when every rule names accounts it cannot match
+    // without.
+    auto config = config_.read();
+    SubscriptionFilter filter;
+    for (const auto& rule : config->rules) {
+        const WalletSet* accounts = rule.program.requiredAccounts();
+        if (!accounts)
+            return std::nullopt;
+        for (const auto& account : *accounts) {
+            filter.accountInclude.push_back(account.toBase58());
+        }
+    }
+    return filter;
+}
+
+void RuleFilter::updateConfig(const std::string& config)
+{
+    try {
+        auto json = json::parse(config);
+        WalletLists lists;
+        if (json.contains("wallets"))
+            lists = loadWalletLists(json["wallets"]);
+
+        std::vector<Rule> rules;
+        for (const auto& entry : json.value("rule", json::array())) {
+            auto name = entry.at("name").get<std::string>();
+            auto when = entry.at("when").get<std::string>();
+            RuleProgram program;
+            try {
+                program = RuleProgram::compile(when, lists);
+            } catch (const std::exception& e) {
+                throw std::runtime_error("rule " + name + ": " + e.what());
+            }
+            auto stats = std::make_shared<RuleStats>(program.leafCount());
+            rules.push_back({ std::move(name), entry.value("notify", false),
+                std::move(program), std::move(stats) });
+        }
+        size_t count = rules.size();
+        config_.update(
+            [&rules](Config& next) { next.rules = std::move(rules); });
+        Logger::getLogger()->info("Updated rules: {}", count);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error(
+            "Failed to update RuleFilter config: {}", e.what());
+    }
+}
+
+json RuleFilter::getRuleStats() const
+{
+    json result = json::object();
+    auto config = config_.read();
+    for (const auto& rule : config->rules) {
+        const RuleStats& stats = *rule.stats;
+        const uint64_t sampled = stats.sampled.load(std::memory_order_relaxed);
+        result[rule.name] = { { "hits",
+                                  stats.hits.load(std::memory_order_relaxed) },
+            { "sampled", sampled },
+            { "ns_per_eval",
+                sampled ? static_cast<double>(stats.sampledNanos.load(
+                              std::memory_order_relaxed))
+                        / static_cast<double>(sampled)
+                        : 0.0 },
+            { "order", rule.program.toString() } };
+    }
+    return result;
+}
+}
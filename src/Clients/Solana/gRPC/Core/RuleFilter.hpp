@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "EventBus.hpp"
+#include "RcuPtr.hpp"
+#include "RuleProgram.hpp"
+#include "TransactionFilter.hpp"
+
+namespace solana {
+
+/**
+ * Matches transactions against rules written in the config rather than
+ * in code:
+ *
+ *   [filters.rules.wallets]
+ *   smart = "smart_wallets.txt"   # a wallet list file, or
+ *   team = ["...", "..."]         # the addresses themselves
+ *
+ *   [[filters.rules.rule]]
+ *   name = "smart_raydium_buy"
+ *   when = 'program in {"..."} and signer in wallets("smart")
+ *           and swap.sol_amount > 50'
+ *   notify = true
+ *
+ * RuleProgram has the language. Every rule sees every transaction; one
+ * in SAMPLE_EVERY is also timed and has each of its tests run on its own,
+ * and after REORDER_SAMPLES of those a rule's tests are put back in the
+ * order the measured pass rates favour.
+ */
+class RuleFilter : public TransactionFilter {
+public:
+    RuleFilter();
+    void processTransaction(const std::string& sourceId,
+        const geyser::SubscribeUpdateTransaction& tx) override;
+    void processView(
+        const std::string& sourceId, const TransactionView& view) override;
+    // Compiles every rule before swapping any in; a rule that does not
+    // compile leaves the previous rules in place.
+    void updateConfig(const std::string& config) override;
+
+    bool needsFullTransaction() const override
+    {
+        return false;
+    }
+
+    std::string name() const override
+    {
+        return "RuleFilter";
+    }
+
+    std::optional<SubscriptionFilter> subscription() const override;
+
+    // Per rule: hits, ns_per_eval and the order its tests run in.
+    json getRuleStats() const;
+
+    // (rule, signature) for every match of a rule with notify set.
+    Event<const std::string&, const std::string&> ruleMatched;
+
+    static constexpr uint32_t SAMPLE_EVERY = 64;
+    static constexpr uint64_t REORDER_SAMPLES = 1024;
+
+private:
+    // Counters of one rule, kept across the reorders of its program.
+    struct alignas(64) RuleStats {
+        explicit RuleStats(size_t leaves)
+            : leafPasses(std::make_unique<std::atomic<uint64_t>[]>(leaves))
+        {
+        }
+
+        std::atomic<uint64_t> hits { 0 };
+        std::atomic<uint64_t> sampled { 0 };
+        std::atomic<uint64_t> sampledNanos { 0 };
+        std::unique_ptr<std::atomic<uint64_t>[]> leafPasses;
+    };
+
+    struct Rule {
+        std::string name;
+        bool notify;
+        RuleProgram program;
+        std::shared_ptr<RuleStats> stats;
+    };
+
+    // Replaced as a whole by updateConfig() and reorder(), never changed
+    // in place.
+    struct Config {
+        std::vector<Rule> rules;
+    };
+
+    // Records a sampled evaluation; true when the rule is due a reorder.
+    bool sample(const Rule& rule, RuleContext& context, uint64_t nanos);
+    void reorder(const std::shared_ptr<RuleStats>& stats);
+
+    RcuPtr<Config> config_;
+};
+}
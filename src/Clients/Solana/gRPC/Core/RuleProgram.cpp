@@ -0,0 +1,599 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "RuleProgram.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace solana {
+
+namespace {
+    const Pubkey WSOL_MINT
+        = *Pubkey::fromBase58("So11111111111111111111111111111111111111112");
+
+    struct FieldName {
+        std::string_view name;
+        RuleField field;
+        // Rough work to test it, in comparisons of a number.
+        double cost;
+    };
+
+    constexpr FieldName FIELDS[] = {
+        { "fee", RuleField::Fee, 1.0 },
+        { "compute_units", RuleField::ComputeUnits, 1.0 },
+        { "swap.sol_amount", RuleField::SwapSolAmount, 2.0 },
+        { "swap.token_count", RuleField::SwapTokenCount, 2.0 },
+        { "program", RuleField::Program, 4.0 },
+        { "account", RuleField::Account, 8.0 },
+        { "signer", RuleField::Signer, 1.0 },
+        { "mint", RuleField::Mint, 2.0 },
+        { "owner", RuleField::Owner, 2.0 },
+    };
+
+    const FieldName& fieldName(RuleField field)
+    {
+        return FIELDS[static_cast<size_t>(field)];
+    }
+
+    bool isNumber(RuleField field)
+    {
+        return static_cast<size_t>(field) < RULE_NUMBER_FIELDS;
+    }
+
+    bool isWordChar(char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_'
+            || c == '.';
+    }
+}
+
+double RuleContext::number(RuleField field)
+{
+    const auto index = static_cast<size_t>(field);
+    if (known_ & (1U << index))
+        return numbers_[index];
+    switch (field) {
+    case RuleField::Fee:
+        numbers_[index] = static_cast<double>(view_.fee);
+        break;
+    case RuleField::ComputeUnits:
+        numbers_[index] = static_cast<double>(view_.computeUnits);
+        break;
+    default: {
+        // Both swap fields come from one pass over the fee payer's deltas.
+        int64_t lamports = 0;
+        size_t tokens = 0;
+        if (!view_.keys.empty()) {
+            const Pubkey& payer = view_.keys[0];
+            lamports = view_.lamportChange(0) + static_cast<int64_t>(view_.fee);
+            for (const auto& delta : view_.balanceDeltas) {
+                if (delta.owner != payer)
+                    continue;
+                lamports += delta.accountLamports;
+                tokens += delta.mint != WSOL_MINT && delta.change() != 0;
+            }
+        }
+        numbers_[static_cast<size_t>(RuleField::SwapSolAmount)]
+            = std::fabs(static_cast<double>(lamports)) / 1e9;
+        numbers_[static_cast<size_t>(RuleField::SwapTokenCount)]
+            = static_cast<double>(tokens);
+        known_ |= 1U << static_cast<size_t>(RuleField::SwapSolAmount);
+        known_ |= 1U << static_cast<size_t>(RuleField::SwapTokenCount);
+        return numbers_[index];
+    }
+    }
+    known_ |= 1U << index;
+    return numbers_[index];
+}
+
+// Recursive descent over
+//
+//   or      := and ("or" and)*
+//   and     := not ("and" not)*
+//   not     := "not" not | "(" or ")" | test
+//   test    := number-field compare number | key-field "in" set
+//   set     := "{" [string ("," string)*] "}" | "wallets" "(" string ")"
+class RuleProgram::Parser {
+public:
+    Parser(std::string_view source,
+        const std::map<std::string, std::shared_ptr<const WalletSet>>&
+            walletLists,
+        RuleProgram& program)
+        : source_(source)
+        , walletLists_(walletLists)
+        , program_(program)
+    {
+    }
+
+    Node parse()
+    {
+        next();
+        Node node = parseOr();
+        if (type_ != Token::End)
+            fail("unexpected '" + std::string(text_) + "'");
+        return node;
+    }
+
+private:
+    enum class Token : uint8_t { End, Word, Number, String, Symbol };
+
+    [[noreturn]] void fail(const std::string& message) const
+    {
+        failAt(message, column_);
+    }
+
+    [[noreturn]] static void failAt(const std::string& message, size_t column)
+    {
+        throw std::runtime_error(
+            message + " at column " + std::to_string(column + 1));
+    }
+
+    void next()
+    {
+        while (position_ < source_.size()
+            && std::isspace(static_cast<unsigned char>(source_[position_])))
+            ++position_;
+        column_ = position_;
+        if (position_ == source_.size()) {
+            type_ = Token::End;
+            text_ = {};
+            return;
+        }
+        const char c = source_[position_];
+        size_t end = position_ + 1;
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            type_ = Token::Word;
+            while (end < source_.size() && isWordChar(source_[end]))
+                ++end;
+        } else if (std::isdigit(static_cast<unsigned char>(c)) || c == '-'
+            || c == '.') {
+            type_ = Token::Number;
+            while (end < source_.size()
+                && (std::isalnum(static_cast<unsigned char>(source_[end]))
+                    || source_[end] == '.'))
+                ++end;
+        } else if (c == '"') {
+            type_ = Token::String;
+            end = source_.find('"', position_ + 1);
+            if (end == std::string_view::npos)
+                fail("unterminated string");
+            ++end;
+        } else if (std::string_view("<>=!").find(c) != std::string_view::npos) {
+            type_ = Token::Symbol;
+            if (end < source_.size() && source_[end] == '=')
+                ++end;
+        } else if (std::string_view("(){},").find(c)
+            != std::string_view::npos) {
+            type_ = Token::Symbol;
+        } else {
+            fail(std::string("unexpected character '") + c + "'");
+        }
+        text_ = source_.substr(position_, end - position_);
+        position_ = end;
+    }
+
+    bool accept(std::string_view text)
+    {
+        if ((type_ != Token::Word && type_ != Token::Symbol) || text_ != text)
+            return false;
+        next();
+        return true;
+    }
+
+    void expect(std::string_view text)
+    {
+        if (!accept(text))
+            fail("expected '" + std::string(text) + "'");
+    }
+
+    std::string expectString()
+    {
+        if (type_ != Token::String)
+            fail("expected a quoted string");
+        std::string text(text_.substr(1, text_.size() - 2));
+        next();
+        return text;
+    }
+
+    Node parseOr()
+    {
+        Node node { Node::Kind::Or, 0, {} };
+        node.children.push_back(parseAnd());
+        while (accept("or"))
+            node.children.push_back(parseAnd());
+        return node.children.size() == 1 ? std::move(node.children[0]) : node;
+    }
+
+    Node parseAnd()
+    {
+        Node node { Node::Kind::And, 0, {} };
+        node.children.push_back(parseNot());
+        while (accept("and"))
+            node.children.push_back(parseNot());
+        return node.children.size() == 1 ? std::move(node.children[0]) : node;
+    }
+
+    Node parseNot()
+    {
+        if (accept("not")) {
+            Node node { Node::Kind::Not, 0, {} };
+            node.children.push_back(parseNot());
+            return node;
+        }
+        if (accept("(")) {
+            Node node = parseOr();
+            expect(")");
+            return node;
+        }
+        return parseTest();
+    }
+
+    Node parseTest()
+    {
+        if (type_ != Token::Word)
+            fail("expected a field");
+        auto field = std::find_if(std::begin(FIELDS), std::end(FIELDS),
+            [this](const FieldName& candidate) {
+                return candidate.name == text_;
+            });
+        if (field == std::end(FIELDS))
+            fail("unknown field '" + std::string(text_) + "'");
+        next();
+
+        Leaf leaf { field->field, Compare::Equal, 0.0, 0 };
+        if (isNumber(field->field)) {
+            static constexpr std::pair<std::string_view, Compare> COMPARES[]
+                = { { "<", Compare::Less }, { "<=", Compare::LessEqual },
+                      { ">", Compare::Greater },
+                      { ">=", Compare::GreaterEqual },
+                      { "==", Compare::Equal }, { "!=", Compare::NotEqual } };
+            auto compare = std::find_if(std::begin(COMPARES),
+                std::end(COMPARES), [this](const auto& compare) {
+                    return type_ == Token::Symbol && compare.first == text_;
+                });
+            if (compare == std::end(COMPARES))
+                fail("expected a comparison after "
+                    + std::string(field->name));
+            leaf.compare = compare->second;
+            next();
+            if (type_ != Token::Number)
+                fail("expected a number");
+            auto [end, error] = std::from_chars(
+                text_.data(), text_.data() + text_.size(), leaf.value);
+            if (error != std::errc() || end != text_.data() + text_.size())
+                fail("invalid number '" + std::string(text_) + "'");
+            next();
+        } else {
+            expect("in");
+            leaf.set = parseSet();
+        }
+        program_.leaves_.push_back(leaf);
+        return { Node::Kind::Leaf,
+            static_cast<uint32_t>(program_.leaves_.size() - 1), {} };
+    }
+
+    uint32_t parseSet()
+    {
+        if (accept("wallets")) {
+            expect("(");
+            const size_t column = column_;
+            std::string name = expectString();
+            auto list = walletLists_.find(name);
+            if (list == walletLists_.end())
+                failAt("unknown wallet list '" + name + "'", column);
+            expect(")");
+            return addSet(list->second, name);
+        }
+        if (!accept("{"))
+            fail("expected '{' or wallets(...)");
+        std::vector<Pubkey> keys;
+        if (!accept("}")) {
+            do {
+                const size_t column = column_;
+                std::string text = expectString();
+                auto key = Pubkey::fromBase58(text);
+                if (!key)
+                    failAt("invalid address '" + text + "'", column);
+                keys.push_back(*key);
+            } while (accept(","));
+            expect("}");
+        }
+        return addSet(std::make_shared<const WalletSet>(keys), {});
+    }
+
+    uint32_t addSet(std::shared_ptr<const WalletSet> set, std::string name)
+    {
+        program_.sets_.push_back(std::move(set));
+        program_.setNames_.push_back(std::move(name));
+        return static_cast<uint32_t>(program_.sets_.size() - 1);
+    }
+
+    std::string_view source_;
+    const std::map<std::string, std::shared_ptr<const WalletSet>>&
+        walletLists_;
+    RuleProgram& program_;
+    size_t position_ { 0 };
+    Token type_ { Token::End };
+    std::string_view text_;
+    size_t column_ { 0 };
+};
+
+RuleProgram RuleProgram::compile(std::string_view source,
+    const std::map<std::string, std::shared_ptr<const WalletSet>>&
+        walletLists)
+{
+    RuleProgram program;
+    program.root_ = Parser(source, walletLists, program).parse();
+    program.steps_.reserve(program.leaves_.size());
+    program.emit(program.root_, ACCEPT, REJECT);
+    return program;
+}
+
+size_t RuleProgram::stepCount(const Node& node)
+{
+    if (node.kind == Node::Kind::Leaf)
+        return 1;
+    size_t count = 0;
+    for (const auto& child : node.children) {
+        count += stepCount(child);
+    }
+    return count;
+}
+
+void RuleProgram::emit(const Node& node, int32_t onTrue, int32_t onFalse)
+{
+    // Every node's steps start with the one evaluated first, so an operand
+    // that does not settle an and/or goes on to where the next begins.
+    switch (node.kind) {
+    case Node::Kind::Leaf:
+        steps_.push_back({ leaves_[node.leaf], onTrue, onFalse });
+        break;
+    case Node::Kind::Not:
+        emit(node.children[0], onFalse, onTrue);
+        break;
+    case Node::Kind::And:
+    case Node::Kind::Or:
+        for (size_t i = 0; i < node.children.size(); ++i) {
+            const Node& child = node.children[i];
+            if (i + 1 == node.children.size()) {
+                emit(child, onTrue, onFalse);
+                break;
+            }
+            auto next = static_cast<int32_t>(steps_.size() + stepCount(child));
+            if (node.kind == Node::Kind::And)
+                emit(child, next, onFalse);
+            else
+                emit(child, onTrue, next);
+        }
+        break;
+    }
+}
+
+bool RuleProgram::test(const Leaf& leaf, RuleContext& context) const
+{
+    const TransactionView& view = context.view();
+    const WalletSet* keys
+        = isNumber(leaf.field) ? nullptr : sets_[leaf.set].get();
+    switch (leaf.field) {
+    case RuleField::Program:
+        for (const auto& instruction : view.instructions) {
+            if (keys->contains(instruction.program))
+                return true;
+        }
+        for (const auto& instruction : view.innerInstructions) {
+            if (keys->contains(instruction.program))
+                return true;
+        }
+        return false;
+    case RuleField::Account:
+        for (const auto& key : view.keys) {
+            if (keys->contains(key))
+                return true;
+        }
+        return false;
+    case RuleField::Signer:
+        return !view.keys.empty() && keys->contains(view.keys[0]);
+    case RuleField::Mint:
+        for (const auto& delta : view.balanceDeltas) {
+            if (delta.change() != 0 && keys->contains(delta.mint))
+                return true;
+        }
+        return false;
+    case RuleField::Owner:
+        for (const auto& delta : view.balanceDeltas) {
+            if (delta.change() != 0 && keys->contains(delta.owner))
+                return true;
+        }
+        return false;
+    default:
+        break;
+    }
+    const double value = context.number(leaf.field);
+    switch (leaf.compare) {
+    case Compare::Less:
+        return value < leaf.value;
+    case Compare::LessEqual:
+        return value <= leaf.value;
+    case Compare::Greater:
+        return value > leaf.value;
+    case Compare::GreaterEqual:
+        return value >= leaf.value;
+    case Compare::Equal:
+        return value == leaf.value;
+    case Compare::NotEqual:
+        return value != leaf.value;
+    }
+    return false;
+}
+
+bool RuleProgram::evaluate(RuleContext& context) const
+{
+    int32_t at = 0;
+    for (;;) {
+        const Step& step = steps_[at];
+        at = test(step.leaf, context) ? step.onTrue : step.onFalse;
+        if (at < 0)
+            return at == ACCEPT;
+    }
+}
+
+bool RuleProgram::evaluateLeaf(size_t leaf, RuleContext& context) const
+{
+    return test(leaves_[leaf], context);
+}
+
+void RuleProgram::sort(Node& node, std::span<const double> passRates,
+    double& cost, double& pass) const
+{
+    switch (node.kind) {
+    case Node::Kind::Leaf:
+        cost = fieldName(leaves_[node.leaf].field).cost;
+        pass = std::clamp(passRates[node.leaf], 0.001, 0.999);
+        return;
+    case Node::Kind::Not:
+        sort(node.children[0], passRates, cost, pass);
+        pass = 1.0 - pass;
+        return;
+    case Node::Kind::And:
+    case Node::Kind::Or:
+        break;
+    }
+    // An and is settled by the first operand to fail, so the best first
+    // one fails most per unit of work, cost / (1 - pass); an or the other
+    // way round. Operands are taken as independent.
+    const bool isAnd = node.kind == Node::Kind::And;
+    struct Operand {
+        double rank;
+        double cost;
+        double pass;
+        Node node;
+    };
+    std::vector<Operand> operands;
+    for (auto& child : node.children) {
+        Operand operand { 0.0, 0.0, 0.0, std::move(child) };
+        sort(operand.node, passRates, operand.cost, operand.pass);
+        operand.rank = operand.cost
+            / (isAnd ? 1.0 - operand.pass : operand.pass);
+        operands.push_back(std::move(operand));
+    }
+    std::stable_sort(operands.begin(), operands.end(),
+        [](const Operand& a, const Operand& b) { return a.rank < b.rank; });
+
+    // Reached is the chance evaluation gets as far as an operand.
+    double reached = 1.0;
+    cost = 0.0;
+    for (size_t i = 0; i < operands.size(); ++i) {
+        cost += reached * operands[i].cost;
+        reached *= isAnd ? operands[i].pass : 1.0 - operands[i].pass;
+        node.children[i] = std::move(operands[i].node);
+    }
+    pass = isAnd ? reached : 1.0 - reached;
+}
+
+RuleProgram RuleProgram::reordered(std::span<const double> passRates) const
+{
+    RuleProgram program = *this;
+    double cost = 0.0;
+    double pass = 0.0;
+    sort(program.root_, passRates, cost, pass);
+    program.steps_.clear();
+    program.emit(program.root_, ACCEPT, REJECT);
+    return program;
+}
+
+void RuleProgram::print(
+    const Node& node, std::string& out, bool nested) const
+{
+    switch (node.kind) {
+    case Node::Kind::Leaf: {
+        const Leaf& leaf = leaves_[node.leaf];
+        out += fieldName(leaf.field).name;
+        if (isNumber(leaf.field)) {
+            static constexpr std::string_view COMPARES[]
+                = { " < ", " <= ", " > ", " >= ", " == ", " != " };
+            char value[32];
+            std::snprintf(value, sizeof(value), "%g", leaf.value);
+            out += COMPARES[static_cast<size_t>(leaf.compare)];
+            out += value;
+        } else if (!setNames_[leaf.set].empty()) {
+            out += " in wallets(\"" + setNames_[leaf.set] + "\")";
+        } else if (sets_[leaf.set]->size() == 1) {
+            out += " in {\"" + sets_[leaf.set]->begin()->toBase58() + "\"}";
+        } else {
+            out += " in {" + std::to_string(sets_[leaf.set]->size())
+                + " addresses}";
+        }
+        break;
+    }
+    case Node::Kind::Not:
+        out += "not ";
+        print(node.children[0], out, true);
+        break;
+    case Node::Kind::And:
+    case Node::Kind::Or:
+        if (nested)
+            out += '(';
+        for (size_t i = 0; i < node.children.size(); ++i) {
+            if (i > 0)
+                out += node.kind == Node::Kind::And ? " and " : " or ";
+            print(node.children[i], out, true);
+        }
+        if (nested)
+            out += ')';
+        break;
+    }
+}
+
+std::string RuleProgram::toString() const
+{
+    std::string out;
+    print(root_, out, false);
+    return out;
+}
+
+const WalletSet* RuleProgram::requiredAccounts() const
+{
+    // Programs a transaction runs, inner ones included, and its fee payer
+    // are all among its account keys; mints and token owners need not be.
+    auto required = [this](const Node& node) -> const WalletSet* {
+        if (node.kind != Node::Kind::Leaf)
+            return nullptr;
+        const Leaf& leaf = leaves_[node.leaf];
+        if (leaf.field != RuleField::Program
+            && leaf.field != RuleField::Account
+            && leaf.field != RuleField::Signer)
+            return nullptr;
+        return sets_[leaf.set].get();
+    };
+    if (root_.kind != Node::Kind::And)
+        return required(root_);
+    // The smallest of the sets an and requires, for the narrowest filter.
+    const WalletSet* smallest = nullptr;
+    for (const auto& child : root_.children) {
+        const WalletSet* keys = required(child);
+        if (keys && (!smallest || keys->size() < smallest->size()))
+            smallest = keys;
+    }
+    return smallest;
+}
+}
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Pubkey.hpp"
+#include "TransactionView.hpp"
+#include "WalletSet.hpp"
+
+namespace solana {
+
+// What a rule can test. Numbers:
+//
+//   fee               lamports
+//   compute_units
+//   swap.sol_amount   SOL the fee payer moved, WSOL and token account rent
+//                     included and the fee left out, as SwapFilter counts it
+//   swap.token_count  mints other than WSOL whose balance the fee payer
+//                     changed
+//
+// Keys, tested with in:
+//
+//   program   any instruction's program, inner instructions included
+//   account   any account key
+//   signer    the fee payer
+//   mint      any mint whose balance changed
+//   owner     any owner whose token balance changed
+enum class RuleField : uint8_t {
+    Fee,
+    ComputeUnits,
+    SwapSolAmount,
+    SwapTokenCount,
+    Program,
+    Account,
+    Signer,
+    Mint,
+    Owner,
+};
+
+inline constexpr size_t RULE_NUMBER_FIELDS = 4;
+
+// Per-transaction values rules test, each computed on first use and shared
+// by all rules. Lives on the evaluating thread's stack.
+class RuleContext {
+public:
+    explicit RuleContext(const TransactionView& view)
+        : view_(view)
+    {
+    }
+
+    const TransactionView& view() const
+    {
+        return view_;
+    }
+
+    double number(RuleField field);
+
+private:
+    const TransactionView& view_;
+    std::array<double, RULE_NUMBER_FIELDS> numbers_ {};
+    uint32_t known_ { 0 };
+};
+
+/**
+ * One rule's condition, compiled from text such as
+ *
+ *   program in {"675kPX9MHTjS2zt1qfr1NYHuzeLXfQM9H24wFSUt1Mp8"}
+ *       and swap.sol_amount > 50 and signer in wallets("smart")
+ *
+ * Conditions combine comparisons (> >= < <= == !=) of number fields with
+ * numbers and key fields tested with in, against either a literal set of
+ * addresses or a named wallet list, using and, or, not and parentheses.
+ *
+ * The expression is flattened into steps, one per comparison or test,
+ * each naming the step to go to on true and on false, so that evaluation
+ * is a loop over an array that short-circuits without recursion or
+ * allocation. reordered() rebuilds the steps with the operands of every
+ * and/or sorted by how often each is measured to pass, so the test most
+ * likely to settle the result for the least work runs first.
+ *
+ * Immutable once compiled.
+ */
+class RuleProgram {
+public:
+    // Throws std::runtime_error naming the column on a syntax error, an
+    // unknown field or wallet list, or an invalid address.
+    static RuleProgram compile(std::string_view source,
+        const std::map<std::string, std::shared_ptr<const WalletSet>>&
+            walletLists);
+
+    bool evaluate(RuleContext& context) const;
+
+    // The comparisons and tests, numbered in source order.
+    size_t leafCount() const
+    {
+        return leaves_.size();
+    }
+
+    // Evaluates one comparison or test on its own, to measure how often it
+    // passes independent of the order they run in.
+    bool evaluateLeaf(size_t leaf, RuleContext& context) const;
+
+    // A copy with the operands of every and/or ordered by expected cost,
+    // from how often each leaf passes. passRates has leafCount() entries.
+    RuleProgram reordered(std::span<const double> passRates) const;
+
+    // The expression as it is evaluated, in the current order.
+    std::string toString() const;
+
+    // Keys one of which every transaction the rule matches has among its
+    // account keys, or null if the rule can match without any.
+    const WalletSet* requiredAccounts() const;
+
+private:
+    enum class Compare : uint8_t { Less, LessEqual, Greater, GreaterEqual,
+        Equal, NotEqual };
+
+    struct Leaf {
+        RuleField field;
+        Compare compare;
+        double value;
+        // For key fields: index into sets_.
+        uint32_t set;
+    };
+
+    struct Node {
+        enum class Kind : uint8_t { And, Or, Not, Leaf };
+        Kind kind;
+        // For leaves: index into leaves_.
+        uint32_t leaf;
+        std::vector<Node> children;
+    };
+
+    // Where evaluation goes after a step: another step, or an answer.
+    static constexpr int32_t ACCEPT = -1;
+    static constexpr int32_t REJECT = -2;
+
+    struct Step {
+        Leaf leaf;
+        int32_t onTrue;
+        int32_t onFalse;
+    };
+
+    class Parser;
+
+    bool test(const Leaf& leaf, RuleContext& context) const;
+    void emit(const Node& node, int32_t onTrue, int32_t onFalse);
+    static size_t stepCount(const Node& node);
+    void sort(Node& node, std::span<const double> passRates, double& cost,
+        double& pass) const;
+    void print(const Node& node, std::string& out, bool nested) const;
+
+    Node root_;
+    std::vector<Leaf> leaves_;
+    std::vector<Step> steps_;
+    std::vector<std::shared_ptr<const WalletSet>> sets_;
+    std::vector<std::string> setNames_;
+};
+}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SignatureSet.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace solana {
+
+SignatureSet::SignatureSet(size_t windowSlots, size_t slotCapacity)
+    : windowSlots_(std::max<size_t>(1, windowSlots))
+    , slotCapacity_(std::bit_ceil(std::max<size_t>(MAX_PROBE, slotCapacity)))
+    , generations_(std::make_unique<Generation[]>(windowSlots_))
+{
+    for (size_t i = 0; i < windowSlots_; ++i) {
+        generations_[i].entries = std::make_unique<Entry[]>(slotCapacity_);
+    }
+}
+
+SignatureSet::~SignatureSet() = default;
+
+uint64_t SignatureSet::fingerprint(std::string_view signature)
+{
+    // Ed25519 signatures are already uniformly distributed, so the leading
+    // bytes make a perfectly good hash without touching the rest.
+    uint64_t key = 0;
+    if (signature.size() >= sizeof(key) * 2) {
+        uint64_t high = 0;
+        std::memcpy(&key, signature.data(), sizeof(key));
+        std::memcpy(&high, signature.data() + sizeof(key), sizeof(high));
+        key ^= std::rotl(high, 31);
+    } else {
+        key = std::hash<std::string_view> {}(signature);
+    }
+    return key ? key : 1;
+}
+
+bool SignatureSet::acquireGeneration(Generation& generation, uint64_t slot)
+{
+    const uint64_t wanted = (slot + 1) << 1;
+    while (true) {
+        uint64_t tag = generation.tag.load(std::memory_order_acquire);
+        if (tag == wanted)
+            return true;
+        if (tag & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (tag > wanted)
+            return false;
+        if (generation.tag.compare_exchange_strong(
+                tag, wanted | 1, std::memory_order_acq_rel)) {
+            for (size_t i = 0; i < slotCapacity_; ++i) {
+                generation.entries[i].key.store(0, std::memory_order_relaxed);
+                generation.entries[i].meta.store(0, std::memory_order_relaxed);
+            }
+            generation.tag.store(wanted, std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+SignatureSet::Admission SignatureSet::insert(std::string_view signature,
+    uint64_t slot, uint16_t owner, uint64_t nowUs)
+{
+    auto& generation = generations_[slot % windowSlots_];
+    if (!acquireGeneration(generation, slot)) {
+        // Older than the window: the caller decides whether to risk a
+        // duplicate or a loss.
+        stale_.fetch_add(1, std::memory_order_relaxed);
+        return { true, owner, nowUs, true };
+    }
+
+    const uint64_t key = fingerprint(signature);
+    // Never zero, which marks a key whose winner is still being stored.
+    const uint64_t meta = (std::max<uint64_t>(nowUs, 1) << 16) | owner;
+    const size_t mask = slotCapacity_ - 1;
+    for (size_t probe = 0; probe < MAX_PROBE; ++probe) {
+        auto& entry = generation.entries[(key + probe) & mask];
+        uint64_t current = entry.key.load(std::memory_order_acquire);
+        if (current == 0
+            && entry.key.compare_exchange_strong(
+                current, key, std::memory_order_acq_rel)) {
+            entry.meta.store(meta, std::memory_order_release);
+            return { true, owner, nowUs };
+        }
+        if (current == key) {
+            uint64_t winner;
+            while ((winner = entry.meta.load(std::memory_order_acquire)) == 0) {
+                // Recycled meanwhile: the slot has left the window.
+                if (entry.key.load(std::memory_order_acquire) != key) {
+                    stale_.fetch_add(1, std::memory_order_relaxed);
+                    return { true, owner, nowUs, true };
+                }
+                std::this_thread::yield();
+            }
+            return { false, static_cast<uint16_t>(winner & 0xffff),
+                winner >> 16 };
+        }
+    }
+
+    overflows_.fetch_add(1, std::memory_order_relaxed);
+    return { true, owner, nowUs };
+}
+}
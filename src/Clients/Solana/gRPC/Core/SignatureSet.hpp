@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace solana {
+
+/**
+ * Bounded, lock-free set of transaction signatures partitioned by slot.
+ * Each of the windowSlots generations holds the signatures of one slot in an
+ * open-addressed table of 64-bit fingerprints; a generation is recycled the
+ * first time a slot windowSlots ahead of it shows up, so memory never grows.
+ */
+class SignatureSet {
+public:
+    struct Admission {
+        bool first;
+        uint16_t owner;
+        uint64_t firstSeenUs;
+        // Older than the window, so nothing is known about it.
+        bool stale { false };
+    };
+
+    SignatureSet(size_t windowSlots, size_t slotCapacity);
+    ~SignatureSet();
+
+    Admission insert(std::string_view signature, uint64_t slot,
+        uint16_t owner, uint64_t nowUs);
+
+    size_t getWindowSlots() const
+    {
+        return windowSlots_;
+    }
+
+    uint64_t getOverflows() const
+    {
+        return overflows_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t getStale() const
+    {
+        return stale_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t MAX_PROBE = 32;
+
+    struct Entry {
+        std::atomic<uint64_t> key { 0 };
+        std::atomic<uint64_t> meta { 0 };
+    };
+
+    struct Generation {
+        // (slot + 1) << 1, with the low bit set while the table is recycled.
+        std::atomic<uint64_t> tag { 0 };
+        std::unique_ptr<Entry[]> entries;
+    };
+
+    static uint64_t fingerprint(std::string_view signature);
+    bool acquireGeneration(Generation& generation, uint64_t slot);
+
+    size_t windowSlots_;
+    size_t slotCapacity_;
+    std::unique_ptr<Generation[]> generations_;
+    std::atomic<uint64_t> overflows_ { 0 };
+    std::atomic<uint64_t> stale_ { 0 };
+};
+}
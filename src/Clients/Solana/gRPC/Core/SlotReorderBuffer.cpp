@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SlotReorderBuffer.hpp"
+
+#include <algorithm>
+
+#include "WireReader.hpp"
+
+namespace solana {
+
+namespace {
+    using namespace wire;
+
+    // Field numbers and SlotStatus values from geyser.proto.
+    namespace field {
+        constexpr uint32_t UPDATE_SLOT = 3;
+        constexpr uint32_t UPDATE_BLOCK_META = 7;
+
+        constexpr uint32_t SLOT_SLOT = 1;
+        constexpr uint32_t SLOT_STATUS = 3;
+
+        constexpr uint32_t BLOCK_META_SLOT = 1;
+    }
+
+    namespace status {
+        constexpr uint64_t PROCESSED = 0;
+        constexpr uint64_t FINALIZED = 2;
+        constexpr uint64_t DEAD = 6;
+    }
+
+    uint64_t elapsedUs(
+        SlotReorderBuffer::Clock::time_point from,
+        SlotReorderBuffer::Clock::time_point to)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(to - from)
+            .count();
+    }
+}
+
+SlotReorderBuffer::SlotReorderBuffer(const Options& options, size_t lanes)
+    : options_(options)
+    , lanes_(std::max<size_t>(1, lanes))
+{
+    options_.windowSlots = std::max<size_t>(1, options_.windowSlots);
+}
+
+SlotReorderBuffer::~SlotReorderBuffer() = default;
+
+bool SlotReorderBuffer::parseEvent(std::string_view frame, SlotEvent& event)
+{
+    WireReader reader(frame);
+    while (!reader.done()) {
+        uint32_t number, type;
+        if (!reader.readTag(number, type))
+            return false;
+        if ((number != field::UPDATE_SLOT && number != field::UPDATE_BLOCK_META)
+            || type != LENGTH_DELIMITED) {
+            if (!reader.skip(type))
+                return false;
+            continue;
+        }
+
+        std::string_view message;
+        if (!reader.readBytes(message))
+            return false;
+        // Block meta is only sent once the bank is frozen. Slot updates
+        // close a slot from PROCESSED on; the earlier interslot statuses
+        // arrive while it is still being replayed. A missing status is
+        // PROCESSED, proto3 does not serialize zero.
+        uint64_t slotStatus = status::PROCESSED;
+        event = {};
+        WireReader inner(message);
+        while (!inner.done()) {
+            uint32_t innerNumber, innerType;
+            if (!inner.readTag(innerNumber, innerType))
+                return false;
+            bool isSlot = number == field::UPDATE_SLOT
+                ? innerNumber == field::SLOT_SLOT
+                : innerNumber == field::BLOCK_META_SLOT;
+            if (isSlot && innerType == VARINT) {
+                if (!inner.readVarint(event.slot))
+                    return false;
+            } else if (number == field::UPDATE_SLOT
+                && innerNumber == field::SLOT_STATUS && innerType == VARINT) {
+                if (!inner.readVarint(slotStatus))
+                    return false;
+            } else if (!inner.skip(innerType)) {
+                return false;
+            }
+        }
+        event.dead = number == field::UPDATE_SLOT && slotStatus == status::DEAD;
+        event.closes = number == field::UPDATE_BLOCK_META || event.dead
+            || slotStatus <= status::FINALIZED;
+        return event.slot != 0;
+    }
+    return false;
+}
+
+const char* SlotReorderBuffer::reasonName(Reason reason)
+{
+    switch (reason) {
+    case Reason::COMPLETE:
+        return "complete";
+    case Reason::DEAD:
+        return "dead";
+    case Reason::TIMEOUT:
+        return "timeout";
+    case Reason::WINDOW:
+        return "window";
+    case Reason::LATE:
+        return "late";
+    case Reason::FLUSH:
+        return "flush";
+    }
+    return "unknown";
+}
+
+void SlotReorderBuffer::hold(size_t lane, TransactionBatch& batch,
+    Clock::time_point submittedAt, Clock::time_point receivedAt,
+    Clock::time_point now)
+{
+    for (auto& entry : batch.takeEntries()) {
+        Slot* slot;
+        if (entry.slot <= lastReleased_) {
+            if (!late_) {
+                late_ = std::make_unique<Slot>();
+                late_->batch = std::make_unique<TransactionBatch>();
+                late_->openedAt = now;
+                late_->submittedAt = submittedAt;
+                late_->receivedAt = receivedAt;
+            }
+            slot = late_.get();
+            lateSlot_ = std::max(lateSlot_, entry.slot);
+            ++lateTransactions_;
+        } else {
+            slot = &open(entry.slot, now);
+            ++heldTransactions_;
+        }
+        addLane(slot->lanes, lane);
+        slot->submittedAt = std::min(slot->submittedAt, submittedAt);
+        slot->receivedAt = std::min(slot->receivedAt, receivedAt);
+        slot->batch->append(std::move(entry));
+    }
+}
+
+void SlotReorderBuffer::apply(
+    size_t lane, const SlotEvent& event, Clock::time_point now)
+{
+    if (!event.closes)
+        return;
+    lanes_[lane].passed = std::max(lanes_[lane].passed, event.slot);
+    if (event.slot <= lastReleased_)
+        return;
+    auto& slot = open(event.slot, now);
+    slot.closed = true;
+    slot.dead = slot.dead || event.dead;
+}
+
+void SlotReorderBuffer::setIdle(size_t lane, bool idle)
+{
+    lanes_[lane].idle = idle;
+}
+
+std::vector<SlotReorderBuffer::Release> SlotReorderBuffer::release(
+    Clock::time_point now, bool flush)
+{
+    std::vector<Release> released;
+    if (late_) {
+        released.push_back({ lateSlot_, Reason::LATE, std::move(late_->batch),
+            std::move(late_->lanes), late_->submittedAt, late_->receivedAt,
+            elapsedUs(late_->openedAt, now) });
+        late_.reset();
+        lateSlot_ = 0;
+    }
+
+    while (!slots_.empty()) {
+        auto it = slots_.begin();
+        auto& slot = it->second;
+        Reason reason;
+        if (slot.closed && lanesPassed(it->first)) {
+            reason = slot.dead ? Reason::DEAD : Reason::COMPLETE;
+            ++(slot.dead ? dead_ : completed_);
+        } else if (flush) {
+            reason = Reason::FLUSH;
+        } else if (now - slot.openedAt >= options_.timeout) {
+            reason = Reason::TIMEOUT;
+            ++timedOut_;
+        } else if (slots_.size() > options_.windowSlots) {
+            reason = Reason::WINDOW;
+            ++evicted_;
+        } else {
+            break;
+        }
+
+        uint64_t heldUs = elapsedUs(slot.openedAt, now);
+        heldUs_.record(heldUs);
+        heldTransactions_ -= slot.batch->size();
+        released.push_back({ it->first, reason, std::move(slot.batch),
+            std::move(slot.lanes), slot.submittedAt, slot.receivedAt,
+            heldUs });
+        lastReleased_ = it->first;
+        slots_.erase(it);
+        ++releasedSlots_;
+    }
+    openSlots_ = slots_.size();
+    return released;
+}
+
+json SlotReorderBuffer::getStats() const
+{
+    json stats;
+    stats["open_slots"] = openSlots_.load();
+    stats["held_transactions"] = heldTransactions_.load();
+    stats["released_slots"] = releasedSlots_.load();
+    stats["completed"] = completed_.load();
+    stats["timed_out"] = timedOut_.load();
+    stats["evicted"] = evicted_.load();
+    stats["dead"] = dead_.load();
+    stats["late_transactions"] = lateTransactions_.load();
+    // First transaction or event of a slot to its release.
+    stats["held_us"] = heldUs_.toJson();
+    return stats;
+}
+
+void SlotReorderBuffer::addLane(std::vector<LaneShare>& lanes, size_t lane)
+{
+    auto share = std::find_if(lanes.begin(), lanes.end(),
+        [lane](const LaneShare& share) { return share.lane == lane; });
+    if (share == lanes.end())
+        lanes.push_back({ lane, 1 });
+    else
+        ++share->transactions;
+}
+
+bool SlotReorderBuffer::lanesPassed(uint64_t slot) const
+{
+    return std::all_of(lanes_.begin(), lanes_.end(),
+        [slot](const auto& lane) { return lane.idle || lane.passed >= slot; });
+}
+
+SlotReorderBuffer::Slot& SlotReorderBuffer::open(
+    uint64_t slot, Clock::time_point now)
+{
+    auto [it, inserted] = slots_.try_emplace(slot);
+    if (inserted) {
+        it->second.batch = std::make_unique<TransactionBatch>();
+        it->second.openedAt = now;
+        it->second.submittedAt = now;
+        it->second.receivedAt = now;
+        openSlots_ = slots_.size();
+    }
+    return it->second;
+}
+}
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "LatencyHistogram.hpp"
+#include "TransactionBatch.hpp"
+
+namespace solana {
+
+/**
+ * Puts a PROCESSED transaction stream back into slot order. Transactions are
+ * held per slot and released one slot at a time, lowest first, once their
+ * slot is closed by a slot status or block meta update, once it has been
+ * open longer than the timeout, or once more than windowSlots slots are
+ * open. Transactions for a slot that was already released are passed on
+ * immediately and counted as late.
+ *
+ * With several lanes every lane carries its own slot updates, so a closed
+ * slot also waits until every lane has closed it or is idle. A lane's
+ * transactions interleave slots and say nothing about what it has passed;
+ * a lane that never closes the slot holds it until the timeout.
+ *
+ * Not thread-safe apart from getStats(); the pipeline's filter stage owns it.
+ */
+class SlotReorderBuffer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        size_t windowSlots { 32 };
+        std::chrono::milliseconds timeout { 400 };
+    };
+
+    struct SlotEvent {
+        uint64_t slot { 0 };
+        bool closes { false };
+        bool dead { false };
+    };
+
+    enum class Reason { COMPLETE, DEAD, TIMEOUT, WINDOW, LATE, FLUSH };
+
+    // Transactions one pipeline lane contributed.
+    struct LaneShare {
+        size_t lane { 0 };
+        size_t transactions { 0 };
+    };
+
+    struct Release {
+        uint64_t slot { 0 };
+        Reason reason { Reason::COMPLETE };
+        std::unique_ptr<TransactionBatch> batch;
+        std::vector<LaneShare> lanes;
+        // Earliest of the batches that went into it.
+        Clock::time_point submittedAt;
+        Clock::time_point receivedAt;
+        uint64_t heldUs { 0 };
+    };
+
+    explicit SlotReorderBuffer(const Options& options, size_t lanes = 1);
+    ~SlotReorderBuffer();
+
+    // Reads a SubscribeUpdate slot status or block meta frame.
+    static bool parseEvent(std::string_view frame, SlotEvent& event);
+    static const char* reasonName(Reason reason);
+
+    // Takes the entries out of a batch that has not been parsed yet.
+    void hold(size_t lane, TransactionBatch& batch,
+        Clock::time_point submittedAt, Clock::time_point receivedAt,
+        Clock::time_point now);
+    void apply(size_t lane, const SlotEvent& event, Clock::time_point now);
+    // An idle lane has nothing in flight that could still belong to a slot.
+    void setIdle(size_t lane, bool idle);
+    // With flush set everything still held is released.
+    std::vector<Release> release(Clock::time_point now, bool flush = false);
+
+    bool empty() const
+    {
+        return slots_.empty() && !late_;
+    }
+
+    json getStats() const;
+
+private:
+    struct Slot {
+        std::unique_ptr<TransactionBatch> batch;
+        std::vector<LaneShare> lanes;
+        Clock::time_point openedAt;
+        Clock::time_point submittedAt;
+        Clock::time_point receivedAt;
+        bool closed { false };
+        bool dead { false };
+    };
+
+    struct LaneProgress {
+        // The newest slot this lane's own updates closed.
+        uint64_t passed { 0 };
+        bool idle { false };
+    };
+
+    static void addLane(std::vector<LaneShare>& lanes, size_t lane);
+    Slot& open(uint64_t slot, Clock::time_point now);
+    bool lanesPassed(uint64_t slot) const;
+
+    Options options_;
+    std::vector<LaneProgress> lanes_;
+    std::map<uint64_t, Slot> slots_;
+    std::unique_ptr<Slot> late_;
+    uint64_t lateSlot_ { 0 };
+    uint64_t lastReleased_ { 0 };
+
+    std::atomic<size_t> openSlots_ { 0 };
+    std::atomic<uint64_t> heldTransactions_ { 0 };
+    std::atomic<uint64_t> releasedSlots_ { 0 };
+    std::atomic<uint64_t> completed_ { 0 };
+    std::atomic<uint64_t> timedOut_ { 0 };
+    std::atomic<uint64_t> evicted_ { 0 };
+    std::atomic<uint64_t> dead_ { 0 };
+    std::atomic<uint64_t> lateTransactions_ { 0 };
+    LatencyHistogram heldUs_;
+};
+}
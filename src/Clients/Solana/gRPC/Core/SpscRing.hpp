@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace solana {
+
+// Bounded ring with a single producer and a single consumer. Slots carry
+// sequence numbers and the read index is claimed with a CAS, so the
+// producer may also pop the oldest entry to make room for a new one.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : capacity_(std::bit_ceil(capacity < 2 ? size_t { 2 } : capacity))
+        , mask_(capacity_ - 1)
+        , slots_(std::make_unique<Slot[]>(capacity_))
+    {
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Moves from value only when it succeeds.
+    bool tryPush(T& value)
+    {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[pos & mask_];
+        if (slot.seq.load(std::memory_order_acquire) != pos)
+            return false;
+        slot.value = std::move(value);
+        slot.seq.store(pos + 1, std::memory_order_release);
+        head_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value)
+    {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & mask_];
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff < 0)
+                return false;
+            if (diff > 0) {
+                pos = tail_.load(std::memory_order_relaxed);
+            } else if (tail_.compare_exchange_weak(
+                           pos, pos + 1, std::memory_order_relaxed)) {
+                value = std::move(slot.value);
+                slot.value = T {};
+                slot.seq.store(pos + capacity_, std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    size_t size() const
+    {
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t head = head_.load(std::memory_order_acquire);
+        return head > tail ? head - tail : 0;
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct Slot {
+        std::atomic<size_t> seq { 0 };
+        T value {};
+    };
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(CACHE_LINE) std::atomic<size_t> head_ { 0 };
+    alignas(CACHE_LINE) std::atomic<size_t> tail_ { 0 };
+};
+}
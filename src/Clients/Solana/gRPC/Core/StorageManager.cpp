@@ -25,7 +25,7 @@
 #include <rocksdb/table.h>
 #include <rocksdb/utilities/backup_engine.h>
 
-#include "Consts.h"
+#include "AppInfo.h"
 #include "Utils/PathUtils.hpp"
 
 using namespace Daitengu::Core;
@@ -48,13 +48,19 @@ public:
         stop();
     }
 
-    void enqueueBatch(
-        const std::vector<std::pair<std::string, std::string>>& batch)
+    void enqueueBatch(std::vector<std::pair<std::string, std::string>> batch)
     {
         if (batch.empty())
             return;
         std::lock_guard lock(mutex_);
-        tasks_.push({ TaskType::BATCH, batch, "", "" });
+        tasks_.push({ TaskType::BATCH, std::move(batch), "", "" });
+        condition_.notify_one();
+    }
+
+    void enqueuePut(const std::string& key, std::string value)
+    {
+        std::lock_guard lock(mutex_);
+        tasks_.push({ TaskType::PUT, { { key, std::move(value) } }, key, "" });
         condition_.notify_one();
     }
 
@@ -83,7 +89,7 @@ public:
     }
 
 private:
-    enum class TaskType { BATCH, GET, BACKUP };
+    enum class TaskType { BATCH, PUT, GET, BACKUP };
 
     struct StorageTask {
         TaskType type;
@@ -131,6 +137,9 @@ private:
             case TaskType::BATCH:
                 processBatch(task.batch);
                 break;
+            case TaskType::PUT:
+                processPut(task.batch.front());
+                break;
             case TaskType::GET:
                 processGetRequest(task.key);
                 break;
@@ -165,6 +174,17 @@ private:
             "Stored batch of {} transactions", batch.size());
     }
 
+    void processPut(const std::pair<std::string, std::string>& entry)
+    {
+        rocksdb::WriteOptions options;
+        options.sync = false;
+        rocksdb::Status status = db_->Put(options, entry.first, entry.second);
+        if (!status.ok()) {
+            Logger::getLogger()->error(
+                "Failed to store {}: {}", entry.first, status.ToString());
+        }
+    }
+
     void processGetRequest(const std::string& key)
     {
         std::string value;
@@ -210,9 +230,8 @@ private:
     uint64_t totalBatches_ { 0 };
 };
 
-StorageManager::StorageManager(const std::string& dbPath, QObject* parent)
-    : QObject(parent)
-    , dataPath_(PathUtils::getAppDataPath(COMPANY) / NAME)
+StorageManager::StorageManager(const std::string& dbPath)
+    : dataPath_(PathUtils::getAppDataPath(COMPANY) / NAME)
 {
     initializeDatabase(dbPath);
     worker_ = std::make_unique<StorageWorker>(db_.get());
@@ -256,11 +275,53 @@ void StorageManager::storeBatch(
     worker_->enqueueBatch(batch);
 }
 
+void StorageManager::storeBatch(
+    std::vector<std::pair<std::string, std::string>>&& batch)
+{
+    worker_->enqueueBatch(std::move(batch));
+}
+
 void StorageManager::getTransaction(const std::string& key)
 {
     worker_->enqueueGetRequest(key);
 }
 
+void StorageManager::storeCheckpoint(const std::string& key, uint64_t slot)
+{
+    worker_->enqueuePut(key, std::to_string(slot));
+}
+
+std::optional<uint64_t> StorageManager::loadCheckpoint(
+    const std::string& key) const
+{
+    std::string value;
+    rocksdb::Status status = db_->Get(rocksdb::ReadOptions(), key, &value);
+    if (!status.ok())
+        return std::nullopt;
+    try {
+        return std::stoull(value);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->warn(
+            "Ignoring malformed checkpoint {}: {}", key, e.what());
+        return std::nullopt;
+    }
+}
+
+void StorageManager::storeSnapshot(const std::string& key, std::string value)
+{
+    worker_->enqueuePut(key, std::move(value));
+}
+
+std::optional<std::string> StorageManager::loadSnapshot(
+    const std::string& key) const
+{
+    std::string value;
+    rocksdb::Status status = db_->Get(rocksdb::ReadOptions(), key, &value);
+    if (!status.ok())
+        return std::nullopt;
+    return value;
+}
+
 void StorageManager::backupData(const std::string& backupPath)
 {
     worker_->enqueueBackupRequest(backupPath);
@@ -23,39 +23,42 @@
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <string>
 #include <thread>
 #include <vector>
 
-#include <QObject>
-
 #include <rocksdb/db.h>
 
+#include "EventBus.hpp"
+
 namespace solana {
 
 class StorageWorker;
 
-class StorageManager : public QObject {
-    Q_OBJECT
-
+class StorageManager {
 public:
-    explicit StorageManager(
-        const std::string& dbPath, QObject* parent = nullptr);
+    explicit StorageManager(const std::string& dbPath);
     ~StorageManager();
 
     void storeBatch(
         const std::vector<std::pair<std::string, std::string>>& batch);
+    void storeBatch(std::vector<std::pair<std::string, std::string>>&& batch);
     void getTransaction(const std::string& key);
+    void storeCheckpoint(const std::string& key, uint64_t slot);
+    std::optional<uint64_t> loadCheckpoint(const std::string& key) const;
+    // Opaque state a component saves now and then and reads back on
+    // start, such as PnlEngine's positions.
+    void storeSnapshot(const std::string& key, std::string value);
+    std::optional<std::string> loadSnapshot(const std::string& key) const;
     void backupData(const std::string& backupPath);
     uint64_t getTotalStoredTransactions() const;
     uint64_t getTotalBatches() const;
     void optimizeDb();
 
-Q_SIGNALS:
-    void transactionRetrieved(
-        const std::string& key, std::optional<std::string> value);
-    void backupCompleted(
-        const std::string& path, bool success, const QString& message);
-    void storageError(const QString& errorMessage);
+    Event<const std::string&, std::optional<std::string>>
+        transactionRetrieved;
+    Event<const std::string&, bool, const std::string&> backupCompleted;
+    Event<const std::string&> storageError;
 
 private:
     void initializeDatabase(const std::string& dbPath);
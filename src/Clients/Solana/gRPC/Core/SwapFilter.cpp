@@ -22,177 +22,304 @@
 
 namespace solana {
 
+namespace {
+    std::optional<Pubkey> parseKey(const std::string& text)
+    {
+        auto key = Pubkey::fromBase58(text);
+        if (!key)
+            Logger::getLogger()->warn(
+                "SwapFilter: ignoring invalid address {}", text);
+        return key;
+    }
+
+    void insertKeys(PubkeySet& keys, const json& list)
+    {
+        keys.clear();
+        for (const auto& text : list) {
+            if (auto key = parseKey(text.get<std::string>()))
+                keys.insert(*key);
+        }
+    }
+
+    // smart_wallets_file and smart_wallets together.
+    std::shared_ptr<const WalletSet> loadWallets(const json& config)
+    {
+        std::vector<Pubkey> wallets;
+        if (config.contains("smart_wallets_file"))
+            wallets = WalletSet::readFile(
+                config["smart_wallets_file"].get<std::string>());
+        if (config.contains("smart_wallets")) {
+            for (const auto& text : config["smart_wallets"]) {
+                if (auto key = parseKey(text.get<std::string>()))
+                    wallets.push_back(*key);
+            }
+        }
+        return std::make_shared<const WalletSet>(wallets);
+    }
+}
+
 SwapFilter::SwapFilter(
     std::unordered_set<std::string> smartWallets, double minSwapAmount)
     : TransactionFilter()
-    , smartWallets_(std::move(smartWallets))
-    , minSwapAmount_(minSwapAmount)
+    , config_(std::make_unique<const Config>())
 {
-    tokenNames_[WSOL_MINT] = "SOL";
-    tokenNames_["EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v"] = "USDC";
+    std::vector<Pubkey> keys;
+    for (const auto& wallet : smartWallets) {
+        if (auto key = parseKey(wallet))
+            keys.push_back(*key);
+    }
+    auto wallets = std::make_shared<const WalletSet>(keys);
+    config_.update([&](Config& config) {
+        config.smartWallets = wallets;
+        config.minSwapAmount = minSwapAmount;
+        // Further names come from the token_names config.
+        config.tokenNames[WSOL_MINT] = "SOL";
+        config.tokenNames[*Pubkey::fromBase58(
+            "EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v")]
+            = "USDC";
+        config.tokenNames[*Pubkey::fromBase58(
+            "Es9vMFrzaCERmJfrF4H2FYD4KCoNkY11McCe8BenwNYB")]
+            = "USDT";
+    });
     Logger::getLogger()->info(
         "SwapFilter initialized with {} wallets, min swap: {}",
-        smartWallets_.size(), minSwapAmount_);
+        wallets->size(), minSwapAmount);
 }
 
 void SwapFilter::processTransaction(
     const std::string& sourceId, const geyser::SubscribeUpdateTransaction& tx)
+{
+    // The view points into the serialized bytes, which must outlive it.
+    const std::string wire = tx.SerializeAsString();
+    TransactionView view;
+    if (view.scanTransaction(wire) && view.resolve())
+        processView(sourceId, view);
+}
+
+void SwapFilter::processView(
+    const std::string& sourceId, const TransactionView& view)
 {
     incrementProcessCount();
     try {
-        const auto& meta = tx.transaction().meta();
-        std::vector<TokenBalance> preBalances, postBalances;
-        for (const auto& tb : meta.pre_token_balances()) {
-            preBalances.push_back(
-                { tb.owner(), tb.mint(), tb.ui_token_amount().ui_amount(),
-                    tokenNames_.count(tb.mint()) ? tokenNames_.at(tb.mint())
-                                                 : tb.mint().substr(0, 8) });
+        auto config = config_.read();
+        // One probe of the wallet set per (owner, mint) delta; each wallet
+        // is handled at its first delta.
+        const auto& deltas = view.balanceDeltas;
+        for (size_t i = 0; i < deltas.size(); ++i) {
+            if (!config->smartWallets->contains(deltas[i].owner))
+                continue;
+            bool seen = false;
+            for (size_t j = 0; j < i && !seen; ++j) {
+                seen = deltas[j].owner == deltas[i].owner;
+            }
+            if (!seen)
+                detectSwaps(view, deltas[i].owner, *config);
         }
-        for (const auto& tb : meta.post_token_balances()) {
-            postBalances.push_back(
-                { tb.owner(), tb.mint(), tb.ui_token_amount().ui_amount(),
-                    tokenNames_.count(tb.mint()) ? tokenNames_.at(tb.mint())
-                                                 : tb.mint().substr(0, 8) });
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error(
+            "SwapFilter error processing transaction: {}", e.what());
+    }
+}
+
+void SwapFilter::detectSwaps(
+    const TransactionView& view, const Pubkey& wallet, const Config& config)
+{
+    // The SOL leg is the wallet's own lamports plus those of its token
+    // accounts. That takes in WSOL wrapped or unwrapped along the way and
+    // cancels the rent of token accounts it opens or closes.
+    int64_t lamports = 0;
+    for (size_t i = 0; i < view.keys.size(); ++i) {
+        if (view.keys[i] == wallet) {
+            lamports += view.lamportChange(i);
+            break;
         }
+    }
+    if (!view.keys.empty() && view.keys[0] == wallet)
+        lamports += static_cast<int64_t>(view.fee);
 
-        std::unordered_map<std::string, double> wsolChanges;
-        for (const auto& pre : preBalances) {
-            if (pre.mint == WSOL_MINT) {
-                for (const auto& post : postBalances) {
-                    if (post.owner == pre.owner && post.mint == WSOL_MINT) {
-                        double change = post.amount - pre.amount;
-                        if (std::fabs(change) > 1e-6)
-                            wsolChanges[pre.owner] = change;
-                    }
-                }
-            }
+    // Token legs, at most a handful even for multi-hop routes; mints the
+    // route only passes through net out to zero and drop out here.
+    std::vector<const TransactionView::BalanceDelta*> legs;
+    size_t bought = 0;
+    for (const auto& delta : view.balanceDeltas) {
+        if (delta.owner != wallet)
+            continue;
+        lamports += delta.accountLamports;
+        if (delta.mint != WSOL_MINT && delta.change() != 0) {
+            legs.push_back(&delta);
+            bought += delta.increased();
         }
+    }
+    if (legs.empty())
+        return;
+    size_t sold = legs.size() - bought;
+
+    double solAmount = std::fabs(static_cast<double>(lamports)) / 1e9;
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+                      .count();
+    for (const auto* leg : legs) {
+        double tokenAmount = std::fabs(leg->uiChange());
+        if (tokenAmount < config.minSwapAmount)
+            continue;
 
-        bool matched = false;
-        for (const auto& pre : preBalances) {
-            if (smartWallets_.contains(pre.owner) && pre.mint != WSOL_MINT) {
-                for (const auto& post : postBalances) {
-                    if (post.owner == pre.owner && post.mint == pre.mint) {
-                        double tokenChange = post.amount - pre.amount;
-                        if (std::fabs(tokenChange) > 1e-6
-                            && std::fabs(tokenChange) >= minSwapAmount_) {
-                            SwapInfo swap { pre.owner, pre.mint, pre.tokenName,
-                                std::fabs(tokenChange),
-                                wsolChanges.count(pre.owner)
-                                    ? std::fabs(wsolChanges.at(pre.owner))
-                                    : 0.0,
-                                tokenChange > 0 ? "buy" : "sell",
-                                tx.transaction().signature(),
-                                std::chrono::system_clock::now() };
-                            {
-                                std::lock_guard lock(recentSwapsMutex_);
-                                recentSwaps_.push_back(std::move(swap));
-                                if (recentSwaps_.size() > maxRecentSwaps_) {
-                                    recentSwaps_.erase(recentSwaps_.begin());
-                                }
-                            }
-                            incrementMatchCount();
-                            Logger::getLogger()->info(
-                                "Swap detected: {} {} {:.6f} {} (tx: {})",
-                                pre.owner, swap.direction, tokenChange,
-                                pre.tokenName, tx.transaction().signature());
-
-                            // Emit signal to notify GUI
-                            json swapInfo;
-                            swapInfo["wallet"] = swap.wallet;
-                            swapInfo["mint"] = swap.tokenMint;
-                            swapInfo["token_name"] = swap.tokenName;
-                            swapInfo["token_amount"] = swap.tokenAmount;
-                            swapInfo["sol_amount"] = swap.solAmount;
-                            swapInfo["direction"] = swap.direction;
-                            swapInfo["signature"] = swap.signature;
-                            swapInfo["timestamp"] = std::chrono::duration_cast<
-                                std::chrono::milliseconds>(
-                                swap.timestamp.time_since_epoch())
-                                                        .count();
-                            matched = true;
-                        }
-                    }
+        SwapInfo swap { wallet, leg->mint,
+            Signature::fromBytes(view.signature), tokenAmount, leg->change(),
+            leg->decimals, leg->increased(), solAmount, false, {}, 0.0, 0.0,
+            now };
+
+        // Priced only when this leg is alone on its side; the quote is the
+        // one token on the other side, or SOL when there is none.
+        size_t same = leg->increased() ? bought : sold;
+        size_t opposite = legs.size() - same;
+        if (same == 1 && opposite == 1) {
+            for (const auto* other : legs) {
+                if (other->increased() != leg->increased()) {
+                    swap.hasQuote = true;
+                    swap.quoteMint = other->mint;
+                    swap.quoteAmount = std::fabs(other->uiChange());
                 }
             }
+        } else if (same == 1 && opposite == 0 && lamports != 0
+            && (lamports < 0) == leg->increased()) {
+            swap.hasQuote = true;
+            swap.quoteMint = WSOL_MINT;
+            swap.quoteAmount = solAmount;
         }
+        if (swap.hasQuote)
+            swap.price = swap.quoteAmount / tokenAmount;
 
-        return;
-    } catch (const std::exception& e) {
-        Logger::getLogger()->error(
-            "SwapFilter error processing transaction: {}", e.what());
-        return;
+        if (Logger::getLogger()->should_log(spdlog::level::info))
+            Logger::getLogger()->info(
+                "Swap detected: {} {} {:.6f} {} for {:.6f} {} (tx: {})",
+                wallet.toBase58(), swap.buy ? "buy" : "sell", tokenAmount,
+                tokenName(config, swap.tokenMint), swap.quoteAmount,
+                swap.hasQuote ? tokenName(config, swap.quoteMint) : "",
+                swap.signature.toBase58());
+        {
+            std::lock_guard lock(recentSwapsMutex_);
+            recentSwaps_.push(swap);
+        }
+        if (!swapDetected.empty())
+            swapDetected.publish(swap);
+        incrementMatchCount();
+    }
+}
+
+std::string SwapFilter::tokenName(const Config& config, const Pubkey& mint)
+{
+    auto name = config.tokenNames.find(mint);
+    return name != config.tokenNames.end() ? name->second
+                                           : mint.toBase58().substr(0, 8);
+}
+
+std::optional<SubscriptionFilter> SwapFilter::subscription() const
+{
+    // Every swap we report has a smart wallet as signer, which puts it in
+    // the transaction's account keys.
+    auto config = config_.read();
+    SubscriptionFilter filter;
+    for (const auto& wallet : *config->smartWallets) {
+        filter.accountInclude.push_back(wallet.toBase58());
     }
+    return filter;
 }
 
 void SwapFilter::updateConfig(const std::string& config)
 {
     try {
         auto json = json::parse(config);
-        std::lock_guard lock(mutex_);
-        if (json.contains("smart_wallets")) {
-            smartWallets_.clear();
-            for (const auto& wallet : json["smart_wallets"]) {
-                smartWallets_.insert(wallet.get<std::string>());
+        // The wallet set is the one part too large to copy with the rest,
+        // so it is built before the update and shared between snapshots.
+        std::shared_ptr<const WalletSet> wallets;
+        if (json.contains("smart_wallets")
+            || json.contains("smart_wallets_file"))
+            wallets = loadWallets(json);
+        // Built on this thread from a copy; filter threads keep matching
+        // against the previous snapshot until it is swapped in.
+        config_.update([&json, &wallets](Config& next) {
+            if (wallets) {
+                next.smartWallets = std::move(wallets);
+                Logger::getLogger()->info("Updated smart wallets: {}",
+                    next.smartWallets->size());
             }
-            Logger::getLogger()->info(
-                "Updated smart wallets: {}", smartWallets_.size());
-        }
-        if (json.contains("min_swap_amount")) {
-            minSwapAmount_ = json["min_swap_amount"].get<double>();
-            Logger::getLogger()->info(
-                "Updated min swap amount: {}", minSwapAmount_);
-        }
-        if (json.contains("tracked_tokens")) {
-            trackedTokens_.clear();
-            for (const auto& token : json["tracked_tokens"]) {
-                trackedTokens_.insert(token.get<std::string>());
+            if (json.contains("min_swap_amount")) {
+                next.minSwapAmount = json["min_swap_amount"].get<double>();
+                Logger::getLogger()->info(
+                    "Updated min swap amount: {}", next.minSwapAmount);
             }
-            Logger::getLogger()->info(
-                "Updated tracked tokens: {}", trackedTokens_.size());
-        }
-        if (json.contains("ignored_tokens")) {
-            ignoredTokens_.clear();
-            for (const auto& token : json["ignored_tokens"]) {
-                ignoredTokens_.insert(token.get<std::string>());
+            if (json.contains("tracked_tokens")) {
+                insertKeys(next.trackedTokens, json["tracked_tokens"]);
+                Logger::getLogger()->info(
+                    "Updated tracked tokens: {}", next.trackedTokens.size());
             }
-            Logger::getLogger()->info(
-                "Updated ignored tokens: {}", ignoredTokens_.size());
-        }
-        if (json.contains("token_names")) {
-            for (const auto& [mint, name] : json["token_names"].items()) {
-                tokenNames_[mint] = name.get<std::string>();
+            if (json.contains("ignored_tokens")) {
+                insertKeys(next.ignoredTokens, json["ignored_tokens"]);
+                Logger::getLogger()->info(
+                    "Updated ignored tokens: {}", next.ignoredTokens.size());
             }
-            Logger::getLogger()->info(
-                "Updated token names: {}", tokenNames_.size());
-        }
+            if (json.contains("token_names")) {
+                for (const auto& [mint, name] : json["token_names"].items()) {
+                    if (auto key = Pubkey::fromBase58(mint))
+                        next.tokenNames[*key] = name.get<std::string>();
+                }
+                Logger::getLogger()->info(
+                    "Updated token names: {}", next.tokenNames.size());
+            }
+        });
     } catch (const std::exception& e) {
         Logger::getLogger()->error(
             "Failed to update SwapFilter config: {}", e.what());
     }
 }
 
+json SwapFilter::toJson(
+    uint64_t sequence, const SwapInfo& swap, const Config& config)
+{
+    json result;
+    result["seq"] = sequence;
+    result["wallet"] = swap.wallet.toBase58();
+    result["token_mint"] = swap.tokenMint.toBase58();
+    result["token_name"] = tokenName(config, swap.tokenMint);
+    result["token_amount"] = swap.tokenAmount;
+    result["token_raw_amount"] = swap.tokenRawAmount;
+    result["decimals"] = swap.decimals;
+    result["sol_amount"] = swap.solAmount;
+    result["quote_mint"] = swap.hasQuote ? swap.quoteMint.toBase58() : "";
+    result["quote_name"]
+        = swap.hasQuote ? tokenName(config, swap.quoteMint) : "";
+    result["quote_amount"] = swap.quoteAmount;
+    result["price"] = swap.price;
+    result["direction"] = swap.buy ? "buy" : "sell";
+    result["signature"] = swap.signature.toBase58();
+    auto time = std::chrono::system_clock::to_time_t(
+        std::chrono::system_clock::time_point(
+            std::chrono::milliseconds(swap.timestampMs)));
+    std::stringstream ss;
+    ss << std::put_time(std::gmtime(&time), "%Y-%m-%d %H:%M:%S");
+    result["timestamp"] = ss.str();
+    return result;
+}
+
 json SwapFilter::getRecentSwaps(size_t maxEntries) const
 {
-    std::lock_guard lock(recentSwapsMutex_);
     json result = json::array();
-    size_t count = 0;
-    for (auto it = recentSwaps_.rbegin();
-        it != recentSwaps_.rend() && count < maxEntries; ++it, ++count) {
-        json swap;
-        swap["wallet"] = it->wallet;
-        swap["token_mint"] = it->tokenMint;
-        swap["token_name"] = it->tokenName;
-        swap["token_amount"] = it->tokenAmount;
-        swap["sol_amount"] = it->solAmount;
-        swap["direction"] = it->direction;
-        swap["signature"] = it->signature;
-        auto time = std::chrono::system_clock::to_time_t(it->timestamp);
-        std::stringstream ss;
-        ss << std::put_time(std::gmtime(&time), "%Y-%m-%d %H:%M:%S");
-        swap["timestamp"] = ss.str();
-        result.push_back(swap);
-    }
+    auto config = config_.read();
+    recentSwaps_.latest(
+        maxEntries, [&](uint64_t sequence, const SwapInfo& swap) {
+            result.push_back(toJson(sequence, swap, *config));
+        });
     return result;
 }
+
+json SwapFilter::getSwapsSince(uint64_t since, size_t maxEntries) const
+{
+    json swaps = json::array();
+    auto config = config_.read();
+    uint64_t next = recentSwaps_.since(
+        since, maxEntries, [&](uint64_t sequence, const SwapInfo& swap) {
+            swaps.push_back(toJson(sequence, swap, *config));
+        });
+    return { { "swaps", swaps }, { "next", next } };
+}
 }
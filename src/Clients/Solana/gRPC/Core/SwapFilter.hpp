@@ -19,7 +19,6 @@
 #pragma once
 
 #include <mutex>
-#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -27,7 +26,12 @@
 
 using json = nlohmann::json;
 
+#include "EventBus.hpp"
+#include "Pubkey.hpp"
+#include "RcuPtr.hpp"
+#include "RecentRing.hpp"
 #include "TransactionFilter.hpp"
+#include "WalletSet.hpp"
 
 namespace solana {
 
@@ -37,42 +41,76 @@ public:
         double minSwapAmount = 1.0);
     void processTransaction(const std::string& sourceId,
         const geyser::SubscribeUpdateTransaction& tx) override;
+    void processView(
+        const std::string& sourceId, const TransactionView& view) override;
     void updateConfig(const std::string& config) override;
 
+    bool needsFullTransaction() const override
+    {
+        return false;
+    }
+
     std::string name() const override
     {
         return "SwapFilter";
     }
 
-    json getRecentSwaps(size_t maxEntries = 100) const;
-
-private:
-    struct TokenBalance {
-        std::string owner;
-        std::string mint;
-        double amount;
-        std::string tokenName;
-    };
+    std::optional<SubscriptionFilter> subscription() const override;
 
+    // Kept binary and formatted only when read.
     struct SwapInfo {
-        std::string wallet;
-        std::string tokenMint;
-        std::string tokenName;
+        Pubkey wallet;
+        Pubkey tokenMint;
+        Signature signature;
         double tokenAmount;
+        uint64_t tokenRawAmount;
+        uint32_t decimals;
+        bool buy;
+        // Net SOL the wallet moved, WSOL and account rent included and the
+        // fee left out.
         double solAmount;
-        std::string direction;
-        std::string signature;
-        std::chrono::system_clock::time_point timestamp;
+        // What the token was traded against: SOL, or the one token on the
+        // other side. Absent when several tokens share a side, since the
+        // split between them cannot be told.
+        bool hasQuote;
+        Pubkey quoteMint;
+        double quoteAmount;
+        // quoteAmount per token, 0 without a quote.
+        double price;
+        int64_t timestampMs;
     };
 
-    const std::string WSOL_MINT = "So11111111111111111111111111111111111111112";
-    std::unordered_set<std::string> smartWallets_;
-    std::unordered_set<std::string> trackedTokens_;
-    std::unordered_set<std::string> ignoredTokens_;
-    std::unordered_map<std::string, std::string> tokenNames_;
-    double minSwapAmount_;
-    std::vector<SwapInfo> recentSwaps_;
-    mutable std::mutex recentSwapsMutex_;
-    const size_t maxRecentSwaps_ = 1000;
+    // Newest first.
+    json getRecentSwaps(size_t maxEntries = 100) const;
+    // Oldest first from sequence since on, as {"swaps": [...], "next": n}
+    // where n is the since to ask for next.
+    json getSwapsSince(uint64_t since, size_t maxEntries = 100) const;
+
+    // Every swap detected, on the filter thread that found it.
+    Event<const SwapInfo&> swapDetected;
+
+private:
+    // Replaced as a whole by updateConfig(), never changed in place.
+    struct Config {
+        std::shared_ptr<const WalletSet> smartWallets
+            = std::make_shared<const WalletSet>();
+        PubkeySet trackedTokens;
+        PubkeySet ignoredTokens;
+        PubkeyMap<std::string> tokenNames;
+        double minSwapAmount { 1.0 };
+    };
+
+    void detectSwaps(const TransactionView& view, const Pubkey& wallet,
+        const Config& config);
+    static std::string tokenName(const Config& config, const Pubkey& mint);
+    static json toJson(
+        uint64_t sequence, const SwapInfo& swap, const Config& config);
+
+    const Pubkey WSOL_MINT
+        = *Pubkey::fromBase58("So11111111111111111111111111111111111111112");
+    RcuPtr<Config> config_;
+    RecentRing<SwapInfo> recentSwaps_ { 1024 };
+    // Serializes writers of recentSwaps_; readers never take it.
+    std::mutex recentSwapsMutex_;
 };
 }
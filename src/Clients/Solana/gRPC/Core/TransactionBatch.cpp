@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TransactionBatch.hpp"
+
+#include <algorithm>
+
+#include "TransactionView.hpp"
+
+#include "../Utils/Logger.hpp"
+
+namespace solana {
+
+namespace {
+    google::protobuf::ArenaOptions arenaOptions()
+    {
+        google::protobuf::ArenaOptions options;
+        options.start_block_size = 64 * 1024;
+        options.max_block_size = 1024 * 1024;
+        return options;
+    }
+}
+
+TransactionBatch::TransactionBatch(size_t reserve)
+{
+    entries_.reserve(reserve);
+}
+
+TransactionBatch::~TransactionBatch() = default;
+
+bool TransactionBatch::append(const grpc::ByteBuffer& frame)
+{
+    std::vector<grpc::Slice> slices;
+    if (!frame.Dump(&slices).ok())
+        return false;
+
+    std::string wire;
+    wire.reserve(frame.Length());
+    for (const auto& slice : slices) {
+        wire.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+    }
+    return append(std::move(wire));
+}
+
+bool TransactionBatch::append(std::string wire)
+{
+    bytesCopied_ += wire.size();
+
+    thread_local TransactionView header;
+    if (!header.scanHeader(wire))
+        return false;
+
+    maxSlot_ = std::max(maxSlot_, header.slot);
+    entries_.push_back({ std::string(header.signature), std::move(wire),
+        header.slot, nullptr });
+    parsed_ = false;
+    return true;
+}
+
+void TransactionBatch::append(Entry entry)
+{
+    maxSlot_ = std::max(maxSlot_, entry.slot);
+    entries_.push_back(std::move(entry));
+    parsed_ = false;
+}
+
+std::vector<TransactionBatch::Entry> TransactionBatch::takeEntries()
+{
+    return std::exchange(entries_, {});
+}
+
+void TransactionBatch::parseTransactions()
+{
+    if (parsed_)
+        return;
+
+    if (!arena_)
+        arena_ = std::make_unique<google::protobuf::Arena>(arenaOptions());
+    for (auto& entry : entries_) {
+        if (entry.transaction)
+            continue;
+        auto* update = google::protobuf::Arena::Create<geyser::SubscribeUpdate>(
+            arena_.get());
+        if (!update->ParseFromString(entry.wire)
+            || update->update_oneof_case()
+                != geyser::SubscribeUpdate::kTransaction) {
+            Logger::getLogger()->warn(
+                "Failed to parse Geyser frame of {} bytes", entry.wire.size());
+            continue;
+        }
+        entry.transaction = &update->transaction();
+    }
+    parsed_ = true;
+}
+
+void TransactionBatch::popBack()
+{
+    // The parsed message stays in the arena until the batch is destroyed.
+    if (!entries_.empty())
+        entries_.pop_back();
+}
+
+std::vector<std::pair<std::string, std::string>>
+TransactionBatch::releaseRecords()
+{
+    std::vector<std::pair<std::string, std::string>> records;
+    records.reserve(entries_.size());
+    for (auto& entry : entries_) {
+        records.emplace_back(
+            std::move(entry.signature), std::move(entry.wire));
+    }
+    return records;
+}
+}
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <google/protobuf/arena.h>
+
+#include <grpcpp/support/byte_buffer.h>
+
+#include <geyser.grpc.pb.h>
+
+namespace solana {
+
+/**
+ * A batch of raw Geyser transaction frames. Appending only scans the wire for
+ * the slot and signature; filters that want the protobuf message ask for
+ * parseTransactions(), which parses every entry exactly once into a
+ * batch-owned arena. The raw frame bytes are kept so they can be scanned
+ * again or handed to storage without re-serializing.
+ */
+class TransactionBatch {
+public:
+    struct Entry {
+        std::string signature;
+        std::string wire;
+        uint64_t slot { 0 };
+        // Null until parseTransactions(), and after it if parsing failed.
+        const geyser::SubscribeUpdateTransaction* transaction { nullptr };
+    };
+
+    explicit TransactionBatch(size_t reserve = 0);
+    ~TransactionBatch();
+
+    TransactionBatch(const TransactionBatch&) = delete;
+    TransactionBatch& operator=(const TransactionBatch&) = delete;
+
+    /**
+     * Copies one raw SubscribeUpdate frame into the batch. Returns false when
+     * the frame is malformed or is not a transaction update.
+     */
+    bool append(const grpc::ByteBuffer& frame);
+    bool append(std::string wire);
+    // Moves an entry over from another, not yet parsed, batch. Its bytes
+    // were counted as copied by the batch that took them in.
+    void append(Entry entry);
+    std::vector<Entry> takeEntries();
+
+    // Full protobuf parse of every entry that has not been parsed yet.
+    void parseTransactions();
+
+    bool isParsed() const
+    {
+        return parsed_;
+    }
+
+    void popBack();
+
+    std::vector<std::pair<std::string, std::string>> releaseRecords();
+
+    const std::vector<Entry>& entries() const
+    {
+        return entries_;
+    }
+
+    auto begin() const
+    {
+        return entries_.begin();
+    }
+
+    auto end() const
+    {
+        return entries_.end();
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+    bool empty() const
+    {
+        return entries_.empty();
+    }
+
+    uint64_t getBytesCopied() const
+    {
+        return bytesCopied_;
+    }
+
+    // Highest slot appended so far, including entries since popped.
+    uint64_t getMaxSlot() const
+    {
+        return maxSlot_;
+    }
+
+private:
+    std::unique_ptr<google::protobuf::Arena> arena_;
+    std::vector<Entry> entries_;
+    uint64_t bytesCopied_ { 0 };
+    uint64_t maxSlot_ { 0 };
+    bool parsed_ { false };
+};
+}
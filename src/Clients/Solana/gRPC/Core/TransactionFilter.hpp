@@ -18,13 +18,32 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <geyser.grpc.pb.h>
 
+#include "TransactionView.hpp"
+
 namespace solana {
 
+class AccountCache;
+
+// Accounts a filter can be served by upstream. A transaction is delivered
+// when it touches any account in accountInclude and all in accountRequired.
+struct SubscriptionFilter {
+    std::vector<std::string> accountInclude;
+    std::vector<std::string> accountRequired;
+
+    bool empty() const
+    {
+        return accountInclude.empty() && accountRequired.empty();
+    }
+};
+
 class TransactionFilter {
 public:
     virtual ~TransactionFilter() = default;
@@ -34,6 +53,25 @@ public:
     virtual void updateConfig(const std::string& config) = 0;
     virtual std::string name() const = 0;
 
+    // Filters that only read the fields in TransactionView override both of
+    // these, which spares the batch a full protobuf parse when no filter
+    // needs one.
+    virtual bool needsFullTransaction() const
+    {
+        return true;
+    }
+
+    virtual void processView(
+        const std::string& sourceId, const TransactionView& view)
+    {
+    }
+
+    // std::nullopt means the filter has to see every transaction.
+    virtual std::optional<SubscriptionFilter> subscription() const
+    {
+        return std::nullopt;
+    }
+
     uint64_t getProcessedCount() const
     {
         return processedCount_;
@@ -44,6 +82,12 @@ public:
         return matchedCount_;
     }
 
+    // Set by FilterManager before the filter sees its first transaction.
+    void setAccountCache(std::shared_ptr<const AccountCache> accounts)
+    {
+        accounts_ = std::move(accounts);
+    }
+
 protected:
     void incrementMatchCount()
     {
@@ -55,9 +99,17 @@ protected:
         ++processedCount_;
     }
 
+    // Latest state of the accounts the sources watch, or null when no
+    // source feeds one.
+    const AccountCache* accountCache() const
+    {
+        return accounts_.get();
+    }
+
     mutable std::mutex mutex_;
 
 private:
+    std::shared_ptr<const AccountCache> accounts_;
     uint64_t processedCount_ { 0 };
     uint64_t matchedCount_ { 0 };
 };
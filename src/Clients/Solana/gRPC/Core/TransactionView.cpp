@@ -0,0 +1,587 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TransactionView.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "WireReader.hpp"
+
+namespace solana {
+
+namespace {
+    using namespace wire;
+
+    // Field numbers from geyser.proto and solana-storage.proto.
+    namespace field {
+        constexpr uint32_t UPDATE_TRANSACTION = 4;
+
+        constexpr uint32_t UPDATE_TX_INFO = 1;
+        constexpr uint32_t UPDATE_TX_SLOT = 2;
+
+        constexpr uint32_t INFO_SIGNATURE = 1;
+        constexpr uint32_t INFO_IS_VOTE = 2;
+        constexpr uint32_t INFO_TRANSACTION = 3;
+        constexpr uint32_t INFO_META = 4;
+        constexpr uint32_t INFO_INDEX = 5;
+
+        constexpr uint32_t TRANSACTION_MESSAGE = 2;
+
+        constexpr uint32_t MESSAGE_ACCOUNT_KEYS = 2;
+        constexpr uint32_t MESSAGE_INSTRUCTIONS = 4;
+
+        constexpr uint32_t INSTRUCTION_PROGRAM_ID_INDEX = 1;
+        constexpr uint32_t INSTRUCTION_ACCOUNTS = 2;
+        constexpr uint32_t INSTRUCTION_DATA = 3;
+        // InnerInstruction only.
+        constexpr uint32_t INSTRUCTION_STACK_HEIGHT = 4;
+
+        constexpr uint32_t INNER_INDEX = 1;
+        constexpr uint32_t INNER_INSTRUCTIONS = 2;
+
+        constexpr uint32_t META_ERR = 1;
+        constexpr uint32_t META_FEE = 2;
+        constexpr uint32_t META_PRE_BALANCES = 3;
+        constexpr uint32_t META_POST_BALANCES = 4;
+        constexpr uint32_t META_INNER_INSTRUCTIONS = 5;
+        constexpr uint32_t META_LOG_MESSAGES = 6;
+        constexpr uint32_t META_PRE_TOKEN_BALANCES = 7;
+        constexpr uint32_t META_POST_TOKEN_BALANCES = 8;
+        constexpr uint32_t META_LOADED_WRITABLE = 12;
+        constexpr uint32_t META_LOADED_READONLY = 13;
+        constexpr uint32_t META_COMPUTE_UNITS = 16;
+
+        constexpr uint32_t BALANCE_ACCOUNT_INDEX = 1;
+        constexpr uint32_t BALANCE_MINT = 2;
+        constexpr uint32_t BALANCE_UI_TOKEN_AMOUNT = 3;
+        constexpr uint32_t BALANCE_OWNER = 4;
+
+        constexpr uint32_t AMOUNT_UI_AMOUNT = 1;
+        constexpr uint32_t AMOUNT_DECIMALS = 2;
+        constexpr uint32_t AMOUNT_AMOUNT = 3;
+    }
+
+    bool readUiTokenAmount(
+        std::string_view bytes, TransactionView::TokenBalance& balance)
+    {
+        WireReader reader(bytes);
+        while (!reader.done()) {
+            uint32_t number, type;
+            if (!reader.readTag(number, type))
+                return false;
+            uint64_t value;
+            if (number == field::AMOUNT_UI_AMOUNT && type == FIXED64) {
+                if (!reader.readFixed64(value))
+                    return false;
+                std::memcpy(&balance.uiAmount, &value, sizeof(value));
+            } else if (number == field::AMOUNT_DECIMALS && type == VARINT) {
+                if (!reader.readVarint(value))
+                    return false;
+                balance.decimals = static_cast<uint32_t>(value);
+            } else if (number == field::AMOUNT_AMOUNT
+                && type == LENGTH_DELIMITED) {
+                if (!reader.readBytes(balance.amount))
+                    return false;
+            } else if (!reader.skip(type)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool readTokenBalance(
+        std::string_view bytes, TransactionView::TokenBalance& balance)
+    {
+        WireReader reader(bytes);
+        while (!reader.done()) {
+            uint32_t number, type;
+            if (!reader.readTag(number, type))
+                return false;
+            uint64_t value;
+            std::string_view nested;
+            if (number == field::BALANCE_ACCOUNT_INDEX && type == VARINT) {
+                if (!reader.readVarint(value))
+                    return false;
+                balance.accountIndex = static_cast<uint32_t>(value);
+            } else if (number == field::BALANCE_MINT
+                && type == LENGTH_DELIMITED) {
+                if (!reader.readBytes(balance.mint))
+                    return false;
+            } else if (number == field::BALANCE_OWNER
+                && type == LENGTH_DELIMITED) {
+                if (!reader.readBytes(balance.owner))
+                    return false;
+            } else if (number == field::BALANCE_UI_TOKEN_AMOUNT
+                && type == LENGTH_DELIMITED) {
+                if (!reader.readBytes(nested)
+                    || !readUiTokenAmount(nested, balance))
+                    return false;
+            } else if (!reader.skip(type)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Repeated uint64 may arrive packed even where it usually is not, and
+    // the other way around, so both forms are accepted.
+    bool readPackedVarints(std::string_view bytes, std::vector<uint64_t>& out)
+    {
+        WireReader reader(bytes);
+        while (!reader.done()) {
+            if (!reader.readVarint(out.emplace_back()))
+                return false;
+        }
+        return true;
+    }
+
+    uint64_t parseAmount(std::string_view amount)
+    {
+        uint64_t value = 0;
+        std::from_chars(amount.data(), amount.data() + amount.size(), value);
+        return value;
+    }
+
+    constexpr uint32_t NO_BALANCE = std::numeric_limits<uint32_t>::max();
+
+    bool readInstruction(
+        std::string_view bytes, TransactionView::Instruction& instruction)
+    {
+        WireReader reader(bytes);
+        while (!reader.done()) {
+            uint32_t number, type;
+            if (!reader.readTag(number, type))
+                return false;
+            uint64_t value;
+            if (number == field::INSTRUCTION_PROGRAM_ID_INDEX
+                && type == VARINT) {
+                if (!reader.readVarint(value))
+                    return false;
+                instruction.programIdIndex = static_cast<uint32_t>(value);
+            } else if (number == field::INSTRUCTION_ACCOUNTS
+                && type == LENGTH_DELIMITED) {
+                if (!reader.readBytes(instruction.accounts))
+                    return false;
+            } else if (number == field::INSTRUCTION_DATA
+                && type == LENGTH_DELIMITED) {
+                if (!reader.readBytes(instruction.data))
+                    return false;
+            } else if (number == field::INSTRUCTION_STACK_HEIGHT
+                && type == VARINT) {
+                if (!reader.readVarint(value))
+                    return false;
+                instruction.stackHeight = static_cast<uint32_t>(value);
+            } else if (!reader.skip(type)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+double TransactionView::BalanceDelta::uiChange() const
+{
+    double raw = static_cast<double>(change());
+    return (increased() ? raw : -raw) / std::pow(10.0, decimals);
+}
+
+TransactionView::TransactionView()
+{
+    // Sized for a busy DEX transaction so steady state never reallocates.
+    accountKeys.reserve(64);
+    instructions.reserve(16);
+    innerInstructions.reserve(32);
+    preTokenBalances.reserve(16);
+    postTokenBalances.reserve(16);
+    preLamports.reserve(64);
+    postLamports.reserve(64);
+    logMessages.reserve(64);
+    loadedWritable_.reserve(32);
+    loadedReadonly_.reserve(32);
+    keys.reserve(64);
+    balanceDeltas.reserve(16);
+    deltaText_.reserve(16);
+    preByAccount_.reserve(64);
+}
+
+bool TransactionView::scan(std::string_view frame)
+{
+    clear();
+    WireReader reader(frame);
+    while (!reader.done()) {
+        uint32_t number, type;
+        if (!reader.readTag(number, type))
+            return false;
+        if (number == field::UPDATE_TRANSACTION && type == LENGTH_DELIMITED) {
+            std::string_view update;
+            return reader.readBytes(update) && scanUpdate(update, true);
+        }
+        if (!reader.skip(type))
+            return false;
+    }
+    return false;
+}
+
+bool TransactionView::scanTransaction(std::string_view update)
+{
+    clear();
+    return scanUpdate(update, true);
+}
+
+bool TransactionView::scanHeader(std::string_view frame)
+{
+    clear();
+    WireReader reader(frame);
+    while (!reader.done()) {
+        uint32_t number, type;
+        if (!reader.readTag(number, type))
+            return false;
+        if (number == field::UPDATE_TRANSACTION && type == LENGTH_DELIMITED) {
+            std::string_view update;
+            return reader.readBytes(update) && scanUpdate(update, false);
+        }
+        if (!reader.skip(type))
+            return false;
+    }
+    return false;
+}
+
+void TransactionView::clear()
+{
+    slot = 0;
+    index = 0;
+    isVote = false;
+    failed = false;
+    fee = 0;
+    computeUnits = 0;
+    signature = {};
+    accountKeys.clear();
+    staticKeyCount = 0;
+    instructions.clear();
+    innerInstructions.clear();
+    preTokenBalances.clear();
+    postTokenBalances.clear();
+    preLamports.clear();
+    postLamports.clear();
+    logMessages.clear();
+    loadedWritable_.clear();
+    loadedReadonly_.clear();
+    keys.clear();
+    balanceDeltas.clear();
+    deltaText_.clear();
+}
+
+bool TransactionView::resolve()
+{
+    keys.clear();
+    balanceDeltas.clear();
+    deltaText_.clear();
+    for (auto raw : accountKeys) {
+        auto key = Pubkey::fromBytes(raw);
+        if (!key)
+            return false;
+        keys.push_back(*key);
+    }
+    for (auto* list : { &instructions, &innerInstructions }) {
+        for (auto& instruction : *list) {
+            if (instruction.programIdIndex >= keys.size())
+                return false;
+            instruction.program = keys[instruction.programIdIndex];
+        }
+    }
+
+    // A token account holds a single mint, so its index alone joins the pre
+    // balance with the post one: one pass over each list, no searching.
+    preByAccount_.assign(keys.size(), NO_BALANCE);
+    for (size_t i = 0; i < preTokenBalances.size(); ++i) {
+        uint32_t account = preTokenBalances[i].accountIndex;
+        if (account >= keys.size())
+            return false;
+        preByAccount_[account] = static_cast<uint32_t>(i);
+    }
+    for (const auto& post : postTokenBalances) {
+        if (post.accountIndex >= keys.size())
+            return false;
+        uint32_t& pre = preByAccount_[post.accountIndex];
+        if (!addDelta(pre != NO_BALANCE ? &preTokenBalances[pre] : nullptr,
+                &post))
+            return false;
+        pre = NO_BALANCE;
+    }
+    // Whatever is left was closed by the transaction.
+    for (uint32_t pre : preByAccount_) {
+        if (pre != NO_BALANCE && !addDelta(&preTokenBalances[pre], nullptr))
+            return false;
+    }
+    return true;
+}
+
+int64_t TransactionView::lamportChange(size_t index) const
+{
+    if (index >= preLamports.size() || index >= postLamports.size())
+        return 0;
+    return static_cast<int64_t>(postLamports[index] - preLamports[index]);
+}
+
+bool TransactionView::addDelta(
+    const TokenBalance* pre, const TokenBalance* post)
+{
+    const TokenBalance& either = post ? *post : *pre;
+    if (pre && post && pre->mint != post->mint)
+        return false;
+    std::string_view ownerText = either.owner;
+    if (ownerText.empty() && pre)
+        ownerText = pre->owner;
+    if (ownerText.empty())
+        return true;
+
+    size_t i = 0;
+    while (i < deltaText_.size()
+        && deltaText_[i] != std::pair { ownerText, either.mint }) {
+        ++i;
+    }
+    if (i == deltaText_.size()) {
+        auto owner = Pubkey::fromBase58(ownerText);
+        auto mint = Pubkey::fromBase58(either.mint);
+        if (!owner || !mint)
+            return false;
+        deltaText_.emplace_back(ownerText, either.mint);
+        balanceDeltas.push_back({ *owner, *mint });
+    }
+
+    auto& delta = balanceDeltas[i];
+    delta.decimals = either.decimals;
+    if (pre)
+        delta.preAmount += parseAmount(pre->amount);
+    if (post)
+        delta.postAmount += parseAmount(post->amount);
+    delta.accountLamports += lamportChange(either.accountIndex);
+    return true;
+}
+
+bool TransactionView::scanUpdate(std::string_view update, bool deep)
+{
+    WireReader reader(update);
+    bool hasInfo = false;
+    while (!reader.done()) {
+        uint32_t number, type;
+        if (!reader.readTag(number, type))
+            return false;
+        if (number == field::UPDATE_TX_INFO && type == LENGTH_DELIMITED) {
+            std::string_view info;
+            if (!reader.readBytes(info) || !scanInfo(info, deep))
+                return false;
+            hasInfo = true;
+        } else if (number == field::UPDATE_TX_SLOT && type == VARINT) {
+            if (!reader.readVarint(slot))
+                return false;
+        } else if (!reader.skip(type)) {
+            return false;
+        }
+    }
+    return hasInfo;
+}
+
+bool TransactionView::scanInfo(std::string_view info, bool deep)
+{
+    WireReader reader(info);
+    while (!reader.done()) {
+        uint32_t number, type;
+        if (!reader.readTag(number, type))
+            return false;
+        uint64_t value;
+        std::string_view nested;
+        if (number == field::INFO_SIGNATURE && type == LENGTH_DELIMITED) {
+            if (!reader.readBytes(signature))
+                return false;
+        } else if (number == field::INFO_IS_VOTE && type == VARINT) {
+            if (!reader.readVarint(value))
+                return false;
+            isVote = value != 0;
+        } else if (number == field::INFO_INDEX && type == VARINT) {
+            if (!reader.readVarint(index))
+                return false;
+        } else if (deep && number == field::INFO_TRANSACTION
+            && type == LENGTH_DELIMITED) {
+            if (!reader.readBytes(nested) || !scanTransactionMessage(nested))
+                return false;
+        } else if (deep && number == field::INFO_META
+            && type == LENGTH_DELIMITED) {
+            if (!reader.readBytes(nested) || !scanMeta(nested))
+                return false;
+        } else if (!reader.skip(type)) {
+            return false;
+        }
+    }
+
+    if (deep) {
+        // Meta may come before the message on the wire, so the loaded
+        // addresses are only appended once both have been read.
+        staticKeyCount = accountKeys.size();
+        accountKeys.insert(
+            accountKeys.end(), loadedWritable_.begin(), loadedWritable_.end());
+        accountKeys.insert(
+            accountKeys.end(), loadedReadonly_.begin(), loadedReadonly_.end());
+    }
+    return true;
+}
+
+bool TransactionView::scanTransactionMessage(std::string_view transaction)
+{
+    WireReader reader(transaction);
+    while (!reader.done()) {
+        uint32_t number, type;
+        if (!reader.readTag(number, type))
+            return false;
+        if (number == field::TRANSACTION_MESSAGE && type == LENGTH_DELIMITED) {
+            std::string_view message;
+            if (!reader.readBytes(message) || !scanMessage(message))
+                return false;
+        } else if (!reader.skip(type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TransactionView::scanMessage(std::string_view message)
+{
+    WireReader reader(message);
+    while (!reader.done()) {
+        uint32_t number, type;
+        if (!reader.readTag(number, type))
+            return false;
+        std::string_view bytes;
+        if (number == field::MESSAGE_ACCOUNT_KEYS
+            && type == LENGTH_DELIMITED) {
+            if (!reader.readBytes(bytes))
+                return false;
+            accountKeys.push_back(bytes);
+        } else if (number == field::MESSAGE_INSTRUCTIONS
+            && type == LENGTH_DELIMITED) {
+            if (!reader.readBytes(bytes)
+                || !readInstruction(bytes, instructions.emplace_back()))
+                return false;
+            instructions.back().stackHeight = 1;
+        } else if (!reader.skip(type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TransactionView::scanMeta(std::string_view meta)
+{
+    WireReader reader(meta);
+    while (!reader.done()) {
+        uint32_t number, type;
+        if (!reader.readTag(number, type))
+            return false;
+        std::string_view bytes;
+        if (type == LENGTH_DELIMITED) {
+            if (!reader.readBytes(bytes))
+                return false;
+            switch (number) {
+            case field::META_ERR:
+                failed = true;
+                break;
+            case field::META_PRE_BALANCES:
+                if (!readPackedVarints(bytes, preLamports))
+                    return false;
+                break;
+            case field::META_POST_BALANCES:
+                if (!readPackedVarints(bytes, postLamports))
+                    return false;
+                break;
+            case field::META_INNER_INSTRUCTIONS:
+                if (!scanInnerInstructions(bytes))
+                    return false;
+                break;
+            case field::META_LOG_MESSAGES:
+                logMessages.push_back(bytes);
+                break;
+            case field::META_PRE_TOKEN_BALANCES:
+                if (!readTokenBalance(bytes, preTokenBalances.emplace_back()))
+                    return false;
+                break;
+            case field::META_POST_TOKEN_BALANCES:
+                if (!readTokenBalance(bytes, postTokenBalances.emplace_back()))
+                    return false;
+                break;
+            case field::META_LOADED_WRITABLE:
+                loadedWritable_.push_back(bytes);
+                break;
+            case field::META_LOADED_READONLY:
+                loadedReadonly_.push_back(bytes);
+                break;
+            default:
+                break;
+            }
+        } else if (number == field::META_PRE_BALANCES && type == VARINT) {
+            if (!reader.readVarint(preLamports.emplace_back()))
+                return false;
+        } else if (number == field::META_POST_BALANCES && type == VARINT) {
+            if (!reader.readVarint(postLamports.emplace_back()))
+                return false;
+        } else if (number == field::META_FEE && type == VARINT) {
+            if (!reader.readVarint(fee))
+                return false;
+        } else if (number == field::META_COMPUTE_UNITS && type == VARINT) {
+            if (!reader.readVarint(computeUnits))
+                return false;
+        } else if (!reader.skip(type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TransactionView::scanInnerInstructions(std::string_view bytes)
+{
+    // The index may follow the instructions it applies to on the wire.
+    size_t first = innerInstructions.size();
+    uint64_t outerIndex = 0;
+    WireReader reader(bytes);
+    while (!reader.done()) {
+        uint32_t number, type;
+        if (!reader.readTag(number, type))
+            return false;
+        std::string_view nested;
+        if (number == field::INNER_INDEX && type == VARINT) {
+            if (!reader.readVarint(outerIndex))
+                return false;
+        } else if (number == field::INNER_INSTRUCTIONS
+            && type == LENGTH_DELIMITED) {
+            // InnerInstruction shares its first three fields with
+            // CompiledInstruction and adds stack_height.
+            if (!reader.readBytes(nested)
+                || !readInstruction(nested, innerInstructions.emplace_back()))
+                return false;
+        } else if (!reader.skip(type)) {
+            return false;
+        }
+    }
+    for (size_t i = first; i < innerInstructions.size(); ++i) {
+        innerInstructions[i].outerIndex = static_cast<uint32_t>(outerIndex);
+    }
+    return true;
+}
+}
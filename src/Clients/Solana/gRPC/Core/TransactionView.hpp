@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Pubkey.hpp"
+
+namespace solana {
+
+/**
+ * The fields of a SubscribeUpdateTransaction that filters look at, read
+ * straight off the wire. Every string is a view into the scanned buffer,
+ * which has to outlive the view. scan() clears the lists but keeps their
+ * capacity, so a view that is reused across transactions stops allocating
+ * once it has seen the largest one.
+ *
+ * resolve() then decodes what filters match on into binary keys. The
+ * FilterManager runs it once per transaction so every filter shares one
+ * decode instead of repeating it.
+ */
+class TransactionView {
+public:
+    struct Instruction {
+        uint32_t programIdIndex { 0 };
+        // One account index per byte.
+        std::string_view accounts;
+        std::string_view data;
+        // For inner instructions, the outer instruction that invoked them.
+        uint32_t outerIndex { 0 };
+        // 1 for outer instructions, 2 for what they invoke and so on. 0 for
+        // inner instructions from nodes that do not record it.
+        uint32_t stackHeight { 0 };
+        // Set by resolve().
+        Pubkey program;
+    };
+
+    struct TokenBalance {
+        uint32_t accountIndex { 0 };
+        std::string_view mint;
+        std::string_view owner;
+        // Raw integer amount as a decimal string.
+        std::string_view amount;
+        double uiAmount { 0.0 };
+        uint32_t decimals { 0 };
+    };
+
+    // Token balance change of one owner in one mint, summed over its token
+    // accounts. A token account missing on one side counts as empty there,
+    // as when it is created or closed by the transaction.
+    struct BalanceDelta {
+        Pubkey owner;
+        Pubkey mint;
+        // Raw integer amounts, exact where the UI amounts are rounded.
+        uint64_t preAmount { 0 };
+        uint64_t postAmount { 0 };
+        uint32_t decimals { 0 };
+        // Lamport change of the token accounts themselves: rent when they
+        // are opened or closed, plus the wrapped amount for WSOL.
+        int64_t accountLamports { 0 };
+
+        bool increased() const
+        {
+            return postAmount > preAmount;
+        }
+
+        uint64_t change() const
+        {
+            return increased() ? postAmount - preAmount
+                               : preAmount - postAmount;
+        }
+
+        double uiChange() const;
+    };
+
+    TransactionView();
+
+    // Scans a SubscribeUpdate frame. Returns false when it is malformed or
+    // not a transaction update.
+    bool scan(std::string_view frame);
+
+    // Scans a serialized SubscribeUpdateTransaction.
+    bool scanTransaction(std::string_view update);
+
+    // Like scan() but stops at slot, signature, vote flag and index.
+    bool scanHeader(std::string_view frame);
+
+    // Fills keys, the program of every instruction and balanceDeltas from
+    // the last scan. Returns false when a key, program or account index is
+    // malformed. Token balances without an owner, as in transactions from
+    // before owners were recorded, are left out of the deltas.
+    bool resolve();
+
+    // Lamport change of accountKeys[index], zero when it is out of range.
+    int64_t lamportChange(size_t index) const;
+
+    // Calls visit(instruction, outerIndex, innerIndex) for every
+    // instruction in the order they ran: each outer instruction, with an
+    // innerIndex of -1, and then the inner instructions it invoked.
+    template <typename Visit> void forEachInstruction(Visit&& visit) const
+    {
+        // Inner instructions come grouped by outer index, in order.
+        size_t inner = 0;
+        for (size_t outer = 0; outer < instructions.size(); ++outer) {
+            const auto outerIndex = static_cast<uint32_t>(outer);
+            visit(instructions[outer], outerIndex, -1);
+            for (; inner < innerInstructions.size()
+                 && innerInstructions[inner].outerIndex <= outerIndex;
+                ++inner) {
+                if (innerInstructions[inner].outerIndex == outerIndex)
+                    visit(innerInstructions[inner], outerIndex,
+                        static_cast<int32_t>(inner));
+            }
+        }
+    }
+
+    uint64_t slot { 0 };
+    uint64_t index { 0 };
+    bool isVote { false };
+    bool failed { false };
+    uint64_t fee { 0 };
+    uint64_t computeUnits { 0 };
+    std::string_view signature;
+
+    // Static keys from the message followed by the writable and then the
+    // readonly addresses loaded from lookup tables, which is the order
+    // instruction account indexes refer to.
+    std::vector<std::string_view> accountKeys;
+    size_t staticKeyCount { 0 };
+    std::vector<Instruction> instructions;
+    std::vector<Instruction> innerInstructions;
+    std::vector<TokenBalance> preTokenBalances;
+    std::vector<TokenBalance> postTokenBalances;
+    // Lamports of every account in accountKeys order.
+    std::vector<uint64_t> preLamports;
+    std::vector<uint64_t> postLamports;
+    std::vector<std::string_view> logMessages;
+
+    // Set by resolve(): accountKeys in binary, and the balance deltas.
+    std::vector<Pubkey> keys;
+    std::vector<BalanceDelta> balanceDeltas;
+
+private:
+    void clear();
+    bool scanUpdate(std::string_view update, bool deep);
+    bool scanInfo(std::string_view info, bool deep);
+    bool scanTransactionMessage(std::string_view transaction);
+    bool scanMessage(std::string_view message);
+    bool scanMeta(std::string_view meta);
+    bool scanInnerInstructions(std::string_view bytes);
+    bool addDelta(const TokenBalance* pre, const TokenBalance* post);
+
+    std::vector<std::string_view> loadedWritable_;
+    std::vector<std::string_view> loadedReadonly_;
+    // Base58 owner and mint of each balance delta, so each pair is only
+    // decoded once even though it shows up before and after.
+    std::vector<std::pair<std::string_view, std::string_view>> deltaText_;
+    // Pre balance of each account index, for joining it with the post one.
+    std::vector<uint32_t> preByAccount_;
+};
+}
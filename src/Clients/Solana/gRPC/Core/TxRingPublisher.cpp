@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TxRingPublisher.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace solana {
+
+namespace {
+    bool copyBytes(uint8_t* target, size_t size, std::string_view bytes)
+    {
+        if (bytes.size() != size)
+            return false;
+        std::memcpy(target, bytes.data(), size);
+        return true;
+    }
+
+    bool toRecord(const TransactionView& view, TxRingRecord& record)
+    {
+        record = TxRingRecord {};
+        record.slot = view.slot;
+        record.index = view.index;
+        record.fee = view.fee;
+        record.computeUnits = view.computeUnits;
+        record.flags = (view.isVote ? TX_RING_VOTE : 0u)
+            | (view.failed ? TX_RING_FAILED : 0u);
+        record.accountCount = static_cast<uint16_t>(
+            std::min<size_t>(view.accountKeys.size(), UINT16_MAX));
+        if (!copyBytes(
+                record.signature, sizeof(record.signature), view.signature))
+            return false;
+        if (!view.accountKeys.empty()
+            && !copyBytes(
+                record.feePayer, sizeof(record.feePayer), view.accountKeys[0]))
+            return false;
+
+        for (const auto& instruction : view.instructions) {
+            if (instruction.programIdIndex >= view.accountKeys.size())
+                continue;
+            std::string_view program
+                = view.accountKeys[instruction.programIdIndex];
+            if (program.size() != sizeof(record.programs[0]))
+                continue;
+            auto* begin = record.programs;
+            auto* end = record.programs + record.programCount;
+            if (std::any_of(begin, end, [program](const uint8_t(&key)[32]) {
+                    return std::memcmp(key, program.data(), sizeof(key)) == 0;
+                }))
+                continue;
+            if (record.programCount == TX_RING_MAX_PROGRAMS) {
+                record.flags |= TX_RING_PROGRAMS_TRUNCATED;
+                break;
+            }
+            std::memcpy(record.programs[record.programCount++],
+                program.data(), program.size());
+        }
+        return true;
+    }
+}
+
+TxRingPublisher::TxRingPublisher(const std::string& name, uint64_t capacity)
+    : writer_(name, capacity)
+{
+}
+
+void TxRingPublisher::publish(const TransactionBatch& batch)
+{
+    // Per thread, so the sink stages of different sources decode in
+    // parallel and only the copy into the ring is serialized.
+    thread_local TransactionView view;
+    thread_local std::vector<TxRingRecord> records;
+    records.resize(batch.size());
+    size_t count = 0;
+    for (const auto& entry : batch) {
+        if (view.scan(entry.wire) && toRecord(view, records[count]))
+            ++count;
+        else
+            ++malformed_;
+    }
+    if (count == 0)
+        return;
+
+    std::lock_guard lock(mutex_);
+    writer_.publish(records.data(), count);
+    published_ += count;
+}
+
+json TxRingPublisher::getStats() const
+{
+    json stats;
+    stats["name"] = writer_.name();
+    stats["capacity"] = writer_.capacity();
+    stats["epoch"] = writer_.epoch();
+    {
+        std::lock_guard lock(mutex_);
+        stats["head"] = writer_.head();
+    }
+    stats["published"] = published_.load();
+    stats["malformed"] = malformed_.load();
+    return stats;
+}
+}
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "TransactionBatch.hpp"
+#include "TransactionView.hpp"
+
+#include "../Shm/TxRingWriter.hpp"
+
+namespace solana {
+
+/**
+ * Decodes delivered transaction batches into TxRingRecords and appends them
+ * to a shared-memory ring for consumers on the same host. Batches from all
+ * pipelines go through one instance; each is decoded on the calling thread
+ * and written under a lock, so its records stay contiguous in the ring.
+ */
+class TxRingPublisher {
+public:
+    TxRingPublisher(const std::string& name, uint64_t capacity);
+
+    void publish(const TransactionBatch& batch);
+    json getStats() const;
+
+private:
+    TxRingWriter writer_;
+    mutable std::mutex mutex_;
+    std::atomic<uint64_t> published_ { 0 };
+    std::atomic<uint64_t> malformed_ { 0 };
+};
+}
@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WalletSet.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include "../Utils/Logger.hpp"
+
+namespace solana {
+
+namespace {
+    constexpr char FILE_MAGIC[8] = { 'W', 'A', 'L', 'L', 'E', 'T', 'S', '1' };
+
+    std::string_view trim(std::string_view text)
+    {
+        constexpr std::string_view SPACE = " \t\r\n";
+        size_t begin = text.find_first_not_of(SPACE);
+        if (begin == std::string_view::npos)
+            return {};
+        return text.substr(begin, text.find_last_not_of(SPACE) - begin + 1);
+    }
+}
+
+WalletSet::WalletSet(std::span<const Pubkey> wallets)
+{
+    if (wallets.empty())
+        return;
+    if (wallets.size() >= UINT32_MAX)
+        throw std::length_error("WalletSet: too many wallets");
+
+    // Between one half and one wallet a bucket.
+    const size_t buckets = std::bit_ceil(std::max<size_t>(wallets.size(), 2));
+    bucketShift_ = 64 - static_cast<unsigned>(std::countr_zero(buckets));
+
+    // Counting sort into buckets.
+    std::vector<uint64_t> hashes(wallets.size());
+    offsets_.assign(buckets + 1, 0);
+    for (size_t i = 0; i < wallets.size(); ++i) {
+        hashes[i] = PubkeyHash {}(wallets[i]);
+        ++offsets_[bucketOf(hashes[i]) + 1];
+    }
+    for (size_t bucket = 0; bucket < buckets; ++bucket) {
+        offsets_[bucket + 1] += offsets_[bucket];
+    }
+    std::vector<uint32_t> next(offsets_.begin(), offsets_.end() - 1);
+    keys_.resize(wallets.size());
+    for (size_t i = 0; i < wallets.size(); ++i) {
+        keys_[next[bucketOf(hashes[i])]++] = wallets[i];
+    }
+
+    // Duplicates share a bucket, so they are dropped bucket by bucket
+    // while the keys are packed down over the gaps.
+    uint32_t out = 0;
+    for (size_t bucket = 0; bucket < buckets; ++bucket) {
+        const uint32_t begin = offsets_[bucket];
+        const uint32_t end = offsets_[bucket + 1];
+        offsets_[bucket] = out;
+        for (uint32_t i = begin; i < end; ++i) {
+            auto kept = keys_.begin() + out;
+            if (std::find(keys_.begin() + offsets_[bucket], kept, keys_[i])
+                == kept)
+                keys_[out++] = keys_[i];
+        }
+    }
+    offsets_[buckets] = out;
+    keys_.resize(out);
+    keys_.shrink_to_fit();
+
+    bloom_.assign(std::max<size_t>(1,
+                      (keys_.size() * BLOOM_BITS_PER_KEY + 255) / 256),
+        BloomBlock {});
+    for (uint64_t hash : hashes) {
+        BloomBlock& block = bloom_[bloomBlockOf(hash)];
+        const auto low = static_cast<uint32_t>(hash);
+        for (size_t word = 0; word < 8; ++word) {
+            block.words[word] |= bloomBit(low, word);
+        }
+    }
+}
+
+size_t WalletSet::memoryBytes() const
+{
+    return keys_.capacity() * sizeof(Pubkey)
+        + offsets_.capacity() * sizeof(uint32_t)
+        + bloom_.capacity() * sizeof(BloomBlock);
+}
+
+std::vector<Pubkey> WalletSet::readFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("cannot open wallet list " + path);
+    const std::string data { std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>() };
+    if (file.bad())
+        throw std::runtime_error("cannot read wallet list " + path);
+
+    std::vector<Pubkey> wallets;
+    if (data.size() >= sizeof(FILE_MAGIC)
+        && std::memcmp(data.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) == 0) {
+        std::string_view keys
+            = std::string_view(data).substr(sizeof(FILE_MAGIC));
+        if (keys.size() % Pubkey::SIZE)
+            throw std::runtime_error("truncated wallet list " + path);
+        wallets.resize(keys.size() / Pubkey::SIZE);
+        std::memcpy(wallets.data(), keys.data(), keys.size());
+        return wallets;
+    }
+
+    size_t invalid = 0;
+    size_t firstInvalid = 0;
+    size_t lineNumber = 0;
+    for (size_t begin = 0; begin < data.size(); ++lineNumber) {
+        size_t end = std::min(data.find('\n', begin), data.size());
+        std::string_view line
+            = std::string_view(data).substr(begin, end - begin);
+        begin = end + 1;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+            continue;
+        if (auto key = Pubkey::fromBase58(line)) {
+            wallets.push_back(*key);
+        } else if (!invalid++) {
+            firstInvalid = lineNumber + 1;
+        }
+    }
+    if (invalid)
+        Logger::getLogger()->warn(
+            "{}: skipped {} invalid addresses, the first on line {}", path,
+            invalid, firstInvalid);
+    return wallets;
+}
+
+void WalletSet::writeFile(
+    const std::string& path, std::span<const Pubkey> wallets)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(wallets.data()),
+        static_cast<std::streamsize>(wallets.size_bytes()));
+    if (!file)
+        throw std::runtime_error("cannot write wallet list " + path);
+}
+}
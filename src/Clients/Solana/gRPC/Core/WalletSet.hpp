@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Pubkey.hpp"
+
+namespace solana {
+
+/**
+ * Immutable set of wallet addresses, sized for following millions of
+ * them. Keys are stored once, densely, grouped by hash bucket, with a
+ * table of 32-bit offsets to where each bucket starts: 38 to 42 bytes a
+ * wallet in all. A lookup reads the bucket's offsets and then compares
+ * one or two keys lying next to each other. A blocked bloom filter sits
+ * in front: almost every owner a filter checks is not tracked, and those
+ * are turned away after one 32-byte block read, without touching the
+ * offsets or the keys.
+ *
+ * Built whole from a list; a changed list means a new set.
+ */
+class WalletSet {
+public:
+    WalletSet() = default;
+    // Duplicates are dropped.
+    explicit WalletSet(std::span<const Pubkey> wallets);
+
+    // Reads a wallet list file: either one base58 address per line, with
+    // '#' starting a comment, or the binary form writeFile() produces.
+    // Invalid lines are skipped with a warning; an unreadable or
+    // truncated file throws std::runtime_error.
+    static std::vector<Pubkey> readFile(const std::string& path);
+    // Raw 32-byte keys after a short header, for lists that are reloaded
+    // often enough for base58 decoding to matter.
+    static void writeFile(
+        const std::string& path, std::span<const Pubkey> wallets);
+
+    bool contains(const Pubkey& wallet) const
+    {
+        if (keys_.empty())
+            return false;
+        const uint64_t hash = PubkeyHash {}(wallet);
+        if (!bloomMayContain(hash))
+            return false;
+        const size_t bucket = bucketOf(hash);
+        for (uint32_t i = offsets_[bucket]; i < offsets_[bucket + 1]; ++i) {
+            if (keys_[i] == wallet)
+                return true;
+        }
+        return false;
+    }
+
+    // The bloom filter alone: false means absent, true means probably
+    // present.
+    bool mayContain(const Pubkey& wallet) const
+    {
+        return !keys_.empty() && bloomMayContain(PubkeyHash {}(wallet));
+    }
+
+    size_t size() const
+    {
+        return keys_.size();
+    }
+
+    bool empty() const
+    {
+        return keys_.empty();
+    }
+
+    // Heap bytes held by keys, index and filter.
+    size_t memoryBytes() const;
+
+    // In no particular order.
+    std::vector<Pubkey>::const_iterator begin() const
+    {
+        return keys_.begin();
+    }
+
+    std::vector<Pubkey>::const_iterator end() const
+    {
+        return keys_.end();
+    }
+
+private:
+    // About 0.1% of absent wallets get past the filter at this density.
+    static constexpr size_t BLOOM_BITS_PER_KEY = 16;
+
+    // 256 bits, one set in each word per key.
+    struct alignas(32) BloomBlock {
+        uint32_t words[8];
+    };
+
+    static uint32_t bloomBit(uint32_t hash, size_t word)
+    {
+        // Odd multipliers spreading one 32-bit hash over eight words.
+        static constexpr uint32_t SALT[8] = { 0x47b6137bU, 0x44974d91U,
+            0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U,
+            0x5c6bfb31U };
+        return 1U << ((hash * SALT[word]) >> 27);
+    }
+
+    size_t bloomBlockOf(uint64_t hash) const
+    {
+        return static_cast<size_t>(((hash >> 32) * bloom_.size()) >> 32);
+    }
+
+    bool bloomMayContain(uint64_t hash) const
+    {
+        const BloomBlock& block = bloom_[bloomBlockOf(hash)];
+        const auto low = static_cast<uint32_t>(hash);
+        bool present = true;
+        for (size_t word = 0; word < 8; ++word) {
+            present &= (block.words[word] & bloomBit(low, word)) != 0;
+        }
+        return present;
+    }
+
+    size_t bucketOf(uint64_t hash) const
+    {
+        // Remixed so the bucket does not follow the bloom block.
+        return static_cast<size_t>(
+            (hash * 0x9e3779b97f4a7c15ULL) >> bucketShift_);
+    }
+
+    // Grouped by bucket; bucket b is keys_[offsets_[b], offsets_[b + 1]).
+    std::vector<Pubkey> keys_;
+    std::vector<uint32_t> offsets_;
+    std::vector<BloomBlock> bloom_;
+    unsigned bucketShift_ = 63;
+};
+}
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WindowAggregator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace solana {
+
+WindowAggregator::WindowAggregator(
+    std::string uniqueName, size_t maxKeys, size_t shards)
+    : uniqueName_(std::move(uniqueName))
+    , shardCount_(std::max<size_t>(shards, 1))
+    , maxKeysPerShard_(
+          std::max<size_t>((maxKeys + shardCount_ - 1) / shardCount_, 1))
+    , shards_(std::make_unique<Shard[]>(shardCount_))
+{
+}
+
+WindowAggregator::Shard& WindowAggregator::shardOf(const Pubkey& key) const
+{
+    return shards_[PubkeyHash {}(key) % shardCount_];
+}
+
+void WindowAggregator::record(const Pubkey& key, Side side, double volume,
+    const Pubkey& trader, int64_t timestampMs)
+{
+    if (timestampMs < 0)
+        return;
+    const uint64_t traderHash = PubkeyHash {}(trader);
+    bool late = false;
+    Shard& shard = shardOf(key);
+    {
+        std::lock_guard lock(shard.mutex);
+        Entry& entry = shard.entry(acquire(shard, key));
+        for (const Wheel& wheel : WHEELS) {
+            const auto period
+                = static_cast<uint32_t>(timestampMs / wheel.bucketMs);
+            Bucket& bucket
+                = entry.buckets[wheel.offset + period % wheel.buckets];
+            // Already reused for a later period: this one has left the
+            // window.
+            if (bucket.period > period) {
+                late = true;
+                continue;
+            }
+            if (bucket.period < period) {
+                bucket = Bucket {};
+                bucket.period = period;
+            }
+            ++bucket.swaps;
+            bucket.volume += volume;
+            if (side == Side::Buy)
+                ++bucket.buys;
+            else if (side == Side::Sell)
+                ++bucket.sells;
+            if (side != Side::Sell)
+                bucket.traders.add(traderHash);
+        }
+    }
+    records_.fetch_add(1, std::memory_order_relaxed);
+    if (late)
+        late_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t WindowAggregator::acquire(Shard& shard, const Pubkey& key)
+{
+    if (auto found = shard.index.find(key); found != shard.index.end()) {
+        const uint32_t id = found->second;
+        if (shard.head != id) {
+            unlink(shard, id);
+            pushFront(shard, id);
+        }
+        return id;
+    }
+    uint32_t id;
+    if (shard.links.size() < maxKeysPerShard_) {
+        id = static_cast<uint32_t>(shard.links.size());
+        shard.links.emplace_back();
+        if (id % CHUNK == 0)
+            shard.chunks.push_back(std::make_unique<Entry[]>(CHUNK));
+    } else {
+        id = shard.tail;
+        unlink(shard, id);
+        shard.index.erase(shard.entry(id).key);
+        shard.entry(id) = Entry {};
+        evicted_.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.entry(id).key = key;
+    shard.index.emplace(key, id);
+    pushFront(shard, id);
+    return id;
+}
+
+void WindowAggregator::unlink(Shard& shard, uint32_t id)
+{
+    Link& link = shard.links[id];
+    if (link.prev != NONE)
+        shard.links[link.prev].next = link.next;
+    else
+        shard.head = link.next;
+    if (link.next != NONE)
+        shard.links[link.next].prev = link.prev;
+    else
+        shard.tail = link.prev;
+    link = Link {};
+}
+
+void WindowAggregator::pushFront(Shard& shard, uint32_t id)
+{
+    Link& link = shard.links[id];
+    link.prev = NONE;
+    link.next = shard.head;
+    if (shard.head != NONE)
+        shard.links[shard.head].prev = id;
+    shard.head = id;
+    if (shard.tail == NONE)
+        shard.tail = id;
+}
+
+WindowAggregator::Totals WindowAggregator::sum(
+    const Entry& entry, Window window, int64_t nowMs)
+{
+    const Wheel& wheel = WHEELS[static_cast<size_t>(window)];
+    const auto now = static_cast<uint32_t>(
+        std::max<int64_t>(nowMs, 0) / wheel.bucketMs);
+    Totals totals;
+    HyperLogLog traders;
+    for (uint32_t i = 0; i < wheel.buckets; ++i) {
+        const Bucket& bucket = entry.buckets[wheel.offset + i];
+        if (bucket.period == 0 || bucket.period > now
+            || now - bucket.period >= wheel.buckets)
+            continue;
+        totals.volume += bucket.volume;
+        totals.buys += bucket.buys;
+        totals.sells += bucket.sells;
+        totals.swaps += bucket.swaps;
+        traders.merge(bucket.traders);
+    }
+    if (totals.swaps > 0)
+        totals.uniqueTraders = traders.estimate();
+    return totals;
+}
+
+std::optional<WindowAggregator::Totals> WindowAggregator::totals(
+    const Pubkey& key, Window window, int64_t nowMs) const
+{
+    const Shard& shard = shardOf(key);
+    std::lock_guard lock(shard.mutex);
+    auto found = shard.index.find(key);
+    if (found == shard.index.end())
+        return std::nullopt;
+    return sum(shard.entry(found->second), window, nowMs);
+}
+
+json WindowAggregator::get(const Pubkey& key, int64_t nowMs) const
+{
+    std::array<Totals, WHEELS.size()> windows;
+    {
+        const Shard& shard = shardOf(key);
+        std::lock_guard lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found == shard.index.end())
+            return nullptr;
+        for (size_t w = 0; w < windows.size(); ++w) {
+            windows[w] = sum(shard.entry(found->second),
+                static_cast<Window>(w), nowMs);
+        }
+    }
+    return { { "1m", toJson(windows[0]) }, { "5m", toJson(windows[1]) },
+        { "1h", toJson(windows[2]) } };
+}
+
+json WindowAggregator::toJson(const Totals& totals) const
+{
+    return { { "volume", totals.volume }, { "buys", totals.buys },
+        { "sells", totals.sells }, { "swaps", totals.swaps },
+        { uniqueName_, std::llround(totals.uniqueTraders) } };
+}
+
+json WindowAggregator::getStats() const
+{
+    size_t keys = 0;
+    size_t bytes = 0;
+    for (size_t s = 0; s < shardCount_; ++s) {
+        const Shard& shard = shards_[s];
+        std::lock_guard lock(shard.mutex);
+        keys += shard.index.size();
+        bytes += shard.chunks.size() * CHUNK * sizeof(Entry)
+            + shard.links.capacity() * sizeof(Link)
+            + shard.index.values().capacity()
+                * sizeof(std::pair<Pubkey, uint32_t>)
+            + shard.index.bucket_count() * 8;
+    }
+    return { { "keys", keys }, { "max_keys", maxKeysPerShard_ * shardCount_ },
+        { "records", records_.load(std::memory_order_relaxed) },
+        { "late", late_.load(std::memory_order_relaxed) },
+        { "evicted", evicted_.load(std::memory_order_relaxed) },
+        { "approx_bytes", bytes } };
+}
+}
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "HyperLogLog.hpp"
+#include "Pubkey.hpp"
+
+namespace solana {
+
+/**
+ * Rolling 1 minute, 5 minute and 1 hour activity per key, a mint or a
+ * pool: volume, buys, sells, swaps and distinct traders.
+ *
+ * Each key keeps a timing wheel per window, each coarser than the last:
+ * 6 buckets of 10 seconds, 5 of a minute and 12 of 5 minutes. A bucket
+ * remembers which period it holds and is cleared when the wheel comes
+ * round to it again, so nothing ever has to expire events and memory per
+ * key is fixed however busy it is. A record adds to one bucket per wheel;
+ * a read sums the buckets of one wheel that are still in the window and
+ * merges their HyperLogLog sketches. Windows move a bucket at a time, so
+ * the minute is the last 50 to 60 seconds.
+ *
+ * The number of keys is capped; a new key past the cap takes the place of
+ * the one least recently recorded. Keys are spread over shards by hash,
+ * each behind its own mutex.
+ */
+class WindowAggregator {
+public:
+    enum class Side : uint8_t { Buy, Sell, Unknown };
+    enum class Window : uint8_t { OneMinute, FiveMinutes, OneHour };
+
+    struct Totals {
+        double volume { 0.0 };
+        uint32_t buys { 0 };
+        uint32_t sells { 0 };
+        uint32_t swaps { 0 };
+        // Traders of buys, and of swaps whose side is unknown.
+        double uniqueTraders { 0.0 };
+    };
+
+    // uniqueName is what the distinct traders are called in get(). Each
+    // shard holds its share of maxKeys, so eviction can start somewhat
+    // before maxKeys keys are in use.
+    explicit WindowAggregator(std::string uniqueName = "unique_buyers",
+        size_t maxKeys = 100'000, size_t shards = 16);
+
+    // A record older than a wheel's oldest bucket is left out of that
+    // wheel's window, and counted as late.
+    void record(const Pubkey& key, Side side, double volume,
+        const Pubkey& trader, int64_t timestampMs);
+
+    std::optional<Totals> totals(
+        const Pubkey& key, Window window, int64_t nowMs) const;
+    // Totals of every window as {"1m": {...}, "5m": {...}, "1h": {...}},
+    // or null for a key never recorded or since evicted.
+    json get(const Pubkey& key, int64_t nowMs) const;
+    json getStats() const;
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Wheel {
+        int64_t bucketMs;
+        uint32_t buckets;
+        // Of its first bucket in Entry::buckets.
+        uint32_t offset;
+    };
+
+    static constexpr std::array<Wheel, 3> WHEELS { { { 10'000, 6, 0 },
+        { 60'000, 5, 6 }, { 300'000, 12, 11 } } };
+    static constexpr uint32_t BUCKETS = 23;
+
+    struct Bucket {
+        // Which bucketMs-long period since the epoch it holds, 0 if none.
+        uint32_t period { 0 };
+        uint32_t buys { 0 };
+        uint32_t sells { 0 };
+        uint32_t swaps { 0 };
+        double volume { 0.0 };
+        HyperLogLog traders;
+    };
+
+    struct Entry {
+        Pubkey key;
+        std::array<Bucket, BUCKETS> buckets;
+    };
+
+    // Least recently recorded at the tail. Apart from the entries, so
+    // moving a key to the front does not touch its neighbours' buckets.
+    struct Link {
+        uint32_t prev { NONE };
+        uint32_t next { NONE };
+    };
+
+    // Entries are allocated a chunk at a time, which wastes at most one
+    // chunk per shard where a growing vector would waste up to half.
+    static constexpr uint32_t CHUNK = 256;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        PubkeyMap<uint32_t> index;
+        std::vector<std::unique_ptr<Entry[]>> chunks;
+        std::vector<Link> links;
+        uint32_t head { NONE };
+        uint32_t tail { NONE };
+
+        Entry& entry(uint32_t id) const
+        {
+            return chunks[id / CHUNK][id % CHUNK];
+        }
+    };
+
+    Shard& shardOf(const Pubkey& key) const;
+    uint32_t acquire(Shard& shard, const Pubkey& key);
+    static void unlink(Shard& shard, uint32_t id);
+    static void pushFront(Shard& shard, uint32_t id);
+    static Totals sum(const Entry& entry, Window window, int64_t nowMs);
+    json toJson(const Totals& totals) const;
+
+    const std::string uniqueName_;
+    const size_t shardCount_;
+    const size_t maxKeysPerShard_;
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic<uint64_t> records_ { 0 };
+    std::atomic<uint64_t> late_ { 0 };
+    std::atomic<uint64_t> evicted_ { 0 };
+};
+}
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace solana {
+
+namespace wire {
+    enum Type : uint32_t {
+        VARINT = 0,
+        FIXED64 = 1,
+        LENGTH_DELIMITED = 2,
+        FIXED32 = 5,
+    };
+}
+
+// Minimal protobuf wire reader over a borrowed buffer. Every method returns
+// false on truncated or malformed input and leaves the reader in an
+// unspecified position.
+class WireReader {
+public:
+    explicit WireReader(std::string_view bytes)
+        : pos_(reinterpret_cast<const uint8_t*>(bytes.data()))
+        , end_(pos_ + bytes.size())
+    {
+    }
+
+    bool done() const
+    {
+        return pos_ == end_;
+    }
+
+    bool readVarint(uint64_t& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64 && pos_ != end_; shift += 7) {
+            uint8_t byte = *pos_++;
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    bool readTag(uint32_t& number, uint32_t& type)
+    {
+        uint64_t tag;
+        if (!readVarint(tag) || (tag >> 3) == 0)
+            return false;
+        number = static_cast<uint32_t>(tag >> 3);
+        type = static_cast<uint32_t>(tag & 7);
+        return true;
+    }
+
+    bool readBytes(std::string_view& bytes)
+    {
+        uint64_t length;
+        if (!readVarint(length) || length > static_cast<uint64_t>(end_ - pos_))
+            return false;
+        bytes = { reinterpret_cast<const char*>(pos_),
+            static_cast<size_t>(length) };
+        pos_ += length;
+        return true;
+    }
+
+    bool readFixed64(uint64_t& value)
+    {
+        if (end_ - pos_ < 8)
+            return false;
+        value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | pos_[i];
+        }
+        pos_ += 8;
+        return true;
+    }
+
+    bool skip(uint32_t type)
+    {
+        uint64_t ignored;
+        std::string_view bytes;
+        switch (type) {
+        case wire::VARINT:
+            return readVarint(ignored);
+        case wire::FIXED64:
+            return readFixed64(ignored);
+        case wire::LENGTH_DELIMITED:
+            return readBytes(bytes);
+        case wire::FIXED32:
+            if (end_ - pos_ < 4)
+                return false;
+            pos_ += 4;
+            return true;
+        default:
+            // Groups are not used by any Geyser message.
+            return false;
+        }
+    }
+
+private:
+    const uint8_t* pos_;
+    const uint8_t* end_;
+};
+}
@@ -0,0 +1,400 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Headless ingest daemon: runs the Geyser pipeline from the same TOML as the
+// desktop app, without Qt, and serves its stats over HTTP until SIGINT or
+// SIGTERM.
+//
+//   tengu_ingestd [config.toml]
+
+#include <chrono>
+#include <csignal>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include <boost/asio.hpp>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+#include "../Core/ConfigManager.hpp"
+#include "../Core/DataSourceManager.hpp"
+#include "../Core/DexFilter.hpp"
+#include "../Core/FilterManager.hpp"
+#include "../Core/MetricsManager.hpp"
+#include "../Core/NotificationManager.hpp"
+#include "../Core/PnlEngine.hpp"
+#include "../Core/RuleFilter.hpp"
+#include "../Core/StorageManager.hpp"
+#include "../Core/SwapFilter.hpp"
+#include "../Core/WindowAggregator.hpp"
+#include "../HTTP/HttpServer.hpp"
+#include "../Utils/Logger.hpp"
+
+using namespace solana;
+
+namespace {
+constexpr char PNL_SNAPSHOT_KEY[] = "snapshot:pnl";
+constexpr auto PNL_SNAPSHOT_INTERVAL = std::chrono::minutes(5);
+
+// Must run before any thread is started: new threads inherit the mask.
+void pinProcess(const std::vector<int>& cpus)
+{
+    if (cpus.empty())
+        return;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        Logger::getLogger()->warn("Cannot pin to {} CPU(s)", cpus.size());
+        return;
+    }
+#elif defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for (int cpu : cpus) {
+        if (cpu < static_cast<int>(sizeof(DWORD_PTR) * 8))
+            mask |= DWORD_PTR { 1 } << cpu;
+    }
+    if (!SetProcessAffinityMask(GetCurrentProcess(), mask)) {
+        Logger::getLogger()->warn("Cannot pin to {} CPU(s)", cpus.size());
+        return;
+    }
+#else
+    Logger::getLogger()->warn("CPU affinity is not supported here");
+    return;
+#endif
+    Logger::getLogger()->info("Pinned to {} CPU(s)", cpus.size());
+}
+
+http::response<http::string_body> jsonResponse(
+    const http::request<http::string_body>& req, const json& body)
+{
+    http::response<http::string_body> res { http::status::ok, req.version() };
+    res.set(http::field::content_type, "application/json");
+    res.body() = body.dump();
+    res.prepare_payload();
+    return res;
+}
+
+size_t maxEntries(const std::map<std::string, std::string>& query)
+{
+    auto it = query.find("max");
+    if (it == query.end())
+        return 10;
+    try {
+        return std::stoul(it->second);
+    } catch (const std::exception&) {
+        return 10;
+    }
+}
+
+// The "since" sequence a client is paging from, if it is paging.
+std::optional<uint64_t> sinceSequence(
+    const std::map<std::string, std::string>& query)
+{
+    auto it = query.find("since");
+    if (it == query.end())
+        return std::nullopt;
+    try {
+        return std::stoull(it->second);
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+// Milliseconds since the epoch, as the filters stamp what they see.
+int64_t nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+}
+
+int main(int argc, char* argv[])
+{
+    std::string configPath = argc > 1 ? argv[1] : "config.toml";
+    try {
+        ConfigManager config(configPath);
+        spdlog::set_level(spdlog::level::from_str(config.getLogLevel()));
+        pinProcess(config.getCpuAffinity());
+
+        StorageManager storage(config.getDbPath());
+        NotificationManager notifier(config);
+        FilterManager filters;
+        filters.setMaxConcurrentFilters(config.getMaxConcurrentFilters());
+
+        // Filters go in before the sources so the first subscription is
+        // already narrowed to them.
+        std::shared_ptr<SwapFilter> swaps;
+        if (auto swapConfig = config.getFilterConfig("swap")) {
+            swaps = std::make_shared<SwapFilter>(
+                std::unordered_set<std::string> {});
+            swaps->updateConfig(*swapConfig);
+            filters.addFilter("swap", swaps);
+        }
+        // Fed by the swap filter's threads, so it is created first and
+        // destroyed after the sources stop.
+        std::unique_ptr<PnlEngine> pnl;
+        if (swaps) {
+            pnl = std::make_unique<PnlEngine>();
+            if (auto snapshot = storage.loadSnapshot(PNL_SNAPSHOT_KEY)) {
+                if (pnl->restore(*snapshot))
+                    Logger::getLogger()->info("Restored PnL of {} wallets",
+                        pnl->getStats()["wallets"].get<size_t>());
+                else
+                    Logger::getLogger()->warn(
+                        "Ignoring malformed PnL snapshot");
+            }
+            swaps->swapDetected.subscribe(
+                [&pnl](const SwapFilter::SwapInfo& swap) {
+                    pnl->onSwap(swap);
+                });
+        }
+        // Rolling activity: per mint from SwapFilter, per pool from
+        // DexFilter. Decoded DEX swaps carry no mints; pools get a side
+        // and SOL volume only where the decoder knows the SOL leg.
+        std::unique_ptr<WindowAggregator> mintActivity;
+        if (swaps) {
+            mintActivity = std::make_unique<WindowAggregator>();
+            swaps->swapDetected.subscribe(
+                [&mintActivity](const SwapFilter::SwapInfo& swap) {
+                    mintActivity->record(swap.tokenMint,
+                        swap.buy ? WindowAggregator::Side::Buy
+                                 : WindowAggregator::Side::Sell,
+                        swap.solAmount, swap.wallet, swap.timestampMs);
+                });
+        }
+        std::shared_ptr<DexFilter> dex;
+        std::unique_ptr<WindowAggregator> poolActivity;
+        if (auto dexConfig = config.getFilterConfig("dex")) {
+            dex = std::make_shared<DexFilter>(
+                std::unordered_set<std::string> {});
+            dex->updateConfig(*dexConfig);
+            poolActivity
+                = std::make_unique<WindowAggregator>("unique_traders");
+            dex->swapDecoded.subscribe(
+                [&poolActivity](const DexSwap& swap, int64_t timestampMs) {
+                    auto side = WindowAggregator::Side::Unknown;
+                    if (swap.side == DexSwap::Side::Buy)
+                        side = WindowAggregator::Side::Buy;
+                    else if (swap.side == DexSwap::Side::Sell)
+                        side = WindowAggregator::Side::Sell;
+                    poolActivity->record(swap.pool, side,
+                        static_cast<double>(swap.solAmount) / 1e9, swap.user,
+                        timestampMs);
+                });
+            filters.addFilter("dex", dex);
+        }
+        std::shared_ptr<RuleFilter> rules;
+        if (auto ruleConfig = config.getFilterConfig("rules")) {
+            rules = std::make_shared<RuleFilter>();
+            rules->updateConfig(*ruleConfig);
+            rules->ruleMatched.subscribe([&notifier](const std::string& rule,
+                                             const std::string& signature) {
+                notifier.sendBatchNotifications(
+                    "Rule " + rule + " matched " + signature);
+            });
+            filters.addFilter("rules", rules);
+        }
+
+        // Created before the sources so that it outlives their health
+        // check thread, which feeds it.
+        std::unique_ptr<MetricsManager> metrics;
+        if (int port = config.getMetricsPort(); port > 0)
+            metrics = std::make_unique<MetricsManager>(
+                static_cast<uint16_t>(port));
+        DataSourceManager sources(config, storage, notifier, filters);
+        sources.statsUpdated.subscribe([&metrics](const json& stats) {
+            Logger::getLogger()->debug("Stats: {}", stats.dump());
+            if (metrics)
+                metrics->updateDataSourceStats(stats);
+        });
+
+        HttpServer httpServer(config);
+        httpServer.addRoute("/stats",
+            [&](const auto& req, const auto& path, const auto& query) {
+                json stats;
+                stats["data_sources"] = sources.getStats();
+                stats["filters"] = filters.getFilterStats();
+                stats["filter_executor"] = filters.getExecutorStats();
+                stats["notifications"] = notifier.getNotificationStats();
+                if (rules)
+                    stats["rules"] = rules->getRuleStats();
+                if (pnl)
+                    stats["pnl"] = pnl->getStats();
+                if (mintActivity)
+                    stats["activity"]["mints"] = mintActivity->getStats();
+                if (poolActivity)
+                    stats["activity"]["pools"] = poolActivity->getStats();
+                stats["storage"] = { { "total_transactions",
+                                         storage.getTotalStoredTransactions() },
+                    { "total_batches", storage.getTotalBatches() } };
+                return jsonResponse(req, stats);
+            });
+        // ?pubkey=<address>: the account as the sources last saw it.
+        httpServer.addRoute("/account",
+            [&](const auto& req, const auto& path, const auto& query) {
+                auto pubkey = query.find("pubkey");
+                auto key = pubkey == query.end()
+                    ? std::nullopt
+                    : Pubkey::fromBase58(pubkey->second);
+                if (!key) {
+                    auto res
+                        = jsonResponse(req, { { "error", "invalid pubkey" } });
+                    res.result(http::status::bad_request);
+                    return res;
+                }
+                std::string_view raw(
+                    reinterpret_cast<const char*>(key->bytes.data()),
+                    key->bytes.size());
+                json account;
+                if (!sources.getAccountCache()->visit(
+                        raw, [&](const AccountCache::Account& cached) {
+                            account = AccountCache::toJson(raw, cached);
+                        })) {
+                    auto res = jsonResponse(
+                        req, { { "error", "account not cached" } });
+                    res.result(http::status::not_found);
+                    return res;
+                }
+                return jsonResponse(req, account);
+            });
+        // p50/p99/p999 per pipeline stage, by source and in total.
+        httpServer.addRoute("/debug/latency",
+            [&](const auto& req, const auto& path, const auto& query) {
+                return jsonResponse(req, sources.getLatencyStats());
+            });
+        if (swaps) {
+            httpServer.addRoute("/recent_swaps",
+                [&](const auto& req, const auto& path, const auto& query) {
+                    if (auto since = sinceSequence(query))
+                        return jsonResponse(req,
+                            swaps->getSwapsSince(*since, maxEntries(query)));
+                    return jsonResponse(
+                        req, swaps->getRecentSwaps(maxEntries(query)));
+                });
+        }
+        if (pnl) {
+            // ?by=pnl|volume|win_rate&max=N
+            httpServer.addRoute("/leaderboard",
+                [&](const auto& req, const auto& path, const auto& query) {
+                    auto by = query.find("by");
+                    auto ranking = by == query.end()
+                        ? PnlEngine::Ranking::RealizedPnl
+                        : PnlEngine::rankingFromName(by->second)
+                              .value_or(PnlEngine::Ranking::RealizedPnl);
+                    return jsonResponse(
+                        req, pnl->leaderboard(ranking, maxEntries(query)));
+                });
+            // ?wallet=<address>
+            httpServer.addRoute("/pnl",
+                [&](const auto& req, const auto& path, const auto& query) {
+                    auto wallet = query.find("wallet");
+                    auto key = wallet == query.end()
+                        ? std::nullopt
+                        : Pubkey::fromBase58(wallet->second);
+                    return jsonResponse(
+                        req, key ? pnl->wallet(*key) : json(nullptr));
+                });
+        }
+        if (dex) {
+            httpServer.addRoute("/recent_dex",
+                [&](const auto& req, const auto& path, const auto& query) {
+                    if (auto since = sinceSequence(query))
+                        return jsonResponse(req,
+                            dex->getDexTransactionsSince(
+                                *since, maxEntries(query)));
+                    return jsonResponse(req,
+                        dex->getRecentDexTransactions(maxEntries(query)));
+                });
+        }
+        if (mintActivity || poolActivity) {
+            // ?mint=<address> or ?pool=<address>
+            httpServer.addRoute("/activity",
+                [&](const auto& req, const auto& path, const auto& query) {
+                    json result = nullptr;
+                    auto mint = query.find("mint");
+                    auto pool = query.find("pool");
+                    if (mint != query.end() && mintActivity) {
+                        if (auto key = Pubkey::fromBase58(mint->second))
+                            result = mintActivity->get(*key, nowMs());
+                    } else if (pool != query.end() && poolActivity) {
+                        if (auto key = Pubkey::fromBase58(pool->second))
+                            result = poolActivity->get(*key, nowMs());
+                    }
+                    return jsonResponse(req, result);
+                });
+        }
+        httpServer.start();
+
+        if (metrics) {
+            metrics->setLatencySource(
+                [&sources](const auto& visit) { sources.visitLatency(visit); });
+        }
+
+        net::io_context io;
+        net::signal_set signals(io, SIGINT, SIGTERM);
+        signals.async_wait([&io](const beast::error_code& ec, int signal) {
+            if (!ec)
+                Logger::getLogger()->info("Signal {}, shutting down", signal);
+            io.stop();
+        });
+        // Positions survive a restart up to the last snapshot.
+        net::steady_timer pnlTimer(io);
+        std::function<void()> schedulePnlSnapshot = [&] {
+            pnlTimer.expires_after(PNL_SNAPSHOT_INTERVAL);
+            pnlTimer.async_wait([&](const beast::error_code& ec) {
+                if (ec)
+                    return;
+                storage.storeSnapshot(PNL_SNAPSHOT_KEY, pnl->snapshot());
+                schedulePnlSnapshot();
+            });
+        };
+        if (pnl)
+            schedulePnlSnapshot();
+        Logger::getLogger()->info("Ingest daemon running with {}", configPath);
+        io.run();
+        httpServer.stop();
+        if (pnl)
+            storage.storeSnapshot(PNL_SNAPSHOT_KEY, pnl->snapshot());
+        // Scrapes must stop reading the sources before they are destroyed.
+        if (metrics)
+            metrics->setLatencySource(nullptr);
+    } catch (const std::exception& e) {
+        Logger::getLogger()->error("Ingest daemon error: {}", e.what());
+        return 1;
+    }
+    return 0;
+}
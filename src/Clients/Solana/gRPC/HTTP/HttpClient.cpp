@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "HttpClient.hpp"
+
+#include <exception>
+#include <stdexcept>
+
+namespace solana {
+
+HttpClient::HttpClient(std::chrono::milliseconds timeout)
+    : timeout_(timeout)
+    , ssl_(net::ssl::context::tls_client)
+{
+    ssl_.set_default_verify_paths();
+    ssl_.set_verify_mode(net::ssl::verify_peer);
+}
+
+unsigned HttpClient::postJson(const std::string& url, const std::string& body)
+{
+    Target target = parseUrl(url);
+    net::io_context ioc;
+    unsigned status = 0;
+    std::exception_ptr failure;
+    net::co_spawn(ioc, post(target, body),
+        [&](std::exception_ptr error, unsigned result) {
+            failure = error;
+            status = result;
+        });
+    ioc.run();
+    if (failure)
+        std::rethrow_exception(failure);
+    return status;
+}
+
+HttpClient::Target HttpClient::parseUrl(const std::string& url)
+{
+    constexpr std::string_view SCHEME = "https://";
+    if (url.compare(0, SCHEME.size(), SCHEME) != 0)
+        throw std::invalid_argument("Only https:// URLs are supported");
+
+    Target target;
+    auto hostEnd = url.find('/', SCHEME.size());
+    std::string authority = url.substr(SCHEME.size(),
+        hostEnd == std::string::npos ? std::string::npos
+                                     : hostEnd - SCHEME.size());
+    target.path = hostEnd == std::string::npos ? "/" : url.substr(hostEnd);
+    auto colon = authority.rfind(':');
+    if (colon != std::string::npos) {
+        target.host = authority.substr(0, colon);
+        target.port = authority.substr(colon + 1);
+    } else {
+        target.host = authority;
+        target.port = "443";
+    }
+    if (target.host.empty())
+        throw std::invalid_argument("URL has no host: " + url);
+    return target;
+}
+
+net::awaitable<unsigned> HttpClient::post(
+    const Target& target, const std::string& body)
+{
+    auto executor = co_await net::this_coro::executor;
+    beast::ssl_stream<beast::tcp_stream> stream(executor, ssl_);
+    if (!SSL_set_tlsext_host_name(stream.native_handle(), target.host.c_str()))
+        throw std::runtime_error("Cannot set TLS server name");
+    stream.set_verify_callback(net::ssl::host_name_verification(target.host));
+
+    // One deadline for the whole exchange rather than per operation.
+    auto& socket = beast::get_lowest_layer(stream);
+    socket.expires_after(timeout_);
+    tcp::resolver resolver(executor);
+    auto endpoints = co_await resolver.async_resolve(
+        target.host, target.port, net::use_awaitable);
+    co_await socket.async_connect(endpoints, net::use_awaitable);
+    co_await stream.async_handshake(
+        net::ssl::stream_base::client, net::use_awaitable);
+
+    http::request<http::string_body> request { http::verb::post, target.path,
+        11 };
+    request.set(http::field::host, target.host);
+    request.set(http::field::content_type, "application/json");
+    request.body() = body;
+    request.prepare_payload();
+    co_await http::async_write(stream, request, net::use_awaitable);
+
+    beast::flat_buffer buffer;
+    http::response<http::string_body> response;
+    co_await http::async_read(stream, buffer, response, net::use_awaitable);
+
+    // Servers routinely drop the connection without a close_notify.
+    beast::error_code ignored;
+    co_await stream.async_shutdown(
+        net::redirect_error(net::use_awaitable, ignored));
+    co_return response.result_int();
+}
+}
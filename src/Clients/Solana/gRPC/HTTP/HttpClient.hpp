@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+
+namespace solana {
+
+// Minimal blocking HTTPS client for webhook-style POSTs, so notification
+// plugins need no Qt network stack.
+class HttpClient {
+public:
+    explicit HttpClient(
+        std::chrono::milliseconds timeout = std::chrono::seconds(10));
+
+    // Returns the HTTP status code; throws on DNS, TLS or socket errors and
+    // when the whole exchange takes longer than the timeout.
+    unsigned postJson(const std::string& url, const std::string& body);
+
+private:
+    struct Target {
+        std::string host;
+        std::string port;
+        std::string path;
+    };
+
+    static Target parseUrl(const std::string& url);
+    net::awaitable<unsigned> post(const Target& target, const std::string& body);
+
+    std::chrono::milliseconds timeout_;
+    net::ssl::context ssl_;
+};
+}
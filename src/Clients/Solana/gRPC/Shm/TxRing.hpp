@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace solana {
+
+// Layout of the shared-memory transaction ring. One writer appends fixed
+// size records; any number of readers follow it with their own cursor and
+// never write to the segment, so a slow reader only loses records to being
+// lapped and cannot hold the writer back.
+//
+// The segment is a TxRingHeader followed by `capacity` TxRingSlots. Record
+// n lives in slot n % capacity. Its version is 2n + 1 while the writer
+// fills it and 2n + 2 once it is complete; the header's head is the
+// sequence number of the next record, stored after the record itself.
+// Readers copy a record and re-check the version, as with a seqlock.
+//
+// Any change to these structs must bump TX_RING_VERSION.
+
+constexpr uint64_t TX_RING_MAGIC = 0x474e49525854474eULL; // "NGTXRING"
+constexpr uint32_t TX_RING_VERSION = 1;
+constexpr size_t TX_RING_MAX_PROGRAMS = 8;
+
+// TxRingRecord::flags bits.
+constexpr uint32_t TX_RING_VOTE = 1u << 0;
+constexpr uint32_t TX_RING_FAILED = 1u << 1;
+// The transaction invoked more top-level programs than fit.
+constexpr uint32_t TX_RING_PROGRAMS_TRUNCATED = 1u << 2;
+
+// One decoded transaction. Keys and the signature are raw bytes, not
+// base58.
+struct TxRingRecord {
+    uint64_t slot;
+    uint64_t index;
+    uint64_t fee;
+    uint64_t computeUnits;
+    uint32_t flags;
+    uint16_t accountCount;
+    // Distinct top-level program ids in `programs`, in invocation order.
+    uint8_t programCount;
+    uint8_t reserved;
+    uint8_t signature[64];
+    uint8_t feePayer[32];
+    uint8_t programs[TX_RING_MAX_PROGRAMS][32];
+};
+
+struct alignas(64) TxRingSlot {
+    std::atomic<uint64_t> version;
+    TxRingRecord record;
+};
+
+struct TxRingHeader {
+    // Written last, once the rest of the segment is initialized.
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t slotSize;
+    uint64_t capacity;
+    // Changes whenever the segment is recreated, so readers can tell a new
+    // writer from one that resumed the old sequence.
+    uint64_t epoch;
+    alignas(64) std::atomic<uint64_t> head;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+    "the ring needs address-free 64-bit atomics");
+static_assert(std::is_trivially_copyable_v<TxRingRecord>);
+static_assert(sizeof(TxRingSlot) == 448);
+static_assert(sizeof(TxRingHeader) % alignof(TxRingSlot) == 0);
+
+inline constexpr size_t txRingSegmentSize(uint64_t capacity)
+{
+    return sizeof(TxRingHeader) + capacity * sizeof(TxRingSlot);
+}
+
+inline TxRingSlot* txRingSlots(TxRingHeader* header)
+{
+    return reinterpret_cast<TxRingSlot*>(header + 1);
+}
+}
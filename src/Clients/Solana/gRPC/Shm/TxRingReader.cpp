@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TxRingReader.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace solana {
+
+namespace bip = boost::interprocess;
+
+namespace {
+    const TxRingHeader* mapHeader(bip::shared_memory_object& shm,
+        bip::mapped_region& region, const std::string& name)
+    {
+        shm = bip::shared_memory_object(
+            bip::open_only, name.c_str(), bip::read_only);
+        bip::offset_t size = 0;
+        if (!shm.get_size(size)
+            || static_cast<uint64_t>(size) < sizeof(TxRingHeader))
+            throw std::runtime_error("Transaction ring is truncated: " + name);
+        region = bip::mapped_region(shm, bip::read_only);
+
+        const auto* header
+            = static_cast<const TxRingHeader*>(region.get_address());
+        if (header->magic.load(std::memory_order_acquire) != TX_RING_MAGIC)
+            throw std::runtime_error(
+                "Transaction ring is not initialized: " + name);
+        if (header->version != TX_RING_VERSION
+            || header->slotSize != sizeof(TxRingSlot)
+            || !std::has_single_bit(header->capacity)
+            || static_cast<uint64_t>(size)
+                < txRingSegmentSize(header->capacity))
+            throw std::runtime_error(
+                "Unsupported transaction ring layout: " + name);
+        return header;
+    }
+}
+
+TxRingReader::TxRingReader(const std::string& name, Start start)
+    : name_(name)
+{
+    try {
+        header_ = mapHeader(shm_, region_, name_);
+    } catch (const bip::interprocess_exception& e) {
+        throw std::runtime_error(
+            "Cannot open transaction ring " + name_ + ": " + e.what());
+    }
+    slots_ = txRingSlots(const_cast<TxRingHeader*>(header_));
+    capacity_ = header_->capacity;
+    mask_ = capacity_ - 1;
+    epoch_ = header_->epoch;
+
+    cursor_ = head();
+    if (start == Start::OLDEST)
+        cursor_ = cursor_ < capacity_ ? 0 : cursor_ - capacity_;
+}
+
+size_t TxRingReader::poll(TxRingRecord* out, size_t max)
+{
+    size_t count = 0;
+    while (count < max) {
+        uint64_t head = this->head();
+        if (cursor_ >= head)
+            break;
+        if (head - cursor_ > capacity_)
+            skipTo(head - capacity_);
+
+        // head is only read again once this run is copied or lapped.
+        const uint64_t end = std::min(head, cursor_ + (max - count));
+        while (cursor_ < end) {
+            const TxRingSlot& slot = slots_[cursor_ & mask_];
+            const uint64_t expected = 2 * cursor_ + 2;
+            uint64_t version = slot.version.load(std::memory_order_acquire);
+            if (version < expected)
+                return count;
+            if (version == expected) {
+                out[count] = slot.record;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                version = slot.version.load(std::memory_order_relaxed);
+                if (version == expected) {
+                    ++count;
+                    ++cursor_;
+                    continue;
+                }
+            }
+            // Lapped: the slot now holds a newer sequence, so everything
+            // up to a ring's length before that one is gone.
+            skipTo((version - 1) / 2 + 1 - capacity_);
+            break;
+        }
+    }
+    return count;
+}
+
+void TxRingReader::skipTo(uint64_t sequence)
+{
+    if (sequence <= cursor_)
+        return;
+    lost_ += sequence - cursor_;
+    cursor_ = sequence;
+}
+
+bool TxRingReader::stale() const
+{
+    try {
+        bip::shared_memory_object shm;
+        bip::mapped_region region;
+        return mapHeader(shm, region, name_)->epoch != epoch_;
+    } catch (const std::exception&) {
+        return true;
+    }
+}
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "TxRing.hpp"
+
+namespace solana {
+
+// Follows a transaction ring published by tengu_ingestd (shm_ring_name in
+// its config). Each reader maps the segment read-only and keeps its own
+// cursor, so any number of them can attach in any process on the host.
+// A reader that falls more than a ring's worth behind skips ahead to the
+// oldest record still there and counts what it missed in lost().
+//
+// A reader is not thread safe; give every consuming thread its own.
+class TxRingReader {
+public:
+    enum class Start { OLDEST, LATEST };
+
+    // Throws std::runtime_error when the segment does not exist or has a
+    // layout this reader does not understand.
+    explicit TxRingReader(const std::string& name, Start start = Start::LATEST);
+
+    TxRingReader(const TxRingReader&) = delete;
+    TxRingReader& operator=(const TxRingReader&) = delete;
+
+    // Copies up to max records into out and returns how many it copied;
+    // 0 means the reader has caught up with the writer.
+    size_t poll(TxRingRecord* out, size_t max);
+
+    bool next(TxRingRecord& record)
+    {
+        return poll(&record, 1) == 1;
+    }
+
+    // Sequence number of the next record poll() returns. Saving it and
+    // seeking back to it resumes without gaps, as long as the writer has
+    // not lapped it in the meantime and epoch() is unchanged.
+    uint64_t position() const
+    {
+        return cursor_;
+    }
+
+    void seek(uint64_t sequence)
+    {
+        cursor_ = sequence;
+    }
+
+    // Sequence number of the next record the writer will publish.
+    uint64_t head() const
+    {
+        return header_->head.load(std::memory_order_acquire);
+    }
+
+    uint64_t capacity() const
+    {
+        return capacity_;
+    }
+
+    uint64_t epoch() const
+    {
+        return epoch_;
+    }
+
+    uint64_t lost() const
+    {
+        return lost_;
+    }
+
+    // True once the writer has recreated the segment under the same name
+    // or removed it; this reader then sees no new records and has to be
+    // replaced by a new one.
+    bool stale() const;
+
+private:
+    void skipTo(uint64_t sequence);
+
+    std::string name_;
+    boost::interprocess::shared_memory_object shm_;
+    boost::interprocess::mapped_region region_;
+    const TxRingHeader* header_ { nullptr };
+    const TxRingSlot* slots_ { nullptr };
+    uint64_t capacity_ { 0 };
+    uint64_t mask_ { 0 };
+    uint64_t epoch_ { 0 };
+    uint64_t cursor_ { 0 };
+    uint64_t lost_ { 0 };
+};
+}
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TxRingWriter.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <new>
+
+namespace solana {
+
+namespace bip = boost::interprocess;
+
+TxRingWriter::TxRingWriter(const std::string& name, uint64_t capacity)
+    : name_(name)
+    , capacity_(std::bit_ceil(std::max<uint64_t>(capacity, 2)))
+    , mask_(capacity_ - 1)
+{
+    if (!resume())
+        create();
+    head_ = header_->head.load(std::memory_order_relaxed);
+}
+
+bool TxRingWriter::resume()
+{
+    try {
+        bip::shared_memory_object shm(
+            bip::open_only, name_.c_str(), bip::read_write);
+        bip::offset_t size = 0;
+        if (!shm.get_size(size)
+            || static_cast<uint64_t>(size) != txRingSegmentSize(capacity_))
+            return false;
+
+        bip::mapped_region region(shm, bip::read_write);
+        auto* header = static_cast<TxRingHeader*>(region.get_address());
+        if (header->magic.load(std::memory_order_acquire) != TX_RING_MAGIC
+            || header->version != TX_RING_VERSION
+            || header->slotSize != sizeof(TxRingSlot)
+            || header->capacity != capacity_)
+            return false;
+
+        shm_ = std::move(shm);
+        region_ = std::move(region);
+        header_ = header;
+        slots_ = txRingSlots(header_);
+        return true;
+    } catch (const bip::interprocess_exception&) {
+        return false;
+    }
+}
+
+void TxRingWriter::create()
+{
+    // Readers still mapping the old segment keep it alive; they notice the
+    // new epoch when they attach again.
+    bip::shared_memory_object::remove(name_.c_str());
+    shm_ = bip::shared_memory_object(
+        bip::create_only, name_.c_str(), bip::read_write);
+    shm_.truncate(static_cast<bip::offset_t>(txRingSegmentSize(capacity_)));
+    region_ = bip::mapped_region(shm_, bip::read_write);
+
+    // Constructing every slot also faults the pages in up front.
+    header_ = new (region_.get_address()) TxRingHeader {};
+    slots_ = txRingSlots(header_);
+    for (uint64_t i = 0; i < capacity_; ++i) {
+        new (&slots_[i]) TxRingSlot {};
+    }
+    header_->version = TX_RING_VERSION;
+    header_->slotSize = sizeof(TxRingSlot);
+    header_->capacity = capacity_;
+    header_->epoch = static_cast<uint64_t>(
+        std::chrono::system_clock::now().time_since_epoch().count());
+    header_->magic.store(TX_RING_MAGIC, std::memory_order_release);
+}
+
+void TxRingWriter::publish(const TxRingRecord* records, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        TxRingSlot& slot = slots_[head_ & mask_];
+        slot.version.store(2 * head_ + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.record = records[i];
+        slot.version.store(2 * head_ + 2, std::memory_order_release);
+        ++head_;
+    }
+    if (count)
+        header_->head.store(head_, std::memory_order_release);
+}
+
+bool TxRingWriter::remove(const std::string& name)
+{
+    return bip::shared_memory_object::remove(name.c_str());
+}
+}
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "TxRing.hpp"
+
+namespace solana {
+
+// Owns the named shared-memory segment of a transaction ring and appends to
+// it. There must be at most one writer per name.
+class TxRingWriter {
+public:
+    // Resumes an existing segment with the same layout and capacity, so
+    // readers that stay attached across a restart keep their place;
+    // anything else is replaced. Capacity is rounded up to a power of two.
+    // Throws boost::interprocess::interprocess_exception on failure.
+    TxRingWriter(const std::string& name, uint64_t capacity);
+
+    TxRingWriter(const TxRingWriter&) = delete;
+    TxRingWriter& operator=(const TxRingWriter&) = delete;
+
+    // Not thread safe. Readers see the records once the whole call is done.
+    void publish(const TxRingRecord* records, size_t count);
+
+    const std::string& name() const
+    {
+        return name_;
+    }
+
+    uint64_t capacity() const
+    {
+        return capacity_;
+    }
+
+    uint64_t head() const
+    {
+        return head_;
+    }
+
+    uint64_t epoch() const
+    {
+        return header_->epoch;
+    }
+
+    // The segment outlives the writer until it is removed.
+    static bool remove(const std::string& name);
+
+private:
+    bool resume();
+    void create();
+
+    std::string name_;
+    uint64_t capacity_;
+    uint64_t mask_;
+    boost::interprocess::shared_memory_object shm_;
+    boost::interprocess::mapped_region region_;
+    TxRingHeader* header_ { nullptr };
+    TxRingSlot* slots_ { nullptr };
+    uint64_t head_ { 0 };
+};
+}
@@ -25,6 +25,7 @@
 #include <QObject>
 #include <QVector>
 
+#include "AppInfo.h"
 #include "Wallets/Core/Types.h"
 
 using namespace Daitengu::Wallets;
@@ -33,8 +34,6 @@ namespace Daitengu::Core {
 
 inline constexpr int EXIT_CODE_REBOOT = -6987913;
 
-inline constexpr char COMPANY[] = "to1dev";
-inline constexpr char NAME[] = "tengu";
 inline constexpr int MAJOR = 0;
 inline constexpr int MINOR = 0;
 inline constexpr int PATCH = 1;
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <geyser.grpc.pb.h>
+
+#include "Clients/Solana/gRPC/Core/Pubkey.hpp"
+
+namespace solana::tests {
+
+constexpr uint64_t FEE = 5'000;
+
+// A distinct, made-up key per seed.
+inline Pubkey makeKey(uint8_t seed)
+{
+    Pubkey key;
+    for (size_t i = 0; i < key.bytes.size(); ++i) {
+        key.bytes[i] = static_cast<uint8_t>(seed * 31 + i * 7 + 1);
+    }
+    return key;
+}
+
+/**
+ * Builds a transaction update with geyser.pb.h for the golden cases. Static
+ * keys come first, then keys loaded from lookup tables, which instructions
+ * and token balances index the same way; all static keys go in before the
+ * first loaded one. Every transaction pays FEE.
+ */
+class Frame {
+public:
+    // A static key with its lamports before and after.
+    uint8_t account(const Pubkey& key, uint64_t pre = 0, uint64_t post = 0)
+    {
+        keys_.push_back({ key, pre, post });
+        return static_cast<uint8_t>(keys_.size() - 1);
+    }
+
+    uint8_t loaded(const Pubkey& key, uint64_t pre = 0, uint64_t post = 0)
+    {
+        loaded_.push_back({ key, pre, post });
+        return static_cast<uint8_t>(keys_.size() + loaded_.size() - 1);
+    }
+
+    // A top level instruction.
+    void call(uint8_t program, std::vector<uint8_t> accounts = {},
+        std::string data = {})
+    {
+        outer_.push_back({ program, std::move(accounts), std::move(data), 1,
+            static_cast<uint32_t>(outer_.size()) });
+    }
+
+    // Invoked by the last top level instruction.
+    void inner(uint32_t stackHeight, uint8_t program,
+        std::vector<uint8_t> accounts, std::string data)
+    {
+        inner_.push_back({ program, std::move(accounts), std::move(data),
+            stackHeight, static_cast<uint32_t>(outer_.size() - 1) });
+    }
+
+    // A token account; std::nullopt on a side where it does not exist.
+    void token(size_t account, const Pubkey& owner, const Pubkey& mint,
+        uint32_t decimals, std::optional<uint64_t> pre,
+        std::optional<uint64_t> post)
+    {
+        if (pre)
+            pre_.push_back({ account, owner, mint, decimals, *pre });
+        if (post)
+            post_.push_back({ account, owner, mint, decimals, *post });
+    }
+
+    void computeUnits(uint64_t units)
+    {
+        computeUnits_ = units;
+    }
+
+    std::string serialize(uint8_t signature) const
+    {
+        geyser::SubscribeUpdate update;
+        auto* tx = update.mutable_transaction();
+        tx->set_slot(300'000'000);
+        auto* info = tx->mutable_transaction();
+        info->set_signature(std::string(64, static_cast<char>(signature)));
+        auto* message = info->mutable_transaction()->mutable_message();
+        for (const auto& account : keys_) {
+            message->add_account_keys(std::string(account.key.view()));
+        }
+        for (const auto& instruction : outer_) {
+            auto* compiled = message->add_instructions();
+            compiled->set_program_id_index(instruction.program);
+            compiled->set_accounts(std::string(
+                instruction.accounts.begin(), instruction.accounts.end()));
+            compiled->set_data(instruction.data);
+        }
+
+        auto* meta = info->mutable_meta();
+        meta->set_fee(FEE);
+        meta->set_compute_units_consumed(computeUnits_);
+        for (const auto& account : loaded_) {
+            meta->add_loaded_writable_addresses(
+                std::string(account.key.view()));
+        }
+        for (const auto* accounts : { &keys_, &loaded_ }) {
+            for (const auto& account : *accounts) {
+                meta->add_pre_balances(account.pre);
+                meta->add_post_balances(account.post);
+            }
+        }
+        for (const auto& balance : pre_) {
+            fill(meta->add_pre_token_balances(), balance);
+        }
+        for (const auto& balance : post_) {
+            fill(meta->add_post_token_balances(), balance);
+        }
+        for (size_t i = 0; i < inner_.size();) {
+            auto* group = meta->add_inner_instructions();
+            group->set_index(inner_[i].outer);
+            for (uint32_t outer = inner_[i].outer;
+                i < inner_.size() && inner_[i].outer == outer; ++i) {
+                auto* instruction = group->add_instructions();
+                instruction->set_program_id_index(inner_[i].program);
+                instruction->set_accounts(std::string(
+                    inner_[i].accounts.begin(), inner_[i].accounts.end()));
+                instruction->set_data(inner_[i].data);
+                instruction->set_stack_height(inner_[i].stackHeight);
+            }
+        }
+        return update.SerializeAsString();
+    }
+
+private:
+    struct Account {
+        Pubkey key;
+        uint64_t pre;
+        uint64_t post;
+    };
+
+    struct Instruction {
+        uint8_t program;
+        std::vector<uint8_t> accounts;
+        std::string data;
+        uint32_t stackHeight;
+        uint32_t outer;
+    };
+
+    struct Balance {
+        size_t account;
+        Pubkey owner;
+        Pubkey mint;
+        uint32_t decimals;
+        uint64_t amount;
+    };
+
+    template <typename Message>
+    static void fill(Message* message, const Balance& balance)
+    {
+        message->set_account_index(static_cast<uint32_t>(balance.account));
+        message->set_mint(balance.mint.toBase58());
+        message->set_owner(balance.owner.toBase58());
+        auto* amount = message->mutable_ui_token_amount();
+        amount->set_amount(std::to_string(balance.amount));
+        amount->set_decimals(balance.decimals);
+        amount->set_ui_amount(static_cast<double>(balance.amount)
+            / std::pow(10.0, balance.decimals));
+    }
+
+    std::vector<Account> keys_;
+    std::vector<Account> loaded_;
+    std::vector<Instruction> outer_;
+    std::vector<Instruction> inner_;
+    std::vector<Balance> pre_;
+    std::vector<Balance> post_;
+    uint64_t computeUnits_ { 0 };
+};
+}
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Checks and times AccountCache: updates must only move forward by
+// (slot, write_version), account frames must decode, and a shard over its
+// share of the byte cap must evict its least recently updated accounts:
+//
+//   test_account_cache [updates]
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include <geyser.grpc.pb.h>
+
+#include "Clients/Solana/gRPC/Core/AccountCache.hpp"
+
+using namespace solana;
+
+namespace {
+std::string makeKey(uint32_t seed)
+{
+    std::string key(32, '\0');
+    for (size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<char>((seed >> (8 * (i % 4))) + i * 7);
+    }
+    return key;
+}
+
+AccountCache::Account makeAccount(
+    uint64_t slot, uint64_t writeVersion, size_t dataSize = 16)
+{
+    AccountCache::Account account;
+    account.slot = slot;
+    account.writeVersion = writeVersion;
+    account.lamports = slot * 1000 + writeVersion;
+    account.owner = makeKey(0);
+    account.data.assign(dataSize, 'x');
+    return account;
+}
+
+// The shard AccountCache puts a key in.
+size_t shardOf(const std::string& key)
+{
+    return ankerl::unordered_dense::hash<std::string_view> {}(key)
+        % AccountCache::SHARD_COUNT;
+}
+
+bool checkOrdering()
+{
+    AccountCache cache(1 << 20);
+    const std::string key = makeKey(1);
+    bool ok = true;
+    struct Step {
+        uint64_t slot;
+        uint64_t writeVersion;
+        bool applied;
+    };
+    // Replays from a redundant or reconnected stream must not roll the
+    // account back.
+    for (const Step& step : { Step { 10, 5, true }, Step { 10, 5, false },
+             Step { 10, 4, false }, Step { 9, 100, false },
+             Step { 10, 6, true }, Step { 11, 0, true },
+             Step { 10, 7, false } }) {
+        if (cache.update(key, makeAccount(step.slot, step.writeVersion))
+            != step.applied) {
+            spdlog::error("update at ({}, {}) should {}be applied", step.slot,
+                step.writeVersion, step.applied ? "" : "not ");
+            ok = false;
+        }
+    }
+    auto account = cache.get(key);
+    json stats = cache.getStats();
+    if (!account || account->slot != 11 || account->writeVersion != 0
+        || stats["stale"] != 4 || stats["updates"] != 3
+        || stats["accounts"] != 1) {
+        spdlog::error("after replays: {}", stats.dump());
+        ok = false;
+    }
+    return ok;
+}
+
+bool checkFrames()
+{
+    AccountCache cache(1 << 20);
+    const std::string key = makeKey(2);
+    auto frame = [&](uint64_t slot, uint64_t writeVersion,
+                     const std::string& data) {
+        geyser::SubscribeUpdate update;
+        auto* account = update.mutable_account();
+        account->set_slot(slot);
+        auto* info = account->mutable_account();
+        info->set_pubkey(key);
+        info->set_lamports(42);
+        info->set_owner(makeKey(3));
+        info->set_executable(true);
+        info->set_data(data);
+        info->set_write_version(writeVersion);
+        return update.SerializeAsString();
+    };
+    bool ok = cache.apply(frame(100, 1, "first"))
+        && cache.apply(frame(100, 2, "second"))
+        && cache.apply(frame(99, 9, "stale"));
+    auto account = cache.get(key);
+    ok = ok && account && account->data == "second" && account->slot == 100
+        && account->writeVersion == 2 && account->lamports == 42
+        && account->executable && account->owner == makeKey(3);
+
+    geyser::SubscribeUpdate slotUpdate;
+    slotUpdate.mutable_slot()->set_slot(100);
+    ok = ok && !cache.apply(slotUpdate.SerializeAsString());
+    if (!ok)
+        spdlog::error("account frames: {}", cache.getStats().dump());
+    return ok;
+}
+
+bool checkEviction()
+{
+    // Three keys of one shard, whose share of the cap holds two accounts.
+    std::vector<std::string> keys;
+    for (uint32_t seed = 100; keys.size() < 3; ++seed) {
+        std::string key = makeKey(seed);
+        if (shardOf(key) == 0)
+            keys.push_back(key);
+    }
+    constexpr size_t DATA = 1000;
+    AccountCache cache(AccountCache::SHARD_COUNT * 2600);
+    cache.update(keys[0], makeAccount(1, 0, DATA));
+    cache.update(keys[1], makeAccount(1, 0, DATA));
+    // Newer state makes keys[0] the most recent, so keys[1] goes.
+    cache.update(keys[0], makeAccount(2, 0, DATA));
+    cache.update(keys[2], makeAccount(3, 0, DATA));
+    json stats = cache.getStats();
+    bool ok = cache.get(keys[0]) && !cache.get(keys[1]) && cache.get(keys[2])
+        && stats["evictions"] == 1 && stats["accounts"] == 2;
+
+    // An account bigger than the whole share still goes in, alone.
+    cache.update(keys[1], makeAccount(4, 0, 4 * DATA));
+    stats = cache.getStats();
+    ok = ok && cache.get(keys[1]) && !cache.get(keys[0]) && !cache.get(keys[2])
+        && stats["evictions"] == 3;
+    if (!ok)
+        spdlog::error("eviction: {}", stats.dump());
+    return ok;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    size_t updates = argc > 1 ? std::stoull(argv[1]) : 2'000'000;
+
+    bool ok = checkOrdering();
+    ok = checkFrames() && ok;
+    ok = checkEviction() && ok;
+
+    // Updates over many accounts with a cap that keeps evicting.
+    constexpr uint32_t ACCOUNTS = 100'000;
+    std::vector<std::string> keys;
+    for (uint32_t i = 0; i < ACCOUNTS; ++i) {
+        keys.push_back(makeKey(i * 2654435761u + 7));
+    }
+    AccountCache cache(16 << 20);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < updates; ++i) {
+        cache.update(keys[i % ACCOUNTS], makeAccount(i / ACCOUNTS + 1, i, 165));
+    }
+    double updateNs = std::chrono::duration<double, std::nano>(
+                          std::chrono::steady_clock::now() - start)
+                          .count()
+        / static_cast<double>(updates);
+    json stats = cache.getStats();
+    if (stats["bytes"] > stats["max_bytes"]) {
+        spdlog::error("over the cap: {}", stats.dump());
+        ok = false;
+    }
+
+    spdlog::info("{} updates over {} accounts: {:.1f} ns/update, {} cached, "
+                 "{} evicted",
+        updates, ACCOUNTS, updateNs, stats["accounts"].get<size_t>(),
+        stats["evictions"].get<size_t>());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,465 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Golden cases and a benchmark for the DEX swap decoders. Each case is a
+// transaction shaped like a real one, with its swap either at the top
+// level or invoked by an aggregator, encoded with geyser.pb.h and run
+// through scan, resolve and DexFilter:
+//
+//   test_dex_decoders [passes]
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "Clients/Solana/gRPC/Core/DexFilter.hpp"
+#include "Tests/TestFrame.hpp"
+
+using namespace solana;
+using namespace solana::tests;
+
+namespace {
+Pubkey program(const char* address)
+{
+    return *Pubkey::fromBase58(address);
+}
+
+const Pubkey USER = makeKey(1);
+const Pubkey POOL = makeKey(2);
+const Pubkey POOL_AUTHORITY = makeKey(3);
+const Pubkey SYSTEM {};
+const Pubkey TOKEN = program("TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA");
+const Pubkey JUPITER = program("JUP6LkbZbjS1jKKwapdHNy74zcZ3tLUZoi5QNyVTaV4");
+const Pubkey RAYDIUM = program("675kPX9MHTjS2zt1qfr1NYHuzeLXfQM9H24wFSUt1Mp8");
+const Pubkey WHIRLPOOL
+    = program("whirLbMiicVdio4qvUfM5KAg6Ct8VwpYzGff3uctyCc");
+const Pubkey PUMP_FUN = program("6EF8rrecthR5Dkzon8Nwu78hRvfCKubJ14M5uBEwF6P");
+const Pubkey CPMM = program("CPMMoo8L3F4NbTegBCKVNunggL7H1ZpdTHKxQB5qKP1C");
+const Pubkey CLMM = program("CAMMCzo5YL8w4VFF8KVHrK22GGUsp5VTaW7grrKgrWqK");
+const Pubkey DLMM = program("LBUZKhRxPF3XUpBCjp4YzTKgLccjZhTSDM9YuVaPwxo");
+const Pubkey PUMP_AMM = program("pAMMBay6oceH9fJKBRHGP5D4bD4sWpmSwMn52FMfXEA");
+const Pubkey WSOL = program("So11111111111111111111111111111111111111112");
+
+std::string bytes(std::initializer_list<uint8_t> values)
+{
+    return std::string(values.begin(), values.end());
+}
+
+// Anchor discriminators of the instructions the cases call.
+const std::string SWAP = bytes({ 248, 198, 158, 145, 225, 117, 135, 200 });
+const std::string SWAP_BASE_OUTPUT
+    = bytes({ 55, 217, 98, 86, 163, 74, 180, 173 });
+const std::string SWAP_EXACT_OUT
+    = bytes({ 250, 73, 101, 33, 38, 207, 75, 184 });
+const std::string SELL = bytes({ 51, 230, 133, 164, 1, 127, 131, 173 });
+
+std::string u64(uint64_t value)
+{
+    std::string out(8, '\0');
+    for (size_t i = 0; i < 8; ++i) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+    return out;
+}
+
+std::string tokenTransfer(uint64_t amount)
+{
+    return bytes({ 3 }) + u64(amount);
+}
+
+std::string tokenTransferChecked(uint64_t amount)
+{
+    return bytes({ 12 }) + u64(amount) + bytes({ 6 });
+}
+
+std::string systemTransfer(uint64_t lamports)
+{
+    return bytes({ 2, 0, 0, 0 }) + u64(lamports);
+}
+
+struct Expected {
+    Pubkey program;
+    Pubkey pool;
+    bool exactIn;
+    uint64_t amountSpecified;
+    uint64_t otherAmountThreshold;
+    uint64_t amountIn;
+    uint64_t amountOut;
+    int32_t innerIndex;
+    const char* side;
+    uint64_t solAmount;
+};
+
+struct Case {
+    const char* name;
+    std::string frame;
+    // Empty for a DEX call that is not a swap.
+    std::vector<Expected> swaps;
+};
+
+std::vector<Case> goldenCases()
+{
+    std::vector<Case> cases;
+
+    // Raydium AMM v4 swap at the top level, with the target orders
+    // account, so 18 accounts ending in the user's.
+    {
+        Frame frame;
+        uint8_t user = frame.account(USER);
+        uint8_t raydium = frame.account(RAYDIUM);
+        uint8_t token = frame.account(TOKEN);
+        uint8_t pool = frame.account(POOL);
+        uint8_t authority = frame.account(POOL_AUTHORITY);
+        std::vector<uint8_t> accounts { token, pool, authority };
+        for (uint8_t i = 10; i < 24; ++i) {
+            accounts.push_back(frame.account(makeKey(i)));
+        }
+        accounts.push_back(user);
+        uint8_t source = accounts[15];
+        uint8_t vault = accounts[5];
+        frame.call(raydium, accounts, bytes({ 9 }) + u64(1000) + u64(2400));
+        frame.inner(2, token, { source, vault, user }, tokenTransfer(1000));
+        frame.inner(2, token, { vault, accounts[16], authority },
+            tokenTransfer(2500));
+        cases.push_back({ "Raydium swap", frame.serialize(1),
+            { { RAYDIUM, POOL, true, 1000, 2400, 1000, 2500, -1, "unknown",
+                0 } } });
+    }
+
+    // Jupiter route into a Whirlpool swap_v2 whose pool comes from an
+    // address lookup table. Jupiter's own fee transfer afterwards is one
+    // level up and must not count as the swap's output.
+    {
+        Frame frame;
+        uint8_t user = frame.account(USER);
+        uint8_t jupiter = frame.account(JUPITER);
+        uint8_t whirlpool = frame.account(WHIRLPOOL);
+        uint8_t token = frame.account(TOKEN);
+        uint8_t userA = frame.account(makeKey(10));
+        uint8_t userB = frame.account(makeKey(11));
+        uint8_t feeAccount = frame.account(makeKey(17));
+        uint8_t pool = frame.loaded(POOL);
+        uint8_t vaultA = frame.loaded(makeKey(12));
+        uint8_t vaultB = frame.loaded(makeKey(13));
+        uint8_t memo = frame.loaded(makeKey(14));
+        uint8_t mintA = frame.loaded(makeKey(15));
+        uint8_t mintB = frame.loaded(makeKey(16));
+        frame.call(jupiter, { user, userA, userB }, bytes({ 1, 2, 3 }));
+        std::string data = bytes({ 43, 4, 237, 11, 26, 201, 30, 98 })
+            + u64(5'000'000) + u64(4'900'000) + std::string(16, '\0')
+            + bytes({ 1, 1, 0 });
+        frame.inner(2, whirlpool,
+            { token, token, memo, user, pool, mintA, mintB, userA, vaultA,
+                userB, vaultB },
+            data);
+        frame.inner(3, token, { userA, mintA, vaultA, user },
+            tokenTransferChecked(5'000'000));
+        frame.inner(3, token, { vaultB, mintB, userB, pool },
+            tokenTransferChecked(4'950'000));
+        frame.inner(2, token, { userB, feeAccount, user },
+            tokenTransfer(1'000));
+        cases.push_back({ "Jupiter to Whirlpool", frame.serialize(2),
+            { { WHIRLPOOL, POOL, true, 5'000'000, 4'900'000, 5'000'000,
+                4'950'000, 0, "unknown", 0 } } });
+    }
+
+    // Pump.fun buy: exact tokens out, SOL paid with a system transfer.
+    {
+        Frame frame;
+        uint8_t user = frame.account(USER);
+        uint8_t pump = frame.account(PUMP_FUN);
+        uint8_t system = frame.account(SYSTEM);
+        uint8_t token = frame.account(TOKEN);
+        uint8_t curve = frame.account(POOL);
+        std::vector<uint8_t> accounts { frame.account(makeKey(10)),
+            frame.account(makeKey(11)), frame.account(makeKey(12)), curve,
+            frame.account(makeKey(13)), frame.account(makeKey(14)), user,
+            system, token };
+        frame.call(pump, accounts,
+            bytes({ 102, 6, 61, 18, 1, 218, 235, 234 })
+                + u64(35'000'000'000'000) + u64(1'010'000'000));
+        frame.inner(2, token, { accounts[4], accounts[5], curve },
+            tokenTransfer(35'000'000'000'000));
+        frame.inner(2, system, { user, curve }, systemTransfer(1'000'000'000));
+        frame.inner(
+            2, system, { user, accounts[1] }, systemTransfer(10'000'000));
+        cases.push_back({ "Pump.fun buy", frame.serialize(3),
+            { { PUMP_FUN, POOL, false, 35'000'000'000'000, 1'010'000'000,
+                1'000'000'000, 35'000'000'000'000, -1, "buy",
+                1'000'000'000 } } });
+    }
+
+    // Raydium AMM v4 SwapBaseOut without the target orders account. Its
+    // arguments are the most to pay, then the exact amount wanted.
+    {
+        Frame frame;
+        uint8_t user = frame.account(USER);
+        uint8_t raydium = frame.account(RAYDIUM);
+        uint8_t token = frame.account(TOKEN);
+        uint8_t pool = frame.account(POOL);
+        uint8_t authority = frame.account(POOL_AUTHORITY);
+        std::vector<uint8_t> accounts { token, pool, authority };
+        for (uint8_t i = 10; i < 23; ++i) {
+            accounts.push_back(frame.account(makeKey(i)));
+        }
+        accounts.push_back(user);
+        uint8_t source = accounts[14];
+        uint8_t vault = accounts[4];
+        frame.call(raydium, accounts, bytes({ 11 }) + u64(3100) + u64(600));
+        frame.inner(2, token, { source, vault, user }, tokenTransfer(3050));
+        frame.inner(
+            2, token, { vault, accounts[15], authority }, tokenTransfer(600));
+        cases.push_back({ "Raydium swap base out", frame.serialize(5),
+            { { RAYDIUM, POOL, false, 600, 3100, 3050, 600, -1, "unknown",
+                0 } } });
+    }
+
+    // Raydium CPMM swap_base_output: (max_amount_in, amount_out), with
+    // transfer_checked both ways.
+    {
+        Frame frame;
+        uint8_t user = frame.account(USER);
+        uint8_t cpmm = frame.account(CPMM);
+        uint8_t token = frame.account(TOKEN);
+        uint8_t authority = frame.account(POOL_AUTHORITY);
+        uint8_t pool = frame.account(POOL);
+        std::vector<uint8_t> accounts { user, authority,
+            frame.account(makeKey(10)), pool };
+        for (uint8_t i = 11; i < 20; ++i) {
+            accounts.push_back(frame.account(makeKey(i)));
+        }
+        frame.call(cpmm, accounts, SWAP_BASE_OUTPUT + u64(9000) + u64(7000));
+        frame.inner(2, token, { accounts[4], accounts[10], accounts[6], user },
+            tokenTransferChecked(8800));
+        frame.inner(2, token,
+            { accounts[7], accounts[11], accounts[5], authority },
+            tokenTransferChecked(7000));
+        cases.push_back({ "CPMM swap base output", frame.serialize(6),
+            { { CPMM, POOL, false, 7000, 9000, 8800, 7000, -1, "unknown",
+                0 } } });
+    }
+
+    // Raydium CLMM swap for an exact output: amount, threshold, price
+    // limit and is_base_input false.
+    {
+        Frame frame;
+        uint8_t user = frame.account(USER);
+        uint8_t clmm = frame.account(CLMM);
+        uint8_t token = frame.account(TOKEN);
+        uint8_t pool = frame.account(POOL);
+        std::vector<uint8_t> accounts { user, frame.account(makeKey(10)),
+            pool };
+        for (uint8_t i = 11; i < 17; ++i) {
+            accounts.push_back(frame.account(makeKey(i)));
+        }
+        accounts.push_back(token);
+        accounts.push_back(frame.account(makeKey(17)));
+        frame.call(clmm, accounts,
+            SWAP + u64(400) + u64(520) + std::string(16, '\0')
+                + bytes({ 0 }));
+        frame.inner(2, token, { accounts[3], accounts[5], user },
+            tokenTransfer(505));
+        frame.inner(2, token, { accounts[6], accounts[4], pool },
+            tokenTransfer(400));
+        cases.push_back({ "CLMM swap exact out", frame.serialize(7),
+            { { CLMM, POOL, false, 400, 520, 505, 400, -1, "unknown", 0 } } });
+    }
+
+    // Orca Whirlpool v1 swap: the token program, then the user and the
+    // pool.
+    {
+        Frame frame;
+        uint8_t user = frame.account(USER);
+        uint8_t whirlpool = frame.account(WHIRLPOOL);
+        uint8_t token = frame.account(TOKEN);
+        uint8_t pool = frame.account(POOL);
+        std::vector<uint8_t> accounts { token, user, pool };
+        for (uint8_t i = 10; i < 18; ++i) {
+            accounts.push_back(frame.account(makeKey(i)));
+        }
+        frame.call(whirlpool, accounts,
+            SWAP + u64(2'000) + u64(1'900) + std::string(16, '\0')
+                + bytes({ 1, 1 }));
+        frame.inner(2, token, { accounts[3], accounts[4], user },
+            tokenTransfer(2'000));
+        frame.inner(2, token, { accounts[6], accounts[5], pool },
+            tokenTransfer(1'950));
+        cases.push_back({ "Whirlpool swap", frame.serialize(8),
+            { { WHIRLPOOL, POOL, true, 2'000, 1'900, 2'000, 1'950, -1,
+                "unknown", 0 } } });
+    }
+
+    // Meteora DLMM swap_exact_out: (max_in_amount, out_amount), the user
+    // eleventh.
+    {
+        Frame frame;
+        uint8_t user = frame.account(USER);
+        uint8_t dlmm = frame.account(DLMM);
+        uint8_t token = frame.account(TOKEN);
+        uint8_t pool = frame.account(POOL);
+        std::vector<uint8_t> accounts { pool };
+        for (uint8_t i = 10; i < 19; ++i) {
+            accounts.push_back(frame.account(makeKey(i)));
+        }
+        accounts.push_back(user);
+        accounts.push_back(token);
+        accounts.push_back(token);
+        accounts.push_back(frame.account(makeKey(19)));
+        accounts.push_back(dlmm);
+        frame.call(dlmm, accounts, SWAP_EXACT_OUT + u64(12'000) + u64(800));
+        frame.inner(2, token, { accounts[4], accounts[2], user },
+            tokenTransfer(11'500));
+        frame.inner(2, token, { accounts[3], accounts[5], pool },
+            tokenTransfer(800));
+        cases.push_back({ "DLMM swap exact out", frame.serialize(9),
+            { { DLMM, POOL, false, 800, 12'000, 11'500, 800, -1, "unknown",
+                0 } } });
+    }
+
+    // Pump.fun AMM sell: the exact base amount in and the least quote
+    // out, pool first and user second. The quote mint is WSOL, so the
+    // quote leg is the SOL taken out.
+    {
+        Frame frame;
+        uint8_t user = frame.account(USER);
+        uint8_t pumpAmm = frame.account(PUMP_AMM);
+        uint8_t token = frame.account(TOKEN);
+        uint8_t pool = frame.account(POOL);
+        std::vector<uint8_t> accounts { pool, user };
+        for (uint8_t i = 10; i < 17; ++i) {
+            accounts.push_back(frame.account(i == 12 ? WSOL : makeKey(i)));
+        }
+        accounts.push_back(token);
+        frame.call(pumpAmm, accounts, SELL + u64(1'000'000) + u64(45'000));
+        frame.inner(2, token, { accounts[5], accounts[3], accounts[7], user },
+            tokenTransferChecked(1'000'000));
+        frame.inner(2, token, { accounts[8], accounts[4], accounts[6], pool },
+            tokenTransferChecked(46'000));
+        cases.push_back({ "Pump AMM sell", frame.serialize(10),
+            { { PUMP_AMM, POOL, true, 1'000'000, 45'000, 1'000'000, 46'000,
+                -1, "sell", 46'000 } } });
+    }
+
+    // A Raydium deposit: the DEX is called but nothing is swapped.
+    {
+        Frame frame;
+        uint8_t user = frame.account(USER);
+        uint8_t raydium = frame.account(RAYDIUM);
+        std::vector<uint8_t> accounts;
+        for (uint8_t i = 10; i < 24; ++i) {
+            accounts.push_back(frame.account(makeKey(i)));
+        }
+        accounts.push_back(user);
+        frame.call(raydium, accounts, bytes({ 3 }) + u64(1) + u64(2));
+        cases.push_back({ "Raydium deposit", frame.serialize(4), {} });
+    }
+    return cases;
+}
+
+std::shared_ptr<DexFilter> makeFilter()
+{
+    return std::make_shared<DexFilter>(std::unordered_set<std::string> {
+        RAYDIUM.toBase58(), WHIRLPOOL.toBase58(), PUMP_FUN.toBase58(),
+        CPMM.toBase58(), CLMM.toBase58(), DLMM.toBase58(),
+        PUMP_AMM.toBase58() });
+}
+
+bool check(const Case& test)
+{
+    auto filter = makeFilter();
+    TransactionView view;
+    if (!view.scan(test.frame) || !view.resolve()) {
+        spdlog::error("{}: frame did not scan", test.name);
+        return false;
+    }
+    filter->processView("golden", view);
+
+    // Newest first; a transaction without swaps still shows up once.
+    json entries = filter->getRecentDexTransactions();
+    bool ok = entries.size() == std::max<size_t>(test.swaps.size(), 1);
+    for (size_t i = 0; ok && i < test.swaps.size(); ++i) {
+        const auto& expected = test.swaps[i];
+        const auto& entry = entries[test.swaps.size() - 1 - i];
+        ok = entry.contains("swap")
+            && entry["dex_program"] == expected.program.toBase58();
+        if (!ok)
+            break;
+        const auto& swap = entry["swap"];
+        ok = swap["pool"] == expected.pool.toBase58()
+            && swap["user"] == USER.toBase58()
+            && swap["exact_in"] == expected.exactIn
+            && swap["amount_specified"] == expected.amountSpecified
+            && swap["other_amount_threshold"]
+                == expected.otherAmountThreshold
+            && swap["amount_in"] == expected.amountIn
+            && swap["amount_out"] == expected.amountOut
+            && swap["inner_index"] == expected.innerIndex
+            && swap["side"] == expected.side
+            && swap["sol_amount"] == expected.solAmount;
+    }
+    if (ok && test.swaps.empty())
+        ok = !entries[0].contains("swap");
+    if (!ok)
+        spdlog::error("{}: expected {} swaps, got {}", test.name,
+            test.swaps.size(), entries.dump());
+    return ok;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int passes = argc > 1 ? std::max(1, std::stoi(argv[1])) : 100000;
+
+    auto cases = goldenCases();
+    size_t failed = 0;
+    for (const auto& test : cases) {
+        failed += !check(test);
+    }
+    if (failed) {
+        spdlog::error("{} of {} golden cases failed", failed, cases.size());
+        return 1;
+    }
+    spdlog::info("{} golden cases passed", cases.size());
+
+    auto decoders = DexDecoderRegistry::builtin();
+    TransactionView view;
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& test : cases) {
+            view.scan(test.frame);
+            view.resolve();
+            view.forEachInstruction([&](const auto& instruction,
+                                        uint32_t outerIndex,
+                                        int32_t innerIndex) {
+                DexSwap swap;
+                if (decoders->contains(instruction.program)
+                    && decoders->decode(view, outerIndex, innerIndex, swap))
+                    sink += swap.amountOut;
+            });
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    spdlog::info("scan+resolve+decode: {:.0f} ns/tx",
+        std::chrono::duration<double, std::nano>(elapsed).count()
+            / static_cast<double>(passes * cases.size()));
+    spdlog::debug("checksum {}", sink);
+    return 0;
+}
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Runs EndpointProber against in-process fake Geyser servers, so endpoint
+// demotion and promotion can be checked without network access:
+//
+//   test_endpoint_prober
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#include <spdlog/spdlog.h>
+
+#include <geyser.grpc.pb.h>
+
+#include "Clients/Solana/gRPC/Core/EndpointProber.hpp"
+
+using namespace solana;
+
+namespace {
+class FakeGeyser final : public geyser::Geyser::Service {
+public:
+    std::atomic<uint64_t> slot { 1000 };
+    std::atomic<bool> unavailable { false };
+
+    grpc::Status Ping(grpc::ServerContext*, const geyser::PingRequest* request,
+        geyser::PongResponse* response) override
+    {
+        if (unavailable)
+            return grpc::Status(grpc::StatusCode::UNAVAILABLE, "down");
+        response->set_count(request->count());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status GetSlot(grpc::ServerContext*, const geyser::GetSlotRequest*,
+        geyser::GetSlotResponse* response) override
+    {
+        if (unavailable)
+            return grpc::Status(grpc::StatusCode::UNAVAILABLE, "down");
+        response->set_slot(slot);
+        return grpc::Status::OK;
+    }
+};
+
+struct FakeEndpoint {
+    FakeGeyser service;
+    std::unique_ptr<grpc::Server> server;
+
+    FakeEndpoint()
+    {
+        grpc::ServerBuilder builder;
+        builder.RegisterService(&service);
+        server = builder.BuildAndStart();
+    }
+
+    ~FakeEndpoint()
+    {
+        server->Shutdown();
+    }
+
+    std::shared_ptr<grpc::Channel> channel()
+    {
+        return server->InProcessChannel(grpc::ChannelArguments());
+    }
+};
+
+struct Transitions {
+    std::mutex mutex;
+    std::vector<std::pair<std::string, bool>> seen;
+
+    void record(const std::string& id, bool demoted)
+    {
+        std::lock_guard lock(mutex);
+        seen.emplace_back(id, demoted);
+    }
+
+    size_t count(const std::string& id, bool demoted)
+    {
+        std::lock_guard lock(mutex);
+        size_t n = 0;
+        for (const auto& [seenId, seenDemoted] : seen) {
+            n += seenId == id && seenDemoted == demoted;
+        }
+        return n;
+    }
+};
+
+bool waitFor(const std::function<bool()>& condition)
+{
+    auto deadline
+        = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (condition())
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return condition();
+}
+
+int failures = 0;
+
+void expect(bool condition, const char* what)
+{
+    if (condition) {
+        spdlog::info("ok: {}", what);
+    } else {
+        spdlog::error("FAILED: {}", what);
+        ++failures;
+    }
+}
+}
+
+int main()
+{
+    FakeEndpoint fast;
+    FakeEndpoint slow;
+    Transitions transitions;
+
+    EndpointProber::Options options;
+    options.interval = std::chrono::milliseconds(20);
+    options.timeout = std::chrono::milliseconds(200);
+    options.maxSlotLag = 4;
+    options.demoteAfter = 2;
+    options.promoteAfter = 3;
+    EndpointProber prober(options,
+        [&transitions](const std::string& id, bool demoted) {
+            transitions.record(id, demoted);
+        });
+    prober.addEndpoint("fast", "fast.local", fast.channel());
+    prober.addEndpoint("slow", "slow.local", slow.channel());
+
+    expect(waitFor([&] { return prober.getStats()["rounds"] >= 5; }),
+        "probe rounds complete");
+    auto stats = prober.getStats();
+    expect(stats["endpoints"]["fast"]["rtt_us"]["count"] > 0,
+        "round trips are recorded");
+    expect(stats["best_slot"] == 1000, "best slot tracks the endpoints");
+    expect(transitions.count("slow", true) == 0,
+        "endpoints in step stay active");
+
+    slow.service.slot = 900;
+    expect(waitFor([&] { return prober.isDemoted("slow"); }),
+        "lagging endpoint is demoted");
+    expect(!prober.isDemoted("fast"), "leading endpoint stays active");
+    expect(prober.getStats()["endpoints"]["slow"]["slot_lag"]["max"] >= 100,
+        "slot lag is measured against the best endpoint");
+
+    slow.service.slot = 1000;
+    expect(waitFor([&] { return !prober.isDemoted("slow"); }),
+        "recovered endpoint is promoted");
+    expect(transitions.count("slow", true) == 1
+            && transitions.count("slow", false) == 1,
+        "callback sees one demotion and one promotion");
+
+    // With the leader down the lagging endpoint is the best one left and
+    // must not be demoted along with it.
+    fast.service.unavailable = true;
+    slow.service.slot = 500;
+    expect(waitFor([&] { return prober.isDemoted("fast"); }),
+        "unreachable endpoint is demoted");
+    std::this_thread::sleep_for(options.interval * 10);
+    expect(!prober.isDemoted("slow"), "last endpoint is never demoted");
+    expect(prober.getStats()["endpoints"]["fast"]["failures"] > 0,
+        "failed probes are counted");
+
+    prober.removeEndpoint("slow");
+    expect(!prober.getStats()["endpoints"].contains("slow"),
+        "removed endpoint leaves the stats");
+
+    spdlog::info("{} check(s) failed", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+// Checks and times SignatureSet and FeedRace: copies within the window are
+// duplicates, a recycled generation forgets its slot, concurrent endpoints
+// admit every signature exactly once, and wins, losses and leads are scored
+// on receive time:
+//
+//   test_feed_race [signatures]
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "Clients/Solana/gRPC/Core/FeedRace.hpp"
+
+using namespace solana;
+
+namespace {
+// 64 bytes like a raw Ed25519 signature.
+std::string makeSignature(uint64_t seed)
+{
+    std::string signature(64, '\0');
+    uint64_t state = seed;
+    for (size_t i = 0; i < signature.size(); i += sizeof(state)) {
+        state += 0x9e3779b97f4a7c15ull;
+        uint64_t mixed = state;
+        mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ull;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebull;
+        mixed ^= mixed >> 31;
+        std::memcpy(signature.data() + i, &mixed, sizeof(mixed));
+    }
+    return signature;
+}
+
+json endpointStats(const FeedRace& race, size_t endpoint)
+{
+    return race.getStats()["endpoints"][endpoint];
+}
+
+bool checkDuplicates()
+{
+    SignatureSet set(4, 1024);
+    const std::string signature = makeSignature(1);
+    auto first = set.insert(signature, 100, 0, 1000);
+    auto again = set.insert(signature, 100, 1, 1200);
+    auto other = set.insert(makeSignature(2), 100, 1, 1300);
+    bool ok = first.first && !first.stale && !again.first
+        && again.owner == 0 && again.firstSeenUs == 1000 && other.first;
+    if (!ok)
+        spdlog::error("duplicates within the window were not caught");
+    return ok;
+}
+
+bool checkRollover()
+{
+    SignatureSet set(4, 1024);
+    const std::string signature = makeSignature(3);
+    set.insert(signature, 10, 0, 1000);
+    // Slot 14 takes over slot 10's generation.
+    auto newer = set.insert(makeSignature(4), 14, 0, 2000);
+    auto stale = set.insert(signature, 10, 1, 3000);
+    auto reused = set.insert(signature, 14, 1, 4000);
+    bool ok = newer.first && stale.first && stale.stale && reused.first
+        && !reused.stale && set.getStale() == 1;
+    if (!ok)
+        spdlog::error("rollover: stale {}", set.getStale());
+    return ok;
+}
+
+bool checkConcurrent()
+{
+    constexpr size_t SLOTS = 32;
+    constexpr size_t PER_SLOT = 2000;
+    FeedRace race(64, 8192);
+    uint16_t a = race.registerEndpoint("a");
+    uint16_t b = race.registerEndpoint("b");
+    std::vector<std::string> signatures;
+    for (size_t i = 0; i < SLOTS * PER_SLOT; ++i) {
+        signatures.push_back(makeSignature(1000 + i));
+    }
+    std::atomic<size_t> admitted { 0 };
+    auto feed = [&](uint16_t endpoint) {
+        for (size_t i = 0; i < signatures.size(); ++i) {
+            if (race.admit(endpoint, signatures[i], 1000 + i / PER_SLOT))
+                ++admitted;
+        }
+    };
+    {
+        std::jthread first(feed, a);
+        std::jthread second(feed, b);
+    }
+    json stats = race.getStats();
+    uint64_t wins = stats["endpoints"][0]["wins"].get<uint64_t>()
+        + stats["endpoints"][1]["wins"].get<uint64_t>();
+    uint64_t losses = stats["endpoints"][0]["losses"].get<uint64_t>()
+        + stats["endpoints"][1]["losses"].get<uint64_t>();
+    bool ok = admitted == signatures.size() && wins == signatures.size()
+        && losses == signatures.size() && stats["overflows"] == 0;
+    if (!ok)
+        spdlog::error("concurrent: {} admitted, {}", admitted.load(),
+            stats.dump());
+    return ok;
+}
+
+bool checkScoring()
+{
+    FeedRace race(8, 1024);
+    uint16_t a = race.registerEndpoint("a");
+    uint16_t b = race.registerEndpoint("b");
+    // b's copy is read 300us after a's.
+    bool ok = race.admit(a, makeSignature(10), 500, 1000)
+        && !race.admit(b, makeSignature(10), 500, 1300);
+    // a's copy is read 500us before b's but decoded after it, so the win
+    // moves over to a.
+    ok = ok && race.admit(b, makeSignature(11), 500, 2000)
+        && !race.admit(a, makeSignature(11), 500, 1500);
+    // Two shards of one endpoint are not racing each other.
+    ok = ok && race.admit(a, makeSignature(12), 500, 3000)
+        && !race.admit(a, makeSignature(12), 500, 3100);
+
+    json statsA = endpointStats(race, a);
+    json statsB = endpointStats(race, b);
+    ok = ok && statsA["wins"] == 3 && statsA["losses"] == 0
+        && statsB["wins"] == 0 && statsB["losses"] == 2
+        && statsA["lead_us"]["count"] == 2 && statsA["lead_us"]["max"] == 500
+        && statsB["lead_us"]["count"] == 0;
+    if (!ok)
+        spdlog::error("scoring: {}", race.getStats().dump());
+    return ok;
+}
+
+bool checkStale()
+{
+    FeedRace race(4, 1024);
+    uint16_t a = race.registerEndpoint("a");
+    uint16_t b = race.registerEndpoint("b");
+    race.admit(a, makeSignature(20), 10, 1000);
+    race.admit(a, makeSignature(21), 14, 2000);
+    // Only a itself is past slot 10, so this may be the only copy.
+    bool ok = race.admit(a, makeSignature(22), 10, 3000);
+    // b is a whole window ahead and has already delivered slot 10.
+    race.admit(b, makeSignature(23), 18, 4000);
+    ok = !race.admit(a, makeSignature(24), 10, 5000) && ok;
+
+    json stats = endpointStats(race, a);
+    ok = ok && stats["stale"] == 2 && stats["stale_dropped"] == 1
+        && endpointStats(race, b)["stale"] == 0;
+    if (!ok)
+        spdlog::error("stale: {}", race.getStats().dump());
+    return ok;
+}
+
+bool checkReplay()
+{
+    // One endpoint, no one else to compare with: a reconnect replays 100
+    // slots, far more than the window of 8.
+    constexpr uint64_t SLOTS = 200;
+    constexpr uint64_t REPLAYED = 100;
+    FeedRace race(8, 1024);
+    uint16_t a = race.registerEndpoint("a");
+    for (uint64_t slot = 1; slot <= SLOTS; ++slot) {
+        race.admit(a, makeSignature(slot), slot);
+    }
+    race.markReplay(a);
+    size_t replayed = 0;
+    for (uint64_t slot = SLOTS - REPLAYED + 1; slot <= SLOTS; ++slot) {
+        replayed += race.admit(a, makeSignature(slot), slot);
+    }
+    // The stream then goes on past where it was.
+    bool ok = replayed == 0
+        && race.admit(a, makeSignature(SLOTS + 1), SLOTS + 1);
+    json stats = endpointStats(race, a);
+    ok = ok && stats["wins"] == SLOTS + 1 && stats["stale_dropped"] > 0;
+    if (!ok)
+        spdlog::error("replay: {} admitted again, {}", replayed,
+            race.getStats().dump());
+    return ok;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = argc > 1 ? std::stoull(argv[1]) : 1'000'000;
+
+    bool ok = checkDuplicates();
+    ok = checkRollover() && ok;
+    ok = checkConcurrent() && ok;
+    ok = checkScoring() && ok;
+    ok = checkStale() && ok;
+    ok = checkReplay() && ok;
+
+    // Two endpoints offering the same signatures, 2000 per slot.
+    constexpr size_t PER_SLOT = 2000;
+    std::vector<std::string> signatures;
+    signatures.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        signatures.push_back(makeSignature(i));
+    }
+    FeedRace race(32, 16384);
+    uint16_t a = race.registerEndpoint("a");
+    uint16_t b = race.registerEndpoint("b");
+    size_t admitted = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t slot = i / PER_SLOT + 1;
+        admitted += race.admit(a, signatures[i], slot);
+        admitted += race.admit(b, signatures[i], slot);
+    }
+    double admitNs = std::chrono::duration<double, std::nano>(
+                         std::chrono::steady_clock::now() - start)
+                         .count()
+        / static_cast<double>(count * 2);
+    if (admitted != count) {
+        spdlog::error("admitted {} of {}: {}", admitted, count,
+            race.getStats().dump());
+        ok = false;
+    }
+
+    spdlog::info("{} signatures from 2 endpoints: {:.1f} ns/admit", count,
+        admitNs);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Checks and times the streaming PnL engine. A scripted trade sequence
+// must land on hand-computed positions; random swaps over many wallets
+// must give the same leaderboards as sorting every wallet, before and
+// after a snapshot round trip:
+//
+//   test_pnl_engine [wallets] [swaps]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "Clients/Solana/gRPC/Core/PnlEngine.hpp"
+
+using namespace solana;
+
+namespace {
+Pubkey makeKey(uint32_t seed)
+{
+    Pubkey key;
+    for (size_t i = 0; i < key.bytes.size(); ++i) {
+        key.bytes[i] = static_cast<uint8_t>((seed >> (8 * (i % 4))) + i * 7);
+    }
+    return key;
+}
+
+bool near(double a, double b)
+{
+    return std::fabs(a - b) < 1e-9;
+}
+
+bool checkScript()
+{
+    const Pubkey wallet = makeKey(1);
+    const Pubkey mint = makeKey(2);
+    PnlEngine engine;
+    bool ok = true;
+    auto expect = [&](const char* step, double realized, double unrealized,
+                      double quantity) {
+        json state = engine.wallet(wallet);
+        const json& position = state["positions"][0];
+        if (!near(state["realized_pnl"], realized)
+            || !near(state["unrealized_pnl"], unrealized)
+            || !near(position["quantity"], quantity)) {
+            spdlog::error("{}: got {}", step, state.dump());
+            ok = false;
+        }
+    };
+
+    // 200 tokens at an average of 0.02 SOL.
+    engine.onSwap(wallet, mint, true, 100, 1.0);
+    engine.onSwap(wallet, mint, true, 100, 3.0);
+    expect("two buys", 0.0, 200 * 0.03 - 4.0, 200);
+    // 150 sold at 0.03: 4.5 for a basis of 3.
+    engine.onSwap(wallet, mint, false, 150, 4.5);
+    expect("first sell", 1.5, 50 * 0.03 - 1.0, 50);
+    // Twice what is held, at 0.01: only the 50 held count, 0.5 for 1.
+    engine.onSwap(wallet, mint, false, 100, 1.0);
+    expect("oversell", 1.0, 0.0, 0);
+
+    // Priced in USDC, so skipped.
+    SwapFilter::SwapInfo swap {};
+    swap.wallet = wallet;
+    swap.tokenMint = mint;
+    swap.tokenAmount = 10;
+    swap.buy = true;
+    swap.hasQuote = true;
+    swap.quoteMint
+        = *Pubkey::fromBase58("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v");
+    swap.quoteAmount = 5;
+    engine.onSwap(swap);
+
+    json state = engine.wallet(wallet);
+    json stats = engine.getStats();
+    if (state["trades"] != 2 || state["wins"] != 1
+        || !near(state["volume"], 9.5) || stats["skipped"] != 1
+        || stats["swaps"] != 4) {
+        spdlog::error("totals: {} {}", state.dump(), stats.dump());
+        ok = false;
+    }
+    return ok;
+}
+
+// The best maxEntries by sorting every wallet's totals.
+std::vector<std::string> bruteForce(const PnlEngine& engine,
+    const std::vector<Pubkey>& wallets, const char* field, size_t maxEntries,
+    uint32_t minTrades)
+{
+    std::vector<std::pair<double, std::string>> scores;
+    for (const auto& wallet : wallets) {
+        json state = engine.wallet(wallet);
+        if (state.is_null())
+            continue;
+        if (std::string(field) == "win_rate" && state["trades"] < minTrades)
+            continue;
+        scores.emplace_back(state[field], state["wallet"]);
+    }
+    std::sort(scores.begin(), scores.end(),
+        [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<std::string> best;
+    for (size_t i = 0; i < std::min(maxEntries, scores.size()); ++i) {
+        best.push_back(scores[i].second);
+    }
+    return best;
+}
+
+bool checkLeaderboards(const PnlEngine& engine,
+    const std::vector<Pubkey>& wallets, const char* when)
+{
+    // Win rates tie often, so only their scores are compared.
+    bool ok = true;
+    for (const char* name : { "realized_pnl", "volume", "win_rate" }) {
+        auto ranking = *PnlEngine::rankingFromName(name);
+        json board = engine.leaderboard(ranking, 20);
+        auto expected = bruteForce(engine, wallets, name, 20, 5);
+        bool same = board.size() == expected.size();
+        for (size_t i = 0; same && i < board.size(); ++i) {
+            same = std::string(name) == "win_rate"
+                ? near(board[i][name],
+                      engine.wallet(*Pubkey::fromBase58(
+                          expected[i].c_str()))[name])
+                : board[i]["wallet"] == expected[i];
+        }
+        if (!same) {
+            spdlog::error("{} leaderboard {} differs from a full sort", name,
+                when);
+            ok = false;
+        }
+    }
+    return ok;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t walletCount = argc > 1 ? std::stoul(argv[1]) : 100'000;
+    size_t swapCount = argc > 2 ? std::stoull(argv[2]) : 2'000'000;
+
+    bool ok = checkScript();
+
+    std::vector<Pubkey> wallets;
+    for (uint32_t i = 0; i < walletCount; ++i) {
+        wallets.push_back(makeKey(i * 2654435761u + 7));
+    }
+    std::vector<Pubkey> mints;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        mints.push_back(makeKey(~i * 40503u));
+    }
+    // Prices drift per mint; wallets buy about as often as they sell.
+    struct Swap {
+        uint32_t wallet;
+        uint32_t mint;
+        bool buy;
+        double tokens;
+        double sol;
+    };
+    std::mt19937_64 random(42);
+    std::vector<double> prices(mints.size(), 1e-4);
+    std::vector<Swap> swaps(swapCount);
+    for (auto& swap : swaps) {
+        swap.wallet = static_cast<uint32_t>(random() % walletCount);
+        swap.mint = static_cast<uint32_t>(random() % mints.size());
+        prices[swap.mint]
+            *= 1.0 + (static_cast<double>(random() % 2001) - 1000.0) / 2e4;
+        swap.buy = random() % 2;
+        swap.tokens = static_cast<double>(1'000 + random() % 1'000'000);
+        swap.sol = swap.tokens * prices[swap.mint];
+    }
+
+    // Timed again once every position exists, without the maps growing.
+    PnlEngine engine;
+    double swapNs[2];
+    for (double& ns : swapNs) {
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& swap : swaps) {
+            engine.onSwap(wallets[swap.wallet], mints[swap.mint], swap.buy,
+                swap.tokens, swap.sol);
+        }
+        ns = std::chrono::duration<double, std::nano>(
+                 std::chrono::steady_clock::now() - start)
+                 .count()
+            / static_cast<double>(swapCount);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    constexpr int QUERIES = 1000;
+    size_t entries = 0;
+    for (int i = 0; i < QUERIES; ++i) {
+        entries
+            += engine.leaderboard(PnlEngine::Ranking::RealizedPnl, 20).size();
+    }
+    double queryUs = std::chrono::duration<double, std::micro>(
+                         std::chrono::steady_clock::now() - start)
+                         .count()
+        / QUERIES;
+
+    ok = checkLeaderboards(engine, wallets, "after the swaps") && ok;
+
+    start = std::chrono::steady_clock::now();
+    std::string snapshot = engine.snapshot();
+    double snapshotMs = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    PnlEngine restored(7);
+    if (!restored.restore(snapshot)
+        || restored.getStats()["positions"] != engine.getStats()["positions"]
+        || restored.leaderboard(PnlEngine::Ranking::Volume, 50)
+            != engine.leaderboard(PnlEngine::Ranking::Volume, 50)
+        || !checkLeaderboards(restored, wallets, "after a restore")) {
+        spdlog::error("restored engine differs");
+        ok = false;
+    }
+    if (restored.restore(snapshot.substr(0, snapshot.size() / 2))) {
+        spdlog::error("truncated snapshot accepted");
+        ok = false;
+    }
+
+    json stats = engine.getStats();
+    spdlog::info("{} swaps over {} wallets: {:.1f} ns/swap opening "
+                 "positions, {:.1f} ns/swap on open ones, top 20 in {:.1f} us, "
+                 "{} positions in ~{} MB, snapshot of {} MB in {:.1f} ms",
+        swapCount, walletCount, swapNs[0], swapNs[1], queryUs,
+        stats["positions"].get<size_t>(),
+        stats["approx_bytes"].get<size_t>() >> 20, snapshot.size() >> 20,
+        snapshotMs);
+    return ok && entries == QUERIES * 20 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Checks and times the recent-items ring behind /recent_swaps and
+// /recent_dex. One writer pushes numbered items while readers page
+// through them with since() and poll latest(), verifying every copy they
+// get is whole and in order:
+//
+//   test_recent_ring [readers] [items] [capacity]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "Clients/Solana/gRPC/Core/RecentRing.hpp"
+
+using namespace solana;
+
+namespace {
+// About the size of a recorded swap.
+struct Item {
+    uint64_t sequence;
+    uint64_t check[15];
+};
+
+Item stamp(uint64_t sequence)
+{
+    Item item { sequence, {} };
+    for (size_t i = 0; i < std::size(item.check); ++i) {
+        item.check[i] = sequence * (i + 3) ^ 0x9e3779b97f4a7c15ull;
+    }
+    return item;
+}
+
+bool whole(uint64_t sequence, const Item& item)
+{
+    if (item.sequence != sequence)
+        return false;
+    for (size_t i = 0; i < std::size(item.check); ++i) {
+        if (item.check[i] != (sequence * (i + 3) ^ 0x9e3779b97f4a7c15ull))
+            return false;
+    }
+    return true;
+}
+
+struct ReaderResult {
+    uint64_t received { 0 };
+    uint64_t torn { 0 };
+    uint64_t reordered { 0 };
+};
+}
+
+int main(int argc, char* argv[])
+{
+    size_t readers = argc > 1 ? std::stoul(argv[1]) : 4;
+    uint64_t items = argc > 2 ? std::stoull(argv[2]) : 20'000'000;
+    size_t capacity = argc > 3 ? std::stoul(argv[3]) : 1024;
+
+    RecentRing<Item> ring(capacity);
+    std::atomic<bool> done { false };
+    std::vector<ReaderResult> results(readers + 1);
+    std::vector<std::jthread> threads;
+
+    // Pagers, as clients following /recent_swaps?since=N.
+    for (size_t r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            auto& result = results[r];
+            uint64_t next = 0;
+            uint64_t last = 0;
+            bool first = true;
+            while (!done.load(std::memory_order_relaxed)
+                || next < ring.head()) {
+                next = ring.since(
+                    next, 64, [&](uint64_t sequence, const Item& item) {
+                        ++result.received;
+                        result.torn += !whole(sequence, item);
+                        result.reordered += !first && sequence <= last;
+                        last = sequence;
+                        first = false;
+                    });
+            }
+        });
+    }
+    // A dashboard polling the newest items.
+    threads.emplace_back([&] {
+        auto& result = results[readers];
+        while (!done.load(std::memory_order_relaxed)) {
+            uint64_t previous = UINT64_MAX;
+            ring.latest(100, [&](uint64_t sequence, const Item& item) {
+                ++result.received;
+                result.torn += !whole(sequence, item);
+                result.reordered += sequence >= previous;
+                previous = sequence;
+            });
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t sequence = 0; sequence < items; ++sequence) {
+        ring.push(stamp(sequence));
+    }
+    double pushNs = std::chrono::duration<double, std::nano>(
+                        std::chrono::steady_clock::now() - start)
+                        .count()
+        / static_cast<double>(items);
+    done = true;
+    threads.clear();
+
+    uint64_t torn = 0, reordered = 0;
+    for (size_t r = 0; r <= readers; ++r) {
+        const auto& result = results[r];
+        spdlog::info("{} {}: {} received, {} torn, {} out of order",
+            r < readers ? "pager" : "latest", r, result.received, result.torn,
+            result.reordered);
+        torn += result.torn;
+        reordered += result.reordered;
+    }
+    spdlog::info("{} items through a ring of {}: {:.1f} ns/push with {} "
+                 "readers",
+        items, ring.capacity(), pushNs, readers + 1);
+    if (torn || reordered) {
+        spdlog::error("{} torn and {} reordered reads", torn, reordered);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Golden cases and a benchmark for config rules. Rules that should not
+// compile must fail with the right message; rules that do are checked
+// against transactions encoded with geyser.pb.h, both on their own and
+// through RuleFilter. The benchmark then feeds a stream where the rule's
+// first test almost always passes, and checks RuleFilter moves the
+// selective one to the front:
+//
+//   test_rule_filter [transactions]
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "Clients/Solana/gRPC/Core/RuleFilter.hpp"
+#include "Tests/TestFrame.hpp"
+
+using namespace solana;
+using namespace solana::tests;
+
+namespace {
+constexpr uint64_t SOL = 1'000'000'000;
+constexpr uint64_t RENT = 2'039'280;
+
+const Pubkey SMART = makeKey(1);
+const Pubkey OTHER = makeKey(2);
+const Pubkey SYSTEM {};
+const Pubkey RAYDIUM
+    = *Pubkey::fromBase58("675kPX9MHTjS2zt1qfr1NYHuzeLXfQM9H24wFSUt1Mp8");
+const Pubkey BONK
+    = *Pubkey::fromBase58("DezXAZ8z7PnrnRJjz3wXBoRgixCa6xjnB7YaB1pPB263");
+
+// wallet buys BONK on Raydium for sol SOL, opening its token account.
+std::string raydiumBuy(const Pubkey& wallet, uint64_t sol, uint8_t signature,
+    uint64_t computeUnits = 80'000)
+{
+    Frame frame;
+    frame.account(wallet, 100 * SOL, (100 - sol) * SOL - RENT - FEE);
+    size_t ata = frame.account(makeKey(10), 0, RENT);
+    frame.account(makeKey(11), 500 * SOL, (500 + sol) * SOL);
+    frame.call(frame.account(RAYDIUM, 1, 1));
+    frame.token(ata, wallet, BONK, 5, std::nullopt, 1'000'000);
+    frame.computeUnits(computeUnits);
+    return frame.serialize(signature);
+}
+
+std::string solTransfer(const Pubkey& wallet, uint64_t sol, uint8_t signature)
+{
+    Frame frame;
+    frame.account(wallet, 100 * SOL, (100 - sol) * SOL - FEE);
+    frame.account(makeKey(12), 0, sol * SOL);
+    frame.call(frame.account(SYSTEM, 1, 1));
+    frame.computeUnits(80'000);
+    return frame.serialize(signature);
+}
+
+std::string quoted(const Pubkey& key)
+{
+    return "\"" + key.toBase58() + "\"";
+}
+
+struct Rule {
+    const char* name;
+    std::string when;
+    // Which of the frames below it matches, in order.
+    std::vector<bool> matches;
+};
+
+std::vector<std::string> goldenFrames()
+{
+    return {
+        raydiumBuy(SMART, 60, 1, 200'000),
+        raydiumBuy(OTHER, 60, 2),
+        raydiumBuy(SMART, 2, 3),
+        solTransfer(SMART, 5, 4),
+    };
+}
+
+std::vector<Rule> goldenRules()
+{
+    return {
+        { "smart_whale_raydium",
+            "program in {" + quoted(RAYDIUM)
+                + "} and swap.sol_amount > 50 and signer in wallets(\"smart\")",
+            { true, false, false, false } },
+        { "smart_off_raydium",
+            "signer in wallets(\"smart\") and not program in {"
+                + quoted(RAYDIUM) + "}",
+            { false, false, false, true } },
+        { "moved_sol",
+            "swap.sol_amount > 2 and (mint in {" + quoted(BONK)
+                + "} or swap.token_count == 0)",
+            { true, true, false, true } },
+        { "cheap", "fee == 5000 and compute_units < 100000",
+            { false, true, true, true } },
+        { "touches",
+            "owner in {" + quoted(SMART) + "} or account in {" + quoted(OTHER)
+                + "}",
+            { true, true, true, false } },
+    };
+}
+
+struct BadRule {
+    const char* when;
+    const char* error;
+};
+
+const BadRule BAD_RULES[] = {
+    { "volume > 5", "unknown field 'volume' at column 1" },
+    { "swap.sol_amount in {}",
+        "expected a comparison after swap.sol_amount at column 17" },
+    { "signer > 5", "expected 'in' at column 8" },
+    { "signer in wallets(\"whales\")",
+        "unknown wallet list 'whales' at column 19" },
+    { "program in {\"notbase58!\"}",
+        "invalid address 'notbase58!' at column 13" },
+    { "fee > 5 and", "expected a field at column 12" },
+    { "(fee > 5", "expected ')' at column 9" },
+    { "fee > 5 fee", "unexpected 'fee' at column 9" },
+    { "fee > 5x", "invalid number '5x' at column 7" },
+    { "fee > 5 & fee", "unexpected character '&' at column 9" },
+};
+
+std::map<std::string, std::shared_ptr<const WalletSet>> walletLists()
+{
+    std::vector<Pubkey> smart { SMART };
+    return { { "smart", std::make_shared<const WalletSet>(smart) } };
+}
+
+bool checkBadRules()
+{
+    bool ok = true;
+    for (const auto& bad : BAD_RULES) {
+        std::string error = "compiled";
+        try {
+            RuleProgram::compile(bad.when, walletLists());
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+        if (error != bad.error) {
+            spdlog::error("'{}': got '{}', expected '{}'", bad.when, error,
+                bad.error);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+std::vector<TransactionView> scanAll(const std::vector<std::string>& frames)
+{
+    std::vector<TransactionView> views(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        views[i].scan(frames[i]);
+        views[i].resolve();
+    }
+    return views;
+}
+
+json filterConfig(const std::vector<Rule>& rules)
+{
+    json config;
+    config["wallets"]["smart"] = { SMART.toBase58() };
+    for (const auto& rule : rules) {
+        config["rule"].push_back({ { "name", rule.name },
+            { "when", rule.when }, { "notify", true } });
+    }
+    return config;
+}
+
+bool checkGoldenRules()
+{
+    const auto frames = goldenFrames();
+    const auto views = scanAll(frames);
+    const auto rules = goldenRules();
+    bool ok = true;
+
+    RuleFilter filter;
+    filter.updateConfig(filterConfig(rules).dump());
+    std::map<std::string, size_t> notified;
+    filter.ruleMatched.subscribe(
+        [&](const std::string& rule, const std::string&) {
+            ++notified[rule];
+        });
+    for (const auto& view : views) {
+        filter.processView("test", view);
+    }
+    const json stats = filter.getRuleStats();
+
+    for (const auto& rule : rules) {
+        auto program = RuleProgram::compile(rule.when, walletLists());
+        size_t hits = 0;
+        for (size_t i = 0; i < views.size(); ++i) {
+            RuleContext context(views[i]);
+            bool matched = program.evaluate(context);
+            hits += matched;
+            if (matched != rule.matches[i]) {
+                spdlog::error("{} on frame {}: got {}", rule.name, i, matched);
+                ok = false;
+            }
+        }
+        if (stats[rule.name]["hits"] != hits || notified[rule.name] != hits) {
+            spdlog::error("{}: {} hits through RuleFilter, {} notified, "
+                          "expected {}",
+                rule.name, stats[rule.name]["hits"].get<uint64_t>(),
+                notified[rule.name], hits);
+            ok = false;
+        }
+        spdlog::info("{}: {} of {} ({})", rule.name, hits, views.size(),
+            program.toString());
+    }
+    return ok;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    size_t transactions = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+
+    bool ok = checkBadRules();
+    ok = checkGoldenRules() && ok;
+
+    // Every transaction goes to Raydium, one in a hundred from a smart
+    // wallet: the account test passes almost always and belongs last.
+    std::vector<std::string> frames;
+    for (uint8_t i = 0; i < 100; ++i) {
+        frames.push_back(raydiumBuy(i == 0 ? SMART : makeKey(100 + i),
+            1 + i % 7, i));
+    }
+    const auto views = scanAll(frames);
+    RuleFilter filter;
+    filter.updateConfig(filterConfig({ { "smart_raydium",
+                                         "account in {" + quoted(RAYDIUM)
+                                             + "} and signer in "
+                                               "wallets(\"smart\")",
+                                         {} } })
+                            .dump());
+    spdlog::set_level(spdlog::level::warn);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < transactions; ++i) {
+        filter.processView("bench", views[i % views.size()]);
+    }
+    double ns = std::chrono::duration<double, std::nano>(
+                    std::chrono::steady_clock::now() - start)
+                    .count()
+        / static_cast<double>(transactions);
+    spdlog::set_level(spdlog::level::info);
+
+    const json stats = filter.getRuleStats()["smart_raydium"];
+    spdlog::info("{} transactions: {:.1f} ns each through RuleFilter, "
+                 "{:.1f} ns/eval sampled, {} hits, order {}",
+        transactions, ns, stats["ns_per_eval"].get<double>(),
+        stats["hits"].get<uint64_t>(), stats["order"].get<std::string>());
+    if (stats["hits"] != (transactions + 99) / 100) {
+        spdlog::error("expected {} hits", (transactions + 99) / 100);
+        ok = false;
+    }
+    const uint64_t reorderAfter
+        = RuleFilter::SAMPLE_EVERY * RuleFilter::REORDER_SAMPLES;
+    if (transactions >= reorderAfter
+        && stats["order"].get<std::string>().rfind("signer", 0) != 0) {
+        spdlog::error("signer test not moved first");
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+// Checks and times SlotReorderBuffer: slots must come out lowest first and
+// only once closed, timed out or pushed out of the window; a slot closed on
+// one lane must wait for the others; and transactions for a slot already
+// released must come through as late:
+//
+//   test_slot_reorder_buffer [transactions]
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include <geyser.grpc.pb.h>
+
+#include "Clients/Solana/gRPC/Core/SlotReorderBuffer.hpp"
+
+using namespace solana;
+
+namespace {
+using Clock = SlotReorderBuffer::Clock;
+using Reason = SlotReorderBuffer::Reason;
+
+constexpr auto TIMEOUT = std::chrono::milliseconds(400);
+
+struct Expected {
+    uint64_t slot;
+    Reason reason;
+    size_t transactions;
+};
+
+void hold(SlotReorderBuffer& buffer, size_t lane,
+    const std::vector<uint64_t>& slots, Clock::time_point now)
+{
+    TransactionBatch batch;
+    for (uint64_t slot : slots) {
+        batch.append(TransactionBatch::Entry {
+            "sig" + std::to_string(slot), "wire", slot, nullptr });
+    }
+    buffer.hold(lane, batch, now, now, now);
+}
+
+void close(SlotReorderBuffer& buffer, size_t lane, uint64_t slot,
+    Clock::time_point now, bool dead = false)
+{
+    buffer.apply(lane, { slot, true, dead }, now);
+}
+
+bool expect(const char* name,
+    const std::vector<SlotReorderBuffer::Release>& released,
+    const std::vector<Expected>& expected)
+{
+    bool ok = released.size() == expected.size();
+    for (size_t i = 0; ok && i < released.size(); ++i) {
+        ok = released[i].slot == expected[i].slot
+            && released[i].reason == expected[i].reason
+            && released[i].batch->size() == expected[i].transactions;
+    }
+    if (!ok) {
+        std::string got;
+        for (const auto& release : released) {
+            got += " " + std::to_string(release.slot) + ":"
+                + SlotReorderBuffer::reasonName(release.reason) + ":"
+                + std::to_string(release.batch->size());
+        }
+        spdlog::error("{}: released{}", name, got.empty() ? " nothing" : got);
+    }
+    return ok;
+}
+
+bool checkOrdering()
+{
+    SlotReorderBuffer buffer({ 32, TIMEOUT });
+    auto now = Clock::now();
+    hold(buffer, 0, { 12, 10, 11, 10 }, now);
+    // Closing 11 releases nothing while 10 is still open.
+    close(buffer, 0, 11, now);
+    bool ok = expect("ordering, 10 open", buffer.release(now), {});
+    close(buffer, 0, 10, now);
+    ok = expect("ordering", buffer.release(now),
+             { { 10, Reason::COMPLETE, 2 }, { 11, Reason::COMPLETE, 1 } })
+        && ok;
+    ok = expect("flush", buffer.release(now, true),
+             { { 12, Reason::FLUSH, 1 } })
+        && ok;
+    return ok && buffer.empty();
+}
+
+bool checkTimeout()
+{
+    SlotReorderBuffer buffer({ 32, TIMEOUT });
+    auto now = Clock::now();
+    hold(buffer, 0, { 20 }, now);
+    hold(buffer, 0, { 21 }, now + TIMEOUT / 2);
+    bool ok = expect("timeout, too soon", buffer.release(now + TIMEOUT / 2),
+        {});
+    ok = expect("timeout", buffer.release(now + TIMEOUT),
+             { { 20, Reason::TIMEOUT, 1 } })
+        && ok;
+    ok = expect("timeout, second", buffer.release(now + TIMEOUT * 2),
+             { { 21, Reason::TIMEOUT, 1 } })
+        && ok;
+    return ok;
+}
+
+bool checkWindow()
+{
+    SlotReorderBuffer buffer({ 2, TIMEOUT });
+    auto now = Clock::now();
+    hold(buffer, 0, { 30, 31, 32, 33 }, now);
+    bool ok = expect("window", buffer.release(now),
+        { { 30, Reason::WINDOW, 1 }, { 31, Reason::WINDOW, 1 } });
+    // An event alone opens a slot as well.
+    close(buffer, 0, 35, now);
+    ok = expect("window, event", buffer.release(now),
+             { { 32, Reason::WINDOW, 1 } })
+        && ok;
+    return ok;
+}
+
+bool checkDead()
+{
+    geyser::SubscribeUpdate update;
+    update.mutable_slot()->set_slot(40);
+    update.mutable_slot()->set_status(geyser::SLOT_DEAD);
+    SlotReorderBuffer::SlotEvent event;
+    bool ok = SlotReorderBuffer::parseEvent(update.SerializeAsString(), event)
+        && event.slot == 40 && event.closes && event.dead;
+
+    // Statuses before PROCESSED arrive while the slot is still replayed.
+    SlotReorderBuffer::SlotEvent early;
+    update.mutable_slot()->set_status(geyser::SLOT_FIRST_SHRED_RECEIVED);
+    ok = ok && SlotReorderBuffer::parseEvent(update.SerializeAsString(), early)
+        && !early.closes;
+    geyser::SubscribeUpdate meta;
+    meta.mutable_block_meta()->set_slot(41);
+    SlotReorderBuffer::SlotEvent frozen;
+    ok = ok && SlotReorderBuffer::parseEvent(meta.SerializeAsString(), frozen)
+        && frozen.slot == 41 && frozen.closes && !frozen.dead;
+    if (!ok)
+        spdlog::error("slot events did not parse as expected");
+
+    SlotReorderBuffer buffer({ 32, TIMEOUT });
+    auto now = Clock::now();
+    hold(buffer, 0, { 40, 41 }, now);
+    buffer.apply(0, event, now);
+    buffer.apply(0, early, now);
+    ok = expect("dead", buffer.release(now), { { 40, Reason::DEAD, 1 } })
+        && ok;
+    buffer.apply(0, frozen, now);
+    ok = expect("after dead", buffer.release(now),
+             { { 41, Reason::COMPLETE, 1 } })
+        && ok;
+    return ok;
+}
+
+bool checkLate()
+{
+    SlotReorderBuffer buffer({ 32, TIMEOUT });
+    auto now = Clock::now();
+    hold(buffer, 0, { 50 }, now);
+    close(buffer, 0, 50, now);
+    bool ok = expect("late, first", buffer.release(now),
+        { { 50, Reason::COMPLETE, 1 } });
+    // A close for a released slot is ignored; its transactions go straight
+    // through, ahead of anything still held.
+    hold(buffer, 0, { 49, 51, 50 }, now);
+    close(buffer, 0, 50, now);
+    ok = expect("late", buffer.release(now), { { 50, Reason::LATE, 2 } })
+        && ok;
+    json stats = buffer.getStats();
+    if (stats["late_transactions"] != 2 || stats["open_slots"] != 1) {
+        spdlog::error("late: {}", stats.dump());
+        ok = false;
+    }
+    return ok;
+}
+
+bool checkLanes()
+{
+    SlotReorderBuffer buffer({ 32, TIMEOUT }, 2);
+    auto now = Clock::now();
+    hold(buffer, 0, { 60 }, now);
+    hold(buffer, 1, { 60 }, now);
+    close(buffer, 0, 60, now);
+    // Lane 1 may still have transactions of slot 60 on the way.
+    bool ok = expect("lanes, behind", buffer.release(now), {});
+    // Its transactions interleave slots, only its own close passes one.
+    hold(buffer, 1, { 61, 60 }, now);
+    ok = expect("lanes, interleaved", buffer.release(now), {}) && ok;
+    close(buffer, 1, 60, now);
+    ok = expect("lanes, passed", buffer.release(now),
+             { { 60, Reason::COMPLETE, 3 } })
+        && ok;
+
+    close(buffer, 0, 61, now);
+    ok = expect("lanes, busy", buffer.release(now), {}) && ok;
+    buffer.setIdle(1, true);
+    ok = expect("lanes, idle", buffer.release(now),
+             { { 61, Reason::COMPLETE, 1 } })
+        && ok;
+
+    // A lane that never catches up still lets the slot go on timeout.
+    buffer.setIdle(1, false);
+    hold(buffer, 0, { 62 }, now);
+    close(buffer, 0, 62, now);
+    ok = expect("lanes, timeout", buffer.release(now + TIMEOUT),
+             { { 62, Reason::TIMEOUT, 1 } })
+        && ok;
+    return ok;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    size_t transactions = argc > 1 ? std::stoull(argv[1]) : 1'000'000;
+
+    bool ok = checkOrdering();
+    ok = checkTimeout() && ok;
+    ok = checkWindow() && ok;
+    ok = checkDead() && ok;
+    ok = checkLate() && ok;
+    ok = checkLanes() && ok;
+
+    // Four lanes, each a few transactions behind the others, each closing
+    // the previous slot on its own stream.
+    constexpr size_t LANES = 4;
+    constexpr size_t PER_SLOT = 1000;
+    constexpr size_t PER_BATCH = 100;
+    SlotReorderBuffer buffer({ 32, TIMEOUT }, LANES);
+    auto start = Clock::now();
+    size_t released = 0;
+    for (size_t i = 0; i < transactions; i += PER_BATCH) {
+        size_t lane = (i / PER_BATCH) % LANES;
+        uint64_t slot = i / PER_SLOT + 1;
+        TransactionBatch batch(PER_BATCH);
+        for (size_t j = 0; j < PER_BATCH; ++j) {
+            batch.append(TransactionBatch::Entry { "signature", {}, slot,
+                nullptr });
+        }
+        buffer.hold(lane, batch, start, start, start);
+        if (slot > 1)
+            buffer.apply(lane, { slot - 1, true, false }, start);
+        for (const auto& release : buffer.release(start)) {
+            released += release.batch->size();
+        }
+    }
+    for (const auto& release : buffer.release(start, true)) {
+        released += release.batch->size();
+    }
+    double holdNs = std::chrono::duration<double, std::nano>(
+                        Clock::now() - start)
+                        .count()
+        / static_cast<double>(transactions);
+    json stats = buffer.getStats();
+    if (released != transactions || stats["late_transactions"] != 0) {
+        spdlog::error("released {} of {}: {}", released, transactions,
+            stats.dump());
+        ok = false;
+    }
+
+    spdlog::info("{} transactions over {} lanes: {:.1f} ns/transaction, {} "
+                 "slots completed",
+        transactions, LANES, holdNs, stats["completed"].get<size_t>());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Golden cases and a benchmark for SwapFilter's balance-delta join. Each
+// case is a transaction shaped like a real one of its kind, encoded with
+// geyser.pb.h and run through scan, resolve and processView. Detection is
+// timed once more while another thread keeps reloading a large wallet
+// list:
+//
+//   test_swap_filter [passes]
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "Clients/Solana/gRPC/Core/SwapFilter.hpp"
+#include "Tests/TestFrame.hpp"
+
+using namespace solana;
+using namespace solana::tests;
+
+namespace {
+constexpr uint64_t SOL = 1'000'000'000;
+// Rent-exempt minimum of a token account.
+constexpr uint64_t RENT = 2'039'280;
+constexpr uint32_t RELOAD_WALLETS = 100'000;
+
+const Pubkey WALLET = makeKey(1);
+const Pubkey OTHER = makeKey(2);
+const Pubkey POOL = makeKey(3);
+const Pubkey WSOL
+    = *Pubkey::fromBase58("So11111111111111111111111111111111111111112");
+const Pubkey USDC
+    = *Pubkey::fromBase58("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v");
+const Pubkey BONK
+    = *Pubkey::fromBase58("DezXAZ8z7PnrnRJjz3wXBoRgixCa6xjnB7YaB1pPB263");
+const Pubkey PUMP = makeKey(4);
+
+struct Expected {
+    std::string token;
+    std::string direction;
+    uint64_t rawAmount;
+    std::string quote;
+    double price;
+};
+
+struct Case {
+    const char* name;
+    std::string frame;
+    std::vector<Expected> swaps;
+};
+
+std::vector<Case> goldenCases()
+{
+    std::vector<Case> cases;
+
+    // Bonding-curve buy paid in native SOL; the wallet pays the fee and
+    // the rent of the token account the buy opens.
+    {
+        Frame frame;
+        frame.account(WALLET, 10 * SOL, 9 * SOL - RENT - FEE);
+        size_t ata = frame.account(makeKey(10), 0, RENT);
+        frame.account(POOL, 80 * SOL, 81 * SOL);
+        size_t curve = frame.account(makeKey(11), RENT, RENT);
+        frame.token(ata, WALLET, PUMP, 6, std::nullopt, 35'000'000'000'000);
+        frame.token(curve, POOL, PUMP, 6, 800'000'000'000'000,
+            765'000'000'000'000);
+        cases.push_back({ "native SOL buy", frame.serialize(1),
+            { { "PUMP", "buy", 35'000'000'000'000, "SOL", 1.0 / 35e6 } } });
+    }
+
+    // AMM sell into WSOL through a temporary account that is opened and
+    // closed within the transaction, so only native lamports show it.
+    {
+        Frame frame;
+        frame.account(WALLET, 2 * SOL, 2 * SOL + SOL / 2 - FEE);
+        size_t ata = frame.account(makeKey(12), RENT, RENT);
+        size_t vault = frame.account(makeKey(13), RENT, RENT);
+        frame.token(ata, WALLET, BONK, 5, 100'000'000'000, 0);
+        frame.token(vault, POOL, BONK, 5, 0, 100'000'000'000);
+        cases.push_back({ "unwrapped WSOL sell", frame.serialize(2),
+            { { "BONK", "sell", 100'000'000'000, "SOL", 5e-7 } } });
+    }
+
+    // Wrapped SOL sell: the proceeds stay in the wallet's WSOL account.
+    {
+        Frame frame;
+        frame.account(WALLET, 2 * SOL, 2 * SOL - FEE);
+        size_t ata = frame.account(makeKey(14), RENT, RENT);
+        size_t wsol = frame.account(makeKey(15), RENT + SOL, RENT + 3 * SOL);
+        frame.token(ata, WALLET, BONK, 5, 400'000'000'000, 0);
+        frame.token(wsol, WALLET, WSOL, 9, SOL, 3 * SOL);
+        cases.push_back({ "WSOL sell", frame.serialize(3),
+            { { "BONK", "sell", 400'000'000'000, "SOL", 2.0 / 4e6 } } });
+    }
+
+    // Two-hop route USDC -> SOL -> BONK. The SOL hop happens in pool
+    // accounts, so the wallet only sees USDC leave and BONK arrive.
+    {
+        Frame frame;
+        frame.account(WALLET, SOL, SOL - FEE);
+        size_t usdc = frame.account(makeKey(16), RENT, RENT);
+        size_t bonk = frame.account(makeKey(17), RENT, RENT);
+        size_t pool = frame.account(makeKey(18), 50 * SOL, 50 * SOL + SOL / 4);
+        frame.token(usdc, WALLET, USDC, 6, 100'000'000, 0);
+        frame.token(bonk, WALLET, BONK, 5, 0, 200'000'000'000);
+        frame.token(pool, POOL, WSOL, 9, 50 * SOL, 50 * SOL + SOL / 4);
+        cases.push_back({ "multi-hop", frame.serialize(4),
+            { { "USDC", "sell", 100'000'000, "BONK", 2e6 / 100 },
+                { "BONK", "buy", 200'000'000'000, "USDC", 100 / 2e6 } } });
+    }
+
+    // Two tokens sold for SOL at once: each is reported, neither priced.
+    {
+        Frame frame;
+        frame.account(WALLET, SOL, SOL + 3 * SOL / 2 - FEE);
+        size_t pump = frame.account(makeKey(19), RENT, 0);
+        size_t bonk = frame.account(makeKey(20), RENT, RENT);
+        frame.token(pump, WALLET, PUMP, 6, 5'000'000'000, std::nullopt);
+        frame.token(bonk, WALLET, BONK, 5, 300'000'000'000, 0);
+        cases.push_back({ "multi-token", frame.serialize(5),
+            { { "BONK", "sell", 300'000'000'000, "", 0.0 },
+                { "PUMP", "sell", 5'000'000'000, "", 0.0 } } });
+    }
+
+    // A wallet that is not tracked, and a tracked one moving dust.
+    {
+        Frame frame;
+        frame.account(OTHER, 10 * SOL, 9 * SOL - FEE);
+        size_t ata = frame.account(makeKey(21), RENT, RENT);
+        frame.token(ata, OTHER, BONK, 5, 0, 500'000'000'000);
+        cases.push_back({ "untracked wallet", frame.serialize(6), {} });
+    }
+    {
+        Frame frame;
+        frame.account(WALLET, 10 * SOL, 10 * SOL - 1000 - FEE);
+        size_t ata = frame.account(makeKey(22), RENT, RENT);
+        frame.token(ata, WALLET, BONK, 5, 0, 50'000);
+        cases.push_back({ "below minimum", frame.serialize(7), {} });
+    }
+    return cases;
+}
+
+std::shared_ptr<SwapFilter> makeFilter()
+{
+    auto filter = std::make_shared<SwapFilter>(
+        std::unordered_set<std::string> { WALLET.toBase58() }, 1.0);
+    json config;
+    config["token_names"][BONK.toBase58()] = "BONK";
+    config["token_names"][PUMP.toBase58()] = "PUMP";
+    filter->updateConfig(config.dump());
+    return filter;
+}
+
+template <typename Fn>
+double nsPerFrame(const std::vector<std::string>& frames, int passes, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& frame : frames) {
+            fn(frame);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count()
+        / static_cast<double>(frames.size() * passes);
+}
+
+bool close(double a, double b)
+{
+    return std::fabs(a - b) <= 1e-9 * std::max(std::fabs(a), std::fabs(b));
+}
+
+bool check(const Case& test)
+{
+    auto filter = makeFilter();
+    TransactionView view;
+    if (!view.scan(test.frame) || !view.resolve()) {
+        spdlog::error("{}: frame did not scan", test.name);
+        return false;
+    }
+    filter->processView("golden", view);
+
+    // Newest first.
+    json swaps = filter->getRecentSwaps();
+    bool ok = swaps.size() == test.swaps.size();
+    for (size_t i = 0; ok && i < test.swaps.size(); ++i) {
+        const auto& expected = test.swaps[i];
+        const auto& swap = swaps[test.swaps.size() - 1 - i];
+        ok = swap["token_name"] == expected.token
+            && swap["direction"] == expected.direction
+            && swap["token_raw_amount"] == expected.rawAmount
+            && swap["quote_name"] == expected.quote
+            && close(swap["price"].get<double>(), expected.price);
+    }
+    if (!ok)
+        spdlog::error("{}: expected {} swaps, got {}", test.name,
+            test.swaps.size(), swaps.dump());
+    return ok;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int passes = argc > 1 ? std::max(1, std::stoi(argv[1])) : 100000;
+
+    auto cases = goldenCases();
+    size_t failed = 0;
+    for (const auto& test : cases) {
+        failed += !check(test);
+    }
+    if (failed) {
+        spdlog::error("{} of {} golden cases failed", failed, cases.size());
+        return 1;
+    }
+    spdlog::info("{} golden cases passed", cases.size());
+
+    // Most of a live feed matches nothing, and matches are dominated by
+    // formatting them, so the two are timed apart.
+    std::vector<std::string> swaps, others;
+    for (const auto& test : cases) {
+        (test.swaps.empty() ? others : swaps).push_back(test.frame);
+    }
+    auto filter = makeFilter();
+    TransactionView view;
+    uint64_t sink = 0;
+    auto detect = [&](const std::string& frame) {
+        view.scan(frame);
+        view.resolve();
+        filter->processView("bench", view);
+        sink += view.balanceDeltas.size();
+    };
+    spdlog::set_level(spdlog::level::warn);
+    double resolveNs = nsPerFrame(swaps, passes, [&](const auto& frame) {
+        view.scan(frame);
+        view.resolve();
+        sink += view.balanceDeltas.size();
+    });
+    double otherNs = nsPerFrame(others, passes, detect);
+    double swapNs = nsPerFrame(swaps, passes, detect);
+
+    // Readers should not notice a reload beyond the cache misses of the
+    // new snapshot.
+    json reload;
+    reload["smart_wallets"].push_back(WALLET.toBase58());
+    for (uint32_t i = 0; i < RELOAD_WALLETS; ++i) {
+        Pubkey wallet {};
+        std::memcpy(wallet.bytes.data(), &i, sizeof(i));
+        reload["smart_wallets"].push_back(wallet.toBase58());
+    }
+    const std::string reloadConfig = reload.dump();
+    uint64_t reloads = 0;
+    double reloadNs;
+    {
+        std::atomic<bool> stop { false };
+        std::jthread reloader([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                filter->updateConfig(reloadConfig);
+                ++reloads;
+            }
+        });
+        reloadNs = nsPerFrame(others, passes, detect);
+        stop = true;
+    }
+    spdlog::set_level(spdlog::level::info);
+
+    spdlog::info("{} passes over {} swaps and {} other transactions", passes,
+        swaps.size(), others.size());
+    spdlog::info("scan+resolve:          {:.0f} ns/tx", resolveNs);
+    spdlog::info("detect, no swap:       {:.0f} ns/tx", otherNs);
+    spdlog::info("detect and record:     {:.0f} ns/tx", swapNs);
+    spdlog::info("detect, reloading:     {:.0f} ns/tx ({} reloads of {} "
+                 "wallets)",
+        reloadNs, reloads, RELOAD_WALLETS + 1);
+    spdlog::debug("checksum {}", sink);
+    return 0;
+}
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Reader-side throughput of the shared-memory transaction ring. One writer
+// thread publishes synthetic records in batches while every reader polls
+// the same segment through its own mapping, as separate processes would;
+// one extra reader is deliberately slow to show that it only loses records
+// and never slows the writer down:
+//
+//   test_txring [readers] [records] [capacity]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "Clients/Solana/gRPC/Shm/TxRingReader.hpp"
+#include "Clients/Solana/gRPC/Shm/TxRingWriter.hpp"
+
+using namespace solana;
+
+namespace {
+constexpr size_t WRITE_BATCH = 64;
+constexpr size_t READ_BATCH = 256;
+const std::string RING_NAME = "tengu_test_txring";
+
+struct ReaderResult {
+    uint64_t received { 0 };
+    uint64_t lost { 0 };
+    uint64_t torn { 0 };
+    uint64_t reordered { 0 };
+    double seconds { 0.0 };
+};
+
+void stamp(TxRingRecord& record, uint64_t sequence)
+{
+    record = TxRingRecord {};
+    record.slot = sequence / 1000;
+    record.index = sequence;
+    record.fee = sequence * 5000;
+    record.computeUnits = ~sequence;
+    for (size_t i = 0; i < sizeof(record.signature); ++i) {
+        record.signature[i] = static_cast<uint8_t>(sequence + i);
+    }
+}
+
+bool intact(const TxRingRecord& record)
+{
+    uint64_t sequence = record.index;
+    return record.slot == sequence / 1000 && record.fee == sequence * 5000
+        && record.computeUnits == ~sequence
+        && record.signature[63] == static_cast<uint8_t>(sequence + 63);
+}
+
+ReaderResult follow(const std::atomic<bool>& done, uint64_t end,
+    std::chrono::microseconds pause)
+{
+    TxRingReader reader(RING_NAME, TxRingReader::Start::OLDEST);
+    std::vector<TxRingRecord> records(READ_BATCH);
+    ReaderResult result;
+    uint64_t expected = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (reader.position() < end) {
+        size_t count = reader.poll(records.data(), records.size());
+        if (count == 0) {
+            if (done && reader.position() >= reader.head())
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const auto& record = records[i];
+            result.torn += !intact(record);
+            result.reordered += record.index < expected;
+            expected = record.index + 1;
+        }
+        result.received += count;
+        if (pause.count())
+            std::this_thread::sleep_for(pause);
+    }
+    result.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start)
+                         .count();
+    result.lost = reader.lost();
+    return result;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    size_t readerCount = argc > 1 ? std::max(1, std::stoi(argv[1])) : 4;
+    uint64_t total = argc > 2 ? std::stoull(argv[2]) : 20'000'000;
+    uint64_t capacity = argc > 3 ? std::stoull(argv[3]) : 1 << 16;
+
+    TxRingWriter::remove(RING_NAME);
+    TxRingWriter writer(RING_NAME, capacity);
+    spdlog::info("{} readers, {} records of {} bytes, {} slot ring",
+        readerCount, total, sizeof(TxRingRecord), writer.capacity());
+
+    std::atomic<bool> done { false };
+    std::vector<ReaderResult> results(readerCount + 1);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i <= readerCount; ++i) {
+        auto pause = i == readerCount ? std::chrono::microseconds(200)
+                                      : std::chrono::microseconds(0);
+        readers.emplace_back([&, i, pause] {
+            results[i] = follow(done, total, pause);
+        });
+    }
+    // Readers start at the oldest record, so none miss the beginning.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::vector<TxRingRecord> batch(WRITE_BATCH);
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t sequence = 0; sequence < total;) {
+        size_t count = std::min<uint64_t>(WRITE_BATCH, total - sequence);
+        for (size_t i = 0; i < count; ++i) {
+            stamp(batch[i], sequence + i);
+        }
+        writer.publish(batch.data(), count);
+        sequence += count;
+    }
+    double writeSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start)
+                              .count();
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    TxRingWriter::remove(RING_NAME);
+
+    spdlog::info("writer:      {:.1f} M records/s", total / writeSeconds / 1e6);
+    bool failed = false;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        spdlog::info("{} {:>2}: {:.1f} M records/s, {} received, {} lost, "
+                     "{} torn, {} out of order",
+            i == readerCount ? "slow  " : "reader", i,
+            result.received / result.seconds / 1e6, result.received,
+            result.lost, result.torn, result.reordered);
+        failed |= result.torn || result.reordered
+            || result.received + result.lost != total;
+    }
+    if (failed)
+        spdlog::error("A reader saw torn, reordered or missing records");
+    return failed ? 1 : 0;
+}
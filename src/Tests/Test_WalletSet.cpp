@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Checks WalletSet and measures its memory and lookup cost next to the
+// PubkeySet it replaces, at each of the given sizes. Lookups go through
+// a shuffled list of probes, so they miss the cache the way a live feed
+// does, and "miss" probes are wallets that are not in the set:
+//
+//   test_wallet_set [sizes...]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "Clients/Solana/gRPC/Core/WalletSet.hpp"
+
+using namespace solana;
+
+namespace {
+constexpr size_t PROBES = 1'000'000;
+
+std::vector<Pubkey> randomKeys(size_t count, std::mt19937_64& rng)
+{
+    std::vector<Pubkey> keys(count);
+    for (auto& key : keys) {
+        for (size_t i = 0; i < Pubkey::SIZE; i += 8) {
+            uint64_t word = rng();
+            std::memcpy(key.bytes.data() + i, &word, 8);
+        }
+    }
+    return keys;
+}
+
+std::vector<Pubkey> sample(
+    const std::vector<Pubkey>& keys, size_t count, std::mt19937_64& rng)
+{
+    std::vector<Pubkey> probes(count);
+    std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+    for (auto& probe : probes) {
+        probe = keys[pick(rng)];
+    }
+    return probes;
+}
+
+template <typename Set>
+double nsPerLookup(const Set& set, const std::vector<Pubkey>& probes,
+    size_t& found)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& probe : probes) {
+        found += set.contains(probe);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count()
+        / static_cast<double>(probes.size());
+}
+
+// Values plus the bucket array.
+size_t memoryBytes(const PubkeySet& set)
+{
+    return set.values().capacity() * sizeof(Pubkey)
+        + set.bucket_count() * sizeof(uint64_t);
+}
+
+bool roundTrip(const std::vector<Pubkey>& keys)
+{
+    std::string path = "test_wallet_set.bin";
+    WalletSet::writeFile(path, keys);
+    auto binary = WalletSet::readFile(path);
+
+    path = "test_wallet_set.txt";
+    {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        std::fputs("# tracked wallets\n\nnot-an-address\n", file);
+        for (const auto& key : keys) {
+            std::fprintf(file, "  %s  # note\n", key.toBase58().c_str());
+        }
+        std::fclose(file);
+    }
+    auto text = WalletSet::readFile(path);
+    std::remove("test_wallet_set.bin");
+    std::remove("test_wallet_set.txt");
+    return binary == keys && text == keys;
+}
+
+bool bench(size_t size, std::mt19937_64& rng)
+{
+    auto keys = randomKeys(size, rng);
+    auto hits = sample(keys, PROBES, rng);
+    auto misses = randomKeys(PROBES, rng);
+
+    auto start = std::chrono::steady_clock::now();
+    WalletSet wallets(keys);
+    double buildMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start)
+                         .count();
+    PubkeySet baseline(keys.begin(), keys.end());
+
+    size_t found = 0;
+    size_t passed = 0;
+    for (const auto& miss : misses) {
+        passed += wallets.mayContain(miss);
+    }
+    double hitNs = nsPerLookup(wallets, hits, found);
+    double missNs = nsPerLookup(wallets, misses, found);
+    double baselineHitNs = nsPerLookup(baseline, hits, found);
+    double baselineMissNs = nsPerLookup(baseline, misses, found);
+    // Every hit was found twice and no miss ever.
+    if (wallets.size() != size || found != 2 * hits.size()) {
+        spdlog::error("{} wallets: {} found for {} hits", size, found,
+            2 * hits.size());
+        return false;
+    }
+
+    spdlog::info("{} wallets, built in {:.0f} ms", size, buildMs);
+    spdlog::info("  WalletSet: {:.1f} B/wallet, hit {:.0f} ns, miss {:.0f} ns, "
+                 "{:.3f}% of misses past the filter",
+        static_cast<double>(wallets.memoryBytes()) / size, hitNs, missNs,
+        100.0 * passed / misses.size());
+    spdlog::info("  PubkeySet: {:.1f} B/wallet, hit {:.0f} ns, miss {:.0f} ns",
+        static_cast<double>(memoryBytes(baseline)) / size, baselineHitNs,
+        baselineMissNs);
+    return true;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::max<size_t>(1, std::stoull(argv[i])));
+    }
+    if (sizes.empty())
+        sizes = { 10'000, 1'000'000, 10'000'000 };
+
+    std::mt19937_64 rng(42);
+    auto keys = randomKeys(1000, rng);
+    keys.push_back(keys.front());
+    WalletSet duplicates(keys);
+    keys.pop_back();
+    if (duplicates.size() != keys.size() || !roundTrip(keys)
+        || WalletSet().contains(keys.front())) {
+        spdlog::error("WalletSet checks failed");
+        return 1;
+    }
+
+    for (size_t size : sizes) {
+        if (!bench(size, rng))
+            return 1;
+    }
+    return 0;
+}
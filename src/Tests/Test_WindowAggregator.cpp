@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Checks and times the rolling window counters. Scripted records must
+// fall in and out of the windows as their buckets age, distinct counts
+// must stay near the truth, cold keys must give way to new ones, and
+// random swaps are timed over many active mints:
+//
+//   test_window_aggregator [mints] [records]
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "Clients/Solana/gRPC/Core/WindowAggregator.hpp"
+
+using namespace solana;
+
+namespace {
+using Side = WindowAggregator::Side;
+using Window = WindowAggregator::Window;
+
+Pubkey makeKey(uint32_t seed)
+{
+    Pubkey key;
+    for (size_t i = 0; i < key.bytes.size(); ++i) {
+        key.bytes[i] = static_cast<uint8_t>((seed >> (8 * (i % 4))) + i * 7);
+    }
+    return key;
+}
+
+// Midway through a 5 minute bucket, 30 seconds into a minute and at the
+// start of a 10 second bucket.
+constexpr int64_t START = 1'749'999'750'000;
+
+bool expect(const WindowAggregator& windows, const Pubkey& mint,
+    Window window, int64_t nowMs, uint32_t buys, uint32_t sells,
+    double volume, const char* step)
+{
+    auto totals = windows.totals(mint, window, nowMs);
+    if (totals && totals->buys == buys && totals->sells == sells
+        && totals->swaps == buys + sells
+        && std::fabs(totals->volume - volume) < 1e-9)
+        return true;
+    spdlog::error("{}: window {} has {}", step, static_cast<int>(window),
+        windows.get(mint, nowMs).dump());
+    return false;
+}
+
+bool checkScript()
+{
+    const Pubkey mint = makeKey(1);
+    WindowAggregator windows;
+    bool ok = true;
+    windows.record(mint, Side::Buy, 2.0, makeKey(10), START);
+    windows.record(mint, Side::Buy, 1.0, makeKey(11), START + 1'000);
+    windows.record(mint, Side::Sell, 0.5, makeKey(10), START + 2'000);
+    for (auto window : { Window::OneMinute, Window::FiveMinutes,
+             Window::OneHour }) {
+        ok = expect(windows, mint, window, START + 5'000, 2, 1, 3.5,
+                 "just recorded")
+            && ok;
+    }
+    if (windows.get(mint, START)["1m"]["unique_buyers"] != 2) {
+        spdlog::error(
+            "two buyers counted as {}", windows.get(mint, START).dump());
+        ok = false;
+    }
+
+    // Out of the minute, still in the others.
+    ok = expect(windows, mint, Window::OneMinute, START + 70'000, 0, 0, 0.0,
+             "after 70 s")
+        && ok;
+    ok = expect(windows, mint, Window::FiveMinutes, START + 70'000, 2, 1,
+             3.5, "after 70 s")
+        && ok;
+    windows.record(mint, Side::Sell, 4.0, makeKey(12), START + 70'000);
+    ok = expect(windows, mint, Window::OneMinute, START + 70'000, 0, 1, 4.0,
+             "sell after 70 s")
+        && ok;
+    ok = expect(windows, mint, Window::OneHour, START + 70'000, 2, 2, 7.5,
+             "sell after 70 s")
+        && ok;
+
+    // An hour on the wheels have come round; a record from back then only
+    // reaches the hour it is still in.
+    const int64_t later = START + 3'600'000;
+    windows.record(mint, Side::Buy, 1.0, makeKey(13), later);
+    windows.record(mint, Side::Buy, 1.0, makeKey(14), later - 600'000);
+    ok = expect(windows, mint, Window::FiveMinutes, later, 1, 0, 1.0,
+             "an hour later")
+        && ok;
+    ok = expect(windows, mint, Window::OneHour, later, 2, 0, 2.0,
+             "an hour later")
+        && ok;
+    if (windows.getStats()["late"] != 1) {
+        spdlog::error("late records: {}", windows.getStats().dump());
+        ok = false;
+    }
+    if (!windows.get(makeKey(2), later).is_null()) {
+        spdlog::error("unknown mint has windows");
+        ok = false;
+    }
+    return ok;
+}
+
+bool checkDistinct()
+{
+    bool ok = true;
+    for (uint32_t distinct : { 5u, 40u, 1'000u, 50'000u }) {
+        WindowAggregator windows;
+        const Pubkey mint = makeKey(1);
+        // Each trader twice, so repeats must not count.
+        for (uint32_t i = 0; i < 2 * distinct; ++i) {
+            windows.record(mint, Side::Buy, 1.0,
+                makeKey(i % distinct * 2654435761u), START + i % 1'000);
+        }
+        double estimate
+            = windows.totals(mint, Window::OneMinute, START)->uniqueTraders;
+        // Four standard errors; linear counting does better while few
+        // registers are set.
+        double allowed = distinct >= 1'000 ? 0.52 * distinct
+                                           : std::max(0.25 * distinct, 1.0);
+        if (std::fabs(estimate - distinct) > allowed) {
+            spdlog::error("{} distinct buyers estimated as {:.1f}", distinct,
+                estimate);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool checkEviction()
+{
+    WindowAggregator windows("unique_buyers", 100, 1);
+    for (uint32_t i = 0; i < 100; ++i) {
+        windows.record(makeKey(i), Side::Buy, 1.0, makeKey(0), START);
+    }
+    // Touched again, so key 1 is the coldest.
+    windows.record(makeKey(0), Side::Buy, 1.0, makeKey(0), START);
+    windows.record(makeKey(100), Side::Buy, 1.0, makeKey(0), START);
+    json stats = windows.getStats();
+    if (windows.get(makeKey(0), START).is_null()
+        || !windows.get(makeKey(1), START).is_null()
+        || windows.get(makeKey(100), START).is_null() || stats["keys"] != 100
+        || stats["evicted"] != 1) {
+        spdlog::error("eviction: {}", stats.dump());
+        return false;
+    }
+    return true;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t mintCount = argc > 1 ? std::stoul(argv[1]) : 100'000;
+    size_t recordCount = argc > 2 ? std::stoull(argv[2]) : 4'000'000;
+
+    bool ok = checkScript();
+    ok = checkDistinct() && ok;
+    ok = checkEviction() && ok;
+
+    // Two hours of swaps over every mint, so every wheel comes round.
+    struct Record {
+        uint32_t mint;
+        uint32_t trader;
+        bool buy;
+        double volume;
+    };
+    std::mt19937_64 random(42);
+    std::vector<Pubkey> mints;
+    for (uint32_t i = 0; i < mintCount; ++i) {
+        mints.push_back(makeKey(i * 2654435761u + 7));
+    }
+    std::vector<Pubkey> traders;
+    for (uint32_t i = 0; i < 50'000; ++i) {
+        traders.push_back(makeKey(~i * 40503u));
+    }
+    std::vector<Record> records(recordCount);
+    for (auto& record : records) {
+        record.mint = static_cast<uint32_t>(random() % mintCount);
+        record.trader = static_cast<uint32_t>(random() % traders.size());
+        record.buy = random() % 2;
+        record.volume = static_cast<double>(random() % 10'000) / 100.0;
+    }
+    const int64_t spanMs = 2 * 3'600'000;
+
+    // Room for the shards filling unevenly.
+    WindowAggregator windows("unique_buyers", 2 * mintCount);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < recordCount; ++i) {
+        const Record& record = records[i];
+        windows.record(mints[record.mint],
+            record.buy ? Side::Buy : Side::Sell, record.volume,
+            traders[record.trader],
+            START + static_cast<int64_t>(i) * spanMs
+                / static_cast<int64_t>(recordCount));
+    }
+    double recordNs = std::chrono::duration<double, std::nano>(
+                          std::chrono::steady_clock::now() - start)
+                          .count()
+        / static_cast<double>(recordCount);
+
+    const int64_t end = START + spanMs;
+    start = std::chrono::steady_clock::now();
+    uint64_t swaps = 0;
+    for (const auto& mint : mints) {
+        if (auto totals = windows.totals(mint, Window::OneHour, end))
+            swaps += totals->swaps;
+    }
+    double readNs = std::chrono::duration<double, std::nano>(
+                        std::chrono::steady_clock::now() - start)
+                        .count()
+        / mintCount;
+
+    // The last hour's half of the records, give or take the bucket the
+    // window starts in.
+    const double expected = static_cast<double>(recordCount) / 2;
+    if (std::fabs(static_cast<double>(swaps) - expected) > expected / 10) {
+        spdlog::error("hour holds {} swaps, expected about {}", swaps,
+            expected);
+        ok = false;
+    }
+    json stats = windows.getStats();
+    if (stats["keys"] != mintCount || stats["evicted"] != 0) {
+        spdlog::error("benchmark keys: {}", stats.dump());
+        ok = false;
+    }
+
+    spdlog::info("{} records over {} mints: {:.1f} ns/record, {:.1f} ns to "
+                 "read an hour, ~{} MB",
+        recordCount, mintCount, recordNs, readNs,
+        stats["approx_bytes"].get<size_t>() >> 20);
+    return ok ? 0 : 1;
+}
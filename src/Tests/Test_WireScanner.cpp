@@ -0,0 +1,350 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+/*
+ * Copyright (C) 2025 to1dev <https://arc20.me/to1dev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Compares TransactionView::scan and resolve field by field against a full
+// geyser.pb.h parse, on transactions built with geyser.pb.h and, when one
+// is given, on those of a capture file written by FrameCapture. Then times
+// both on the same frames:
+//
+//   test_wire_scanner [capture.bin [passes]]
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/arena.h>
+
+#include <spdlog/spdlog.h>
+
+#include <geyser.grpc.pb.h>
+
+#include "Clients/Solana/gRPC/Core/FrameCapture.hpp"
+#include "Clients/Solana/gRPC/Core/TransactionView.hpp"
+#include "Tests/TestFrame.hpp"
+
+using namespace solana;
+using namespace solana::tests;
+
+namespace {
+const Pubkey TOKEN
+    = *Pubkey::fromBase58("TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA");
+const Pubkey VOTE
+    = *Pubkey::fromBase58("Vote111111111111111111111111111111111111111");
+const Pubkey BONK
+    = *Pubkey::fromBase58("DezXAZ8z7PnrnRJjz3wXBoRgixCa6xjnB7YaB1pPB263");
+
+std::string u64(uint64_t value)
+{
+    std::string out(8, '\0');
+    for (size_t i = 0; i < 8; ++i) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+    return out;
+}
+
+// Sets what Frame leaves out on a built transaction.
+template <typename Edit>
+std::string edited(const std::string& frame, Edit&& edit)
+{
+    geyser::SubscribeUpdate update;
+    update.ParseFromString(frame);
+    edit(*update.mutable_transaction()->mutable_transaction());
+    return update.SerializeAsString();
+}
+
+// Transactions covering each field the scanner reads, including the ones
+// proto3 leaves out when they are zero.
+std::vector<std::string> builtFrames()
+{
+    std::vector<std::string> frames;
+
+    // A swap routed through an aggregator, with keys from a lookup table.
+    {
+        Frame frame;
+        uint8_t user = frame.account(makeKey(1), 5'000'000, 3'000'000);
+        uint8_t router = frame.account(makeKey(2));
+        uint8_t token = frame.account(TOKEN);
+        uint8_t source = frame.account(makeKey(3), 2'039'280, 2'039'280);
+        uint8_t pool = frame.loaded(makeKey(4), 1'000'000, 3'000'000);
+        uint8_t vault = frame.loaded(makeKey(5), 2'039'280, 2'039'280);
+        frame.call(router, { user, source, pool }, u64(1000));
+        frame.inner(2, pool, { source, vault, user }, u64(1000) + u64(7));
+        frame.inner(3, token, { source, vault, user }, u64(1000));
+        frame.inner(2, token, { vault, source, pool }, u64(250));
+        frame.call(token, { source }, {});
+        frame.token(source, makeKey(1), BONK, 5, 1000, std::nullopt);
+        frame.token(vault, makeKey(4), BONK, 5, std::nullopt, 1000);
+        frame.computeUnits(123'456);
+        frames.push_back(edited(frame.serialize(1), [](auto& info) {
+            info.set_index(417);
+            auto* meta = info.mutable_meta();
+            meta->add_loaded_readonly_addresses(
+                std::string(makeKey(6).view()));
+            meta->add_pre_balances(1);
+            meta->add_post_balances(1);
+            meta->mutable_inner_instructions(0)
+                ->mutable_instructions(2)
+                ->clear_stack_height();
+            meta->add_log_messages("Program log: Instruction: Swap");
+            meta->add_log_messages(std::string(300, 'x'));
+        }));
+    }
+
+    // A failed vote.
+    {
+        Frame frame;
+        uint8_t voter = frame.account(makeKey(7), 10'000, 5'000);
+        uint8_t vote = frame.account(VOTE, 1, 1);
+        frame.call(vote, { voter }, std::string(40, '\1'));
+        frames.push_back(edited(frame.serialize(2), [](auto& info) {
+            info.set_is_vote(true);
+            info.mutable_meta()->mutable_err()->set_err(std::string(4, '\0'));
+        }));
+    }
+
+    // Everything zero: no index, keys, instructions or meta fields.
+    frames.push_back(edited(Frame().serialize(3), [](auto& info) {
+        info.mutable_meta()->clear_fee();
+    }));
+
+    // Enough keys, instructions and balances for multi-byte lengths.
+    {
+        Frame frame;
+        for (uint8_t i = 0; i < 120; ++i) {
+            frame.account(makeKey(i), i * 1'000'000'000ull, i);
+        }
+        for (uint8_t i = 0; i < 40; ++i) {
+            frame.call(i, { i, 1, 2, 3 }, std::string(i * 10, 'd'));
+            frame.token(i, makeKey(i), BONK, i % 10, 1ull << i, i);
+        }
+        frames.push_back(frame.serialize(4));
+    }
+    return frames;
+}
+
+bool sameInstruction(const TransactionView::Instruction& ours,
+    uint32_t programIdIndex, const std::string& accounts,
+    const std::string& data, uint32_t stackHeight,
+    const TransactionView& view)
+{
+    return ours.programIdIndex == programIdIndex && ours.accounts == accounts
+        && ours.data == data && ours.stackHeight == stackHeight
+        && programIdIndex < view.keys.size()
+        && ours.program == view.keys[programIdIndex];
+}
+
+bool sameBalance(const TransactionView::TokenBalance& ours,
+    const storage::ConfirmedBlock::TokenBalance& theirs)
+{
+    const auto& amount = theirs.ui_token_amount();
+    return ours.accountIndex == theirs.account_index()
+        && ours.mint == theirs.mint() && ours.owner == theirs.owner()
+        && ours.amount == amount.amount()
+        && ours.uiAmount == amount.ui_amount()
+        && ours.decimals == amount.decimals();
+}
+
+template <typename Ours, typename Theirs, typename Same>
+bool sameList(const std::vector<Ours>& ours, const Theirs& theirs, Same&& same)
+{
+    if (ours.size() != static_cast<size_t>(theirs.size()))
+        return false;
+    for (size_t i = 0; i < ours.size(); ++i) {
+        if (!same(ours[i], theirs[static_cast<int>(i)]))
+            return false;
+    }
+    return true;
+}
+
+// The first field the scan got wrong, or nullptr.
+const char* mismatch(
+    const geyser::SubscribeUpdateTransaction& tx, const TransactionView& view)
+{
+    const auto& info = tx.transaction();
+    const auto& message = info.transaction().message();
+    const auto& meta = info.meta();
+    auto equal = [](const auto& ours, const auto& theirs) {
+        return ours == theirs;
+    };
+
+    if (view.slot != tx.slot() || view.index != info.index()
+        || view.signature != info.signature() || view.isVote != info.is_vote())
+        return "header";
+    if (view.failed != meta.has_err() || view.fee != meta.fee()
+        || view.computeUnits != meta.compute_units_consumed())
+        return "status";
+
+    std::vector<std::string> keys(
+        message.account_keys().begin(), message.account_keys().end());
+    keys.insert(keys.end(), meta.loaded_writable_addresses().begin(),
+        meta.loaded_writable_addresses().end());
+    keys.insert(keys.end(), meta.loaded_readonly_addresses().begin(),
+        meta.loaded_readonly_addresses().end());
+    if (view.staticKeyCount != static_cast<size_t>(message.account_keys_size())
+        || !sameList(view.accountKeys, keys, equal)
+        || !sameList(view.keys, keys,
+            [](const Pubkey& ours, const std::string& theirs) {
+                return ours.view() == theirs;
+            }))
+        return "account keys";
+
+    if (!sameList(view.instructions, message.instructions(),
+            [&](const auto& ours, const auto& theirs) {
+                return sameInstruction(ours, theirs.program_id_index(),
+                    theirs.accounts(), theirs.data(), 1, view);
+            }))
+        return "instructions";
+    size_t inner = 0;
+    for (const auto& group : meta.inner_instructions()) {
+        for (const auto& theirs : group.instructions()) {
+            if (inner >= view.innerInstructions.size())
+                return "inner instructions";
+            const auto& ours = view.innerInstructions[inner++];
+            if (ours.outerIndex != group.index()
+                || !sameInstruction(ours, theirs.program_id_index(),
+                    theirs.accounts(), theirs.data(), theirs.stack_height(),
+                    view))
+                return "inner instructions";
+        }
+    }
+    if (inner != view.innerInstructions.size())
+        return "inner instructions";
+
+    if (!sameList(view.preLamports, meta.pre_balances(), equal)
+        || !sameList(view.postLamports, meta.post_balances(), equal))
+        return "lamports";
+    if (!sameList(view.preTokenBalances, meta.pre_token_balances(),
+            sameBalance)
+        || !sameList(view.postTokenBalances, meta.post_token_balances(),
+            sameBalance))
+        return "token balances";
+    if (!sameList(view.logMessages, meta.log_messages(), equal))
+        return "log messages";
+    return nullptr;
+}
+
+template <typename Fn> double nsPerFrame(size_t frames, int passes, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count()
+        / static_cast<double>(frames * passes);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int passes = argc > 2 ? std::max(1, std::stoi(argv[2])) : 10;
+
+    const auto built = builtFrames();
+    std::vector<std::string_view> frames(built.begin(), built.end());
+    TransactionView view;
+    std::optional<FrameReader> reader;
+    if (argc > 1) {
+        reader.emplace(argv[1]);
+        FrameReader::Frame frame;
+        while (reader->next(frame)) {
+            if (view.scanHeader(frame.bytes))
+                frames.push_back(frame.bytes);
+        }
+    }
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        auto bytes = frames[i];
+        geyser::SubscribeUpdate update;
+        const char* field = "frame";
+        if (update.ParseFromArray(bytes.data(), static_cast<int>(bytes.size()))
+            && view.scan(bytes) && view.resolve())
+            field = mismatch(update.transaction(), view);
+        if (field) {
+            spdlog::error("frame {}: {} scanned differently from the full "
+                          "parse",
+                i, field);
+            ++mismatches;
+        }
+    }
+
+    // Other updates are not transactions.
+    geyser::SubscribeUpdate account;
+    account.mutable_account()->set_slot(300'000'000);
+    auto accountFrame = account.SerializeAsString();
+    if (view.scan(accountFrame) || view.scanHeader(accountFrame)) {
+        spdlog::error("an account update scanned as a transaction");
+        ++mismatches;
+    }
+    if (mismatches) {
+        spdlog::error("{} of {} frames scanned differently from the full parse",
+            mismatches, frames.size());
+        return 1;
+    }
+
+    uint64_t sink = 0;
+    size_t bytes = 0;
+    for (auto frame : frames) {
+        bytes += frame.size();
+    }
+    double parseNs = nsPerFrame(frames.size(), passes, [&] {
+        google::protobuf::ArenaOptions options;
+        options.start_block_size = 64 * 1024;
+        google::protobuf::Arena arena(options);
+        for (auto bytes : frames) {
+            auto* update
+                = google::protobuf::Arena::Create<geyser::SubscribeUpdate>(
+                    &arena);
+            update->ParseFromArray(
+                bytes.data(), static_cast<int>(bytes.size()));
+            sink += update->transaction().slot();
+        }
+    });
+    double scanNs = nsPerFrame(frames.size(), passes, [&] {
+        for (auto bytes : frames) {
+            view.scan(bytes);
+            sink += view.slot;
+        }
+    });
+    double resolveNs = nsPerFrame(frames.size(), passes, [&] {
+        for (auto bytes : frames) {
+            view.scan(bytes);
+            view.resolve();
+            sink += view.balanceDeltas.size();
+        }
+    });
+    double headerNs = nsPerFrame(frames.size(), passes, [&] {
+        for (auto bytes : frames) {
+            view.scanHeader(bytes);
+            sink += view.slot;
+        }
+    });
+
+    spdlog::info("{} transactions, {} passes, {} bytes average", frames.size(),
+        passes, bytes / frames.size());
+    spdlog::info("full parse:  {:.0f} ns/tx", parseNs);
+    spdlog::info("scan:        {:.0f} ns/tx ({:.1f}x)", scanNs,
+        parseNs / scanNs);
+    spdlog::info("scan+resolve: {:.0f} ns/tx ({:.1f}x)", resolveNs,
+        parseNs / resolveNs);
+    spdlog::info("scan header: {:.0f} ns/tx ({:.1f}x)", headerNs,
+        parseNs / headerNs);
+    spdlog::debug("checksum {}", sink);
+    return 0;
+}
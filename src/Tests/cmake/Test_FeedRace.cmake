@@ -0,0 +1,35 @@
+project(test_feed_race LANGUAGES CXX)
+
+set(CMAKE_CXX_STANDARD 20)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+
+set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -static -static-libgcc -static-libstdc++")
+set(CMAKE_FIND_LIBRARY_SUFFIXES ".a")
+set(BUILD_SHARED_LIBS OFF)
+
+set(TEST_SOURCES
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/FeedRace.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/SignatureSet.cpp
+    ${CMAKE_SOURCE_DIR}/src/tests/Test_FeedRace.cpp
+)
+
+add_executable(${PROJECT_NAME} ${TEST_SOURCES})
+
+target_include_directories(${PROJECT_NAME} PRIVATE
+    ${CMAKE_SOURCE_DIR}/src
+    ${CMAKE_SOURCE_DIR}/src/3rd/inc
+)
+
+target_link_directories(${PROJECT_NAME} PRIVATE
+    ${CMAKE_SOURCE_DIR}/src/3rd/lib
+)
+
+target_compile_options(${PROJECT_NAME} PRIVATE
+    -O2
+    -Wno-unused-parameter
+    -Wno-attributes
+)
+
+target_link_libraries(${PROJECT_NAME} PRIVATE
+    spdlog
+)
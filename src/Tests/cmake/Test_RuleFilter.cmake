@@ -0,0 +1,56 @@
+project(test_rule_filter LANGUAGES CXX)
+
+set(CMAKE_CXX_STANDARD 20)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+
+set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -static -static-libgcc -static-libstdc++")
+set(CMAKE_FIND_LIBRARY_SUFFIXES ".a")
+set(BUILD_SHARED_LIBS OFF)
+
+find_package(gRPC CONFIG REQUIRED)
+find_package(Protobuf REQUIRED)
+
+set(TEST_SOURCES
+    ${CMAKE_SOURCE_DIR}/pkg/geyser/src/geyser.grpc.pb.cc
+    ${CMAKE_SOURCE_DIR}/pkg/geyser/src/geyser.pb.cc
+    ${CMAKE_SOURCE_DIR}/pkg/geyser/src/solana-storage.grpc.pb.cc
+    ${CMAKE_SOURCE_DIR}/pkg/geyser/src/solana-storage.pb.cc
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RcuPtr.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RuleFilter.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RuleProgram.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/TransactionView.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/WalletSet.cpp
+    ${CMAKE_SOURCE_DIR}/src/tests/Test_RuleFilter.cpp
+)
+
+add_executable(${PROJECT_NAME} ${TEST_SOURCES})
+
+target_include_directories(${PROJECT_NAME} PRIVATE
+    ${CMAKE_SOURCE_DIR}/pkg/geyser/src
+    ${CMAKE_SOURCE_DIR}/src
+    ${CMAKE_SOURCE_DIR}/src/3rd/inc
+)
+
+target_link_directories(${PROJECT_NAME} PRIVATE
+    ${CMAKE_SOURCE_DIR}/src/3rd/lib
+    ${CMAKE_SOURCE_DIR}/src/3rd/lib/grpc
+)
+
+target_compile_options(${PROJECT_NAME} PRIVATE
+    -O2
+    -Wno-unused-parameter
+    -Wno-attributes
+)
+
+target_link_libraries(${PROJECT_NAME} PRIVATE
+    gRPC::grpc++
+    protobuf::libprotobuf
+    spdlog
+)
+
+if (WIN32)
+    target_link_libraries(${PROJECT_NAME} PRIVATE
+        Rpcrt4
+        Mswsock
+    )
+endif()
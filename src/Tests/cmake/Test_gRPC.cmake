@@ -33,19 +33,63 @@ set(GRPC_PKG_FILES
 )
 
 set(GRPC_SOURCE_FILES
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/AccountCache.cpp
     ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/ConfigManager.cpp
     ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/DataSourceManager.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/DataSourceWorker.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/DexDecoders.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/DexDecoders.hpp
     ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/DexFilter.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/DexPrograms.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/EndpointProber.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/EndpointProber.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/EventBus.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/FeedRace.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/FilterExecutor.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/FilterExecutor.hpp
     ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/FilterManager.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/FrameCapture.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/GeyserClientWorker.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/HyperLogLog.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/IngestPipeline.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/IngestTracer.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/LatencyHistogram.hpp
     #${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/MetricsManager.cpp
     ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/NotificationManager.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/PnlEngine.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/PnlEngine.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/Pubkey.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RankHeap.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RcuPtr.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RcuPtr.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RecentRing.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/ReplayWorker.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RuleFilter.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RuleFilter.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RuleProgram.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/RuleProgram.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/SignatureSet.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/SlotReorderBuffer.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/SpscRing.hpp
     ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/StorageManager.cpp
     ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/SwapFilter.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/TransactionBatch.cpp
 
     ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/TransactionFilter.hpp
-
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/TransactionView.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/TxRingPublisher.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/WalletSet.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/WalletSet.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/WindowAggregator.cpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/WindowAggregator.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Core/WireReader.hpp
+
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/HTTP/HttpClient.cpp
     ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/HTTP/HttpServer.cpp
 
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Shm/TxRing.hpp
+    ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Shm/TxRingWriter.cpp
+
     ${CMAKE_SOURCE_DIR}/src/Clients/Solana/gRPC/Utils/Logger.hpp
 )
 
@@ -80,6 +124,8 @@ target_compile_options(${PROJECT_NAME} PRIVATE
 
 set(THIRD_PARTY_LIBS
     sodium
+    ssl
+    crypto
     rocksdb
     bz2
     snappy